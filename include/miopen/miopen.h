@@ -33,6 +33,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <miopen/config.h>
 #include <miopen/export.h>
 
@@ -77,6 +78,8 @@ extern "C" {
 typedef cl_command_queue miopenAcceleratorQueue_t;
 #elif MIOPEN_BACKEND_HIP
 typedef hipStream_t miopenAcceleratorQueue_t;
+#elif MIOPEN_BACKEND_MOCK
+typedef void* miopenAcceleratorQueue_t;
 #endif
 
 /*! @ingroup handle
@@ -227,6 +230,58 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
 */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Enable a workspace arena owned by the handle
+ *
+ * When enabled, immediate mode convolutions called with a null workspace are served from a
+ * single buffer owned by the handle. The buffer grows to the largest workspace required and
+ * is then reused. Disabling the arena frees the buffer.
+ * @param handle     MIOpen handle (input)
+ * @param enable     Boolean to toggle the arena (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableWorkspaceArena(miopenHandle_t handle, bool enable);
+
+/*! @brief Grow the workspace arena upfront
+ *
+ * Allocates the arena buffer with at least the requested size so that later calls do not
+ * have to grow it. The arena has to be enabled with miopenEnableWorkspaceArena.
+ * @param handle       MIOpen handle (input)
+ * @param sizeInBytes  Size of the arena in bytes (input)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenReserveWorkspaceArena(miopenHandle_t handle,
+                                                         size_t sizeInBytes);
+
+/*! @brief Get the largest workspace requested from the arena
+ *
+ * @param handle       MIOpen handle (input)
+ * @param sizeInBytes  Largest workspace size in bytes served by the arena so far (output)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetWorkspaceArenaPeak(miopenHandle_t handle,
+                                                         size_t* sizeInBytes);
+
+/*! @brief Get a snapshot of the process-wide metrics
+ *
+ * The snapshot is a JSON document with counters of find-db, perf-db, kernel cache and binary
+ * cache hits and misses, histograms of database lookup, lock wait and compilation times in
+ * seconds, and how many times each solver was selected. The metrics cover all handles.
+ * Call with a null snapshot to get the required size. If the buffer is too small
+ * miopenStatusBadParm is returned and the required size is set, as the metrics may have
+ * grown since the size was queried.
+ * @param snapshot     Buffer for the null terminated JSON document, or NULL (output)
+ * @param sizeInBytes  Size of the buffer in bytes, set to the size of the snapshot including
+ *                     the terminating null character (input/output)
+ * @return             miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetMetricsSnapshot(char* snapshot, size_t* sizeInBytes);
+
+/*! @brief Reset the process-wide metrics to zero
+ *
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenResetMetrics(void);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -149,7 +149,7 @@ void bnFwdTrainSelectMulti(Handle& handle,
                            std::string& program_name,
                            std::string& algo_name,
                            std::string& kernel_name,
-                           std::string& network_config,
+                           const NetworkConfig& network_config,
                            std::string& parms,
                            std::vector<size_t>& vld,
                            std::vector<size_t>& vgd,
@@ -265,7 +265,7 @@ void bnFwdTrainSelectSingle(Handle& handle,
                             std::string& program_name,
                             std::string& algo_name,
                             std::string& kernel_name,
-                            std::string& network_config,
+                            const NetworkConfig& network_config,
                             std::string& parms,
                             std::vector<size_t>& vld,
                             std::vector<size_t>& vgd,
@@ -346,7 +346,7 @@ void bnBwdTrainSelectSingle(Handle& handle,
                             std::string& program_name,
                             std::string& algo_name,
                             std::string& kernel_name,
-                            std::string& network_config,
+                            const NetworkConfig& network_config,
                             std::string& parms,
                             std::vector<size_t>& vld,
                             std::vector<size_t>& vgd,
@@ -382,7 +382,7 @@ void bnBwdTrainSelectMulti(Handle& handle,
                            std::string& program_name,
                            std::string& algo_name,
                            std::string& kernel_name,
-                           std::string& network_config,
+                           const NetworkConfig& network_config,
                            std::string& parms,
                            std::vector<size_t>& vld,
                            std::vector<size_t>& vgd,
@@ -25,20 +25,72 @@
  *******************************************************************************/
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/env.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/expanduser.hpp>
+#include <miopen/kernel_build_params.hpp>
 #include <miopen/miopen.h>
 #include <miopen/version.h>
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <ctime>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CACHE_PACK)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CACHE_SIZE_LIMIT)
+
+namespace {
+
+struct CacheCounters
+{
+    std::atomic<std::size_t> hits{0};
+    std::atomic<std::size_t> misses{0};
+    std::atomic<std::size_t> bytes_written{0};
+    std::atomic<std::size_t> evictions{0};
+    std::atomic<std::size_t> bytes_evicted{0};
+    std::atomic<std::size_t> cache_bytes{0};
+    std::atomic<std::size_t> compile_us{0};
+};
+
+CacheCounters& Counters()
+{
+    static CacheCounters counters;
+    return counters;
+}
+
+/// Counts a lookup both in BinaryCacheStats and in the metrics registry.
+void CountLookup(bool is_hit)
+{
+    if(is_hit)
+    {
+        ++Counters().hits;
+        metrics::Add(metrics::Counter::BinaryCacheHits);
+    }
+    else
+    {
+        ++Counters().misses;
+        metrics::Add(metrics::Counter::BinaryCacheMisses);
+    }
+}
+
+} // namespace
 
 boost::filesystem::path ComputeCachePath()
 {
@@ -73,48 +125,404 @@ bool IsCacheDisabled()
 #endif
 }
 
+bool IsCachePackEnabled()
+{
+    return !IsCacheDisabled() && miopen::IsEnabled(MIOPEN_CACHE_PACK{});
+}
+
+static BinaryCachePack& GetCachePack()
+{
+    static BinaryCachePack pack{GetCachePath()};
+    return pack;
+}
+
+static std::string GetBinaryKey(const std::string& device,
+                                const std::string& name,
+                                const std::string& args,
+                                bool is_kernel_str)
+{
+    return device + ":" + CanonicalBuildOptions(args) + ":" +
+           (is_kernel_str ? miopen::md5(name) : name);
+}
+
+static std::mutex& InFlightMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::unordered_map<std::string, std::shared_future<void>>& InFlightCompilations()
+{
+    static std::unordered_map<std::string, std::shared_future<void>> compilations;
+    return compilations;
+}
+
+InFlightCompilation::InFlightCompilation(const std::string& device,
+                                         const std::string& name,
+                                         const std::string& args,
+                                         bool is_kernel_str)
+{
+    // Nobody would find the binary in the cache, so let everyone compile.
+    if(miopen::IsCacheDisabled())
+        return;
+
+    key = GetBinaryKey(device, name, args, is_kernel_str);
+    std::shared_future<void> in_flight;
+    {
+        std::lock_guard<std::mutex> lock(InFlightMutex());
+        auto& compilations = InFlightCompilations();
+        const auto found   = compilations.find(key);
+        if(found == compilations.end())
+        {
+            promise = std::make_unique<std::promise<void>>();
+            compilations.emplace(key, promise->get_future().share());
+            return;
+        }
+        in_flight = found->second;
+    }
+    MIOPEN_LOG_I2("Waiting for another thread to compile " << name);
+    in_flight.get();
+}
+
+InFlightCompilation::~InFlightCompilation()
+{
+    if(promise == nullptr)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(InFlightMutex());
+        InFlightCompilations().erase(key);
+    }
+    if(failure)
+        promise->set_exception(failure);
+    else
+        promise->set_value();
+}
+
+void InFlightCompilation::SetFailed(std::exception_ptr error) { failure = std::move(error); }
+
+/// Size cap of the directory layout of the cache, in bytes. 0 means no limit.
+static std::size_t GetCacheSizeLimit()
+{
+    return miopen::Value(MIOPEN_CACHE_SIZE_LIMIT{}) * 1024 * 1024;
+}
+
+/// Serializes eviction against the other accesses which either rely on presence of
+/// the files and directories of the cache, or update access times.
+static LockFile& GetCacheLock()
+{
+    return LockFile::Get(LockFilePath(GetCachePath() / "binary_cache").c_str());
+}
+
+static std::shared_lock<LockFile> LockCacheShared()
+{
+    if(GetCacheSizeLimit() == 0)
+        return {};
+    return std::shared_lock<LockFile>(GetCacheLock());
+}
+
+/// Runs eviction asynchronously, not more often than 1/16 of the cap is written.
+class CacheEvictor
+{
+    public:
+    // Constructing statics used by Run() here guarantees they outlive the evictor.
+    CacheEvictor() : lock_file(GetCacheLock()) { (void)Counters(); }
+    CacheEvictor(const CacheEvictor&) = delete;
+    CacheEvictor& operator=(const CacheEvictor&) = delete;
+    ~CacheEvictor()
+    {
+        if(task.valid())
+            task.wait();
+    }
+
+    void OnSaved(std::size_t bytes, std::size_t limit)
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        written += bytes;
+        if(is_checked && written < limit / 16)
+            return;
+        if(task.valid() && task.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+        is_checked = true;
+        written    = 0;
+        task       = std::async(std::launch::async, [this, limit]() { Run(limit); });
+    }
+
+    private:
+    void Run(std::size_t limit)
+    {
+        try
+        {
+            // Give way to short accesses, but do not wait for another eviction.
+            std::unique_lock<LockFile> lock(lock_file, std::chrono::seconds(1));
+            if(!lock.owns_lock())
+                return;
+            const auto n = EvictFromCache(GetCachePath(), limit);
+            if(n != 0)
+                MIOPEN_LOG_I2("Evicted " << n << " binaries from " << GetCachePath());
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Cache eviction failed: " << ex.what());
+        }
+    }
+
+    LockFile& lock_file;
+    std::mutex mutex;
+    std::future<void> task;
+    std::size_t written = 0;
+    bool is_checked     = false;
+};
+
+static CacheEvictor& GetCacheEvictor()
+{
+    static CacheEvictor evictor;
+    return evictor;
+}
+
+std::size_t EvictFromCache(const boost::filesystem::path& directory,
+                           std::size_t limit,
+                           std::time_t min_age)
+{
+    struct Entry
+    {
+        boost::filesystem::path path;
+        std::time_t time;
+        std::uintmax_t size;
+    };
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    boost::system::error_code ec;
+
+    for(boost::filesystem::recursive_directory_iterator it(directory, ec), end; !ec && it != end;
+        it.increment(ec))
+    {
+        if(!boost::filesystem::is_regular_file(it->status()) || it->path().extension() != ".o")
+            continue;
+        const auto size = boost::filesystem::file_size(it->path(), ec);
+        if(ec)
+            continue;
+        const auto time = boost::filesystem::last_write_time(it->path(), ec);
+        if(ec)
+            continue;
+        entries.push_back({it->path(), time, size});
+        total += size;
+    }
+    Counters().cache_bytes = total;
+    if(total <= limit)
+        return 0;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& left, const Entry& right) {
+        return left.time < right.time;
+    });
+
+    // Free a bit more than required to not run eviction after each save.
+    const auto target   = limit - limit / 10;
+    const auto deadline = std::time(nullptr) - min_age;
+    std::size_t n       = 0;
+    for(const auto& entry : entries)
+    {
+        if(total <= target || entry.time > deadline)
+            break;
+        if(!boost::filesystem::remove(entry.path, ec) || ec)
+            continue;
+        total -= entry.size;
+        ++n;
+        ++Counters().evictions;
+        Counters().bytes_evicted += entry.size;
+        const auto parent = entry.path.parent_path();
+        if(parent != directory && boost::filesystem::is_empty(parent, ec) && !ec)
+            boost::filesystem::remove(parent, ec);
+    }
+    Counters().cache_bytes = total;
+    return n;
+}
+
+static boost::filesystem::path GetCompileTimeFile()
+{
+    return GetCachePath() / "compile_time.txt";
+}
+
+/// Accumulates the time spent on compilation of the cached binaries. The totals of
+/// the process are merged into the file shared by all processes only once, at exit.
+/// The file has "<number of binaries> <seconds>" format.
+class CompileTimeRecorder
+{
+    public:
+    // Constructing statics used by Flush() here guarantees they outlive the recorder.
+    CompileTimeRecorder() { (void)GetCacheLock(); }
+    CompileTimeRecorder(const CompileTimeRecorder&) = delete;
+    CompileTimeRecorder& operator=(const CompileTimeRecorder&) = delete;
+    ~CompileTimeRecorder() { Flush(); }
+
+    void Add(double seconds)
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        ++count;
+        total += seconds;
+    }
+
+    /// Returns the totals of all processes, including the ones not yet persisted by this one.
+    std::pair<std::size_t, double> Get() const
+    {
+        std::size_t file_count = 0;
+        double file_total      = 0.0;
+        (void)(std::ifstream{GetCompileTimeFile().string()} >> file_count >> file_total);
+        std::lock_guard<std::mutex> guard(mutex);
+        return {file_count + count, file_total + total};
+    }
+
+    private:
+    void Flush()
+    {
+        if(count == 0)
+            return;
+        try
+        {
+            const std::unique_lock<LockFile> lock(GetCacheLock());
+            std::size_t file_count = 0;
+            double file_total      = 0.0;
+            (void)(std::ifstream{GetCompileTimeFile().string()} >> file_count >> file_total);
+            const auto tmp = GetCachePath() / boost::filesystem::unique_path();
+            (void)(std::ofstream{tmp.string()} << (file_count + count) << ' '
+                                               << (file_total + total) << '\n');
+            boost::filesystem::rename(tmp, GetCompileTimeFile());
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Failed recording compile time: " << ex.what());
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::size_t count = 0;
+    double total      = 0.0;
+};
+
+static CompileTimeRecorder& GetCompileTimeRecorder()
+{
+    static CompileTimeRecorder recorder;
+    return recorder;
+}
+
+static void RecordCompileTime(double seconds)
+{
+    if(seconds <= 0.0)
+        return;
+    Counters().compile_us += static_cast<std::size_t>(seconds * 1e6);
+    GetCompileTimeRecorder().Add(seconds);
+}
+
+BinaryCacheStats GetBinaryCacheStats()
+{
+    BinaryCacheStats stats{};
+    stats.hits            = Counters().hits;
+    stats.misses          = Counters().misses;
+    stats.bytes_written   = Counters().bytes_written;
+    stats.evictions       = Counters().evictions;
+    stats.bytes_evicted   = Counters().bytes_evicted;
+    stats.cache_bytes     = Counters().cache_bytes;
+    stats.compile_seconds = Counters().compile_us * 1e-6;
+
+    if(!IsCacheDisabled() && stats.hits != 0)
+    {
+        const auto compile_time = GetCompileTimeRecorder().Get();
+        if(compile_time.first != 0)
+            stats.compile_seconds_saved = stats.hits * compile_time.second / compile_time.first;
+    }
+    return stats;
+}
+
 boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& name,
                                      const std::string& args,
                                      bool is_kernel_str)
 {
     std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
-    return GetCachePath() / miopen::md5(device + ":" + args) / filename;
+    return GetCachePath() / miopen::md5(device + ":" + CanonicalBuildOptions(args)) / filename;
 }
 
 std::string LoadBinary(const std::string& device,
                        const std::string& name,
                        const std::string& args,
-                       bool is_kernel_str)
+                       bool is_kernel_str,
+                       bool is_recheck)
 {
-    if(miopen::IsCacheDisabled())
+    if(miopen::IsCacheDisabled() || miopen::IsCachePackEnabled())
         return {};
-    auto f = GetCacheFile(device, name, args, is_kernel_str);
+    auto f          = GetCacheFile(device, name, args, is_kernel_str);
+    const auto lock = LockCacheShared();
     if(boost::filesystem::exists(f))
     {
+        if(lock.owns_lock())
+        {
+            // Track access time for LRU eviction. atime is not reliable enough.
+            boost::system::error_code ec;
+            boost::filesystem::last_write_time(f, std::time(nullptr), ec);
+        }
+        if(!is_recheck)
+            CountLookup(true);
         return f.string();
     }
     else
     {
+        if(!is_recheck)
+            CountLookup(false);
         return {};
     }
 }
+PackedBinary LoadPackedBinary(const std::string& device,
+                              const std::string& name,
+                              const std::string& args,
+                              bool is_kernel_str,
+                              bool is_recheck)
+{
+    if(!miopen::IsCachePackEnabled())
+        return {};
+    const auto binary = GetCachePack().Find(GetBinaryKey(device, name, args, is_kernel_str));
+    if(!is_recheck)
+        CountLookup(!binary.empty());
+    return binary;
+}
+
 void SaveBinary(const boost::filesystem::path& binary_path,
                 const std::string& device,
                 const std::string& name,
                 const std::string& args,
-                bool is_kernel_str)
+                bool is_kernel_str,
+                double compile_seconds)
 {
+    if(compile_seconds > 0.0)
+        metrics::Observe(metrics::Histogram::CompileSeconds, compile_seconds);
     if(miopen::IsCacheDisabled())
     {
         boost::filesystem::remove(binary_path);
+        return;
+    }
+
+    std::size_t size = 0;
+    if(miopen::IsCachePackEnabled())
+    {
+        const auto binary = miopen::LoadFile(binary_path.string());
+        boost::filesystem::remove(binary_path);
+        GetCachePack().Store(
+            GetBinaryKey(device, name, args, is_kernel_str), binary.data(), binary.size());
+        size = binary.size();
     }
     else
     {
         auto p = GetCacheFile(device, name, args, is_kernel_str);
-        boost::filesystem::create_directories(p.parent_path());
-        boost::filesystem::rename(binary_path, p);
+        size   = boost::filesystem::file_size(binary_path);
+        {
+            const auto lock = LockCacheShared(); // Eviction removes empty directories.
+            boost::filesystem::create_directories(p.parent_path());
+            boost::filesystem::rename(binary_path, p);
+        }
+        const auto limit = GetCacheSizeLimit();
+        if(limit != 0)
+            GetCacheEvictor().OnSaved(size, limit);
     }
+    Counters().bytes_written += size;
+    RecordCompileTime(compile_seconds);
 }
 
 } // namespace miopen
@@ -0,0 +1,456 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/binary_cache_pack.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace miopen {
+
+namespace {
+
+namespace ipc = boost::interprocess;
+
+constexpr uint64_t index_magic         = 0x31584449504f494dULL; // "MIOPIDX1"
+constexpr uint32_t record_magic        = 0x4b504f4dUL;          // "MOPK"
+constexpr uint64_t initial_capacity    = 1024;                  // Power of 2.
+constexpr std::size_t record_alignment = 64;
+
+struct IndexHeader
+{
+    uint64_t magic;
+    uint64_t capacity;  // Number of slots.
+    uint64_t count;     // Number of occupied slots.
+    uint64_t pack_size; // Committed size of the pack file.
+    uint64_t obsolete;  // Non-zero when the index file is replaced by a new one.
+    uint64_t reserved[3];
+};
+
+struct IndexSlot
+{
+    uint64_t hash; // 0 denotes an empty slot.
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct RecordHeader
+{
+    uint32_t magic;
+    uint32_t key_size;
+    uint64_t data_offset; // From the beginning of the record.
+    uint64_t data_size;
+    uint64_t checksum; // Of the data.
+};
+
+uint64_t Fnv1a(const char* data, std::size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t KeyHash(const std::string& key)
+{
+    const auto hash = Fnv1a(key.data(), key.size());
+    return hash != 0 ? hash : 1;
+}
+
+std::size_t AlignUp(std::size_t value)
+{
+    return (value + record_alignment - 1) / record_alignment * record_alignment;
+}
+
+std::size_t IndexFileSize(uint64_t capacity)
+{
+    return sizeof(IndexHeader) + capacity * sizeof(IndexSlot);
+}
+
+void WriteAll(int fd, const char* data, std::size_t size, off_t offset)
+{
+    while(size > 0)
+    {
+        const auto written = pwrite(fd, data, size, offset);
+        if(written < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            MIOPEN_THROW("Cache pack: write error: " + std::string(std::strerror(errno)));
+        }
+        data += written;
+        size -= written;
+        offset += written;
+    }
+}
+
+using exclusive_lock = std::unique_lock<LockFile>;
+
+} // namespace
+
+struct BinaryCachePack::Impl
+{
+    Impl(const boost::filesystem::path& directory)
+        : pack_path(directory / "kernels.pack"), index_path(directory / "kernels.idx")
+    {
+    }
+
+    ~Impl()
+    {
+        if(pack_fd >= 0)
+            close(pack_fd);
+    }
+
+    boost::filesystem::path pack_path;
+    boost::filesystem::path index_path;
+    LockFile* lock_file = nullptr;
+    /// Shared by lookups, which do not change the mappings.
+    std::shared_timed_mutex mutex;
+    ipc::mapped_region index;
+    bool index_writable = false;
+    // Binaries returned by Find() keep the mapping they point into alive.
+    std::shared_ptr<const ipc::mapped_region> pack_mapping;
+    int pack_fd = -1;
+
+    /// The lock file is only created by the first Store(), as lookups may have no write access
+    /// to the cache directory.
+    LockFile& GetLockFile()
+    {
+        if(lock_file == nullptr)
+            lock_file = &LockFile::Get(LockFilePath(index_path).c_str());
+        return *lock_file;
+    }
+
+    IndexHeader& Header() const { return *static_cast<IndexHeader*>(index.get_address()); }
+
+    IndexSlot* Slots() const
+    {
+        return reinterpret_cast<IndexSlot*>(static_cast<char*>(index.get_address()) +
+                                            sizeof(IndexHeader));
+    }
+
+    bool IsIndexMapped() const { return index.get_size() != 0 && Header().obsolete == 0; }
+
+    /// Lookups map the index read-only, only Store() needs to write it.
+    bool MapIndex(ipc::mode_t mode)
+    {
+        index          = {};
+        index_writable = false;
+        if(!boost::filesystem::exists(index_path) ||
+           boost::filesystem::file_size(index_path) < sizeof(IndexHeader))
+            return false;
+
+        const ipc::file_mapping file(index_path.c_str(), mode);
+        ipc::mapped_region region(file, mode);
+        const auto& header = *static_cast<const IndexHeader*>(region.get_address());
+        if(header.magic != index_magic || header.capacity == 0 ||
+           (header.capacity & (header.capacity - 1)) != 0 ||
+           region.get_size() != IndexFileSize(header.capacity))
+        {
+            MIOPEN_LOG_W("Cache pack: invalid index file: " << index_path);
+            return false;
+        }
+        index.swap(region);
+        index_writable = mode == ipc::read_write;
+        return true;
+    }
+
+    /// Returns a pointer to the record, or nullptr if [offset, offset + size) is not
+    /// a valid record of the committed part of the pack file. If the record is past the
+    /// mapping of the pack file, it is remapped when `remap` is set, else `stale` is set.
+    const char* GetRecord(uint64_t offset, uint64_t size, bool remap, bool& stale)
+    {
+        if(size < sizeof(RecordHeader) || offset + size > Header().pack_size)
+            return nullptr;
+
+        if(pack_mapping == nullptr || pack_mapping->get_size() < offset + size)
+        {
+            if(!remap)
+            {
+                stale = true;
+                return nullptr;
+            }
+            const auto file_size = boost::filesystem::file_size(pack_path);
+            if(file_size < offset + size)
+                return nullptr;
+            const ipc::file_mapping file(pack_path.c_str(), ipc::read_only);
+            pack_mapping = std::make_shared<ipc::mapped_region>(file, ipc::read_only, 0, file_size);
+        }
+
+        const auto record = static_cast<const char*>(pack_mapping->get_address()) + offset;
+        const auto& header = *reinterpret_cast<const RecordHeader*>(record);
+        if(header.magic != record_magic ||
+           header.data_offset < sizeof(RecordHeader) + header.key_size ||
+           header.data_offset + header.data_size > size)
+            return nullptr;
+        return record;
+    }
+
+    PackedBinary Lookup(const std::string& key, uint64_t hash, bool remap, bool& stale)
+    {
+        const auto capacity = Header().capacity;
+        const auto slots    = Slots();
+        for(uint64_t n = 0, i = hash & (capacity - 1); n < capacity; ++n, i = (i + 1) & (capacity - 1))
+        {
+            const auto& slot = slots[i];
+            if(slot.hash == 0)
+                break;
+            if(slot.hash != hash)
+                continue;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const auto record = GetRecord(slot.offset, slot.size, remap, stale);
+            if(record == nullptr)
+                continue;
+            const auto& header = *reinterpret_cast<const RecordHeader*>(record);
+            if(header.key_size == key.size() &&
+               std::memcmp(record + sizeof(RecordHeader), key.data(), key.size()) == 0)
+                return {record + header.data_offset,
+                        static_cast<std::size_t>(header.data_size),
+                        pack_mapping};
+        }
+        return {};
+    }
+
+    static void Insert(IndexSlot* slots, uint64_t capacity, const IndexSlot& value)
+    {
+        auto i = value.hash & (capacity - 1);
+        while(slots[i].hash != 0)
+            i = (i + 1) & (capacity - 1);
+        slots[i].offset = value.offset;
+        slots[i].size   = value.size;
+        // Set last, so the slot is never seen partially filled.
+        std::atomic_thread_fence(std::memory_order_release);
+        slots[i].hash = value.hash;
+    }
+
+    /// Atomically replaces the index file by a new one and maps it.
+    void WriteIndex(uint64_t capacity, uint64_t pack_size, const std::vector<IndexSlot>& entries)
+    {
+        std::vector<char> buffer(IndexFileSize(capacity));
+        auto& header     = *reinterpret_cast<IndexHeader*>(buffer.data());
+        header.magic     = index_magic;
+        header.capacity  = capacity;
+        header.count     = entries.size();
+        header.pack_size = pack_size;
+        const auto slots = reinterpret_cast<IndexSlot*>(buffer.data() + sizeof(IndexHeader));
+        for(const auto& entry : entries)
+            Insert(slots, capacity, entry);
+
+        const auto tmp_path = index_path.parent_path() / boost::filesystem::unique_path();
+        {
+            std::ofstream file(tmp_path.string(), std::ios::binary);
+            file.write(buffer.data(), buffer.size());
+            if(!file)
+                MIOPEN_THROW("Cache pack: failed writing " + tmp_path.string());
+        }
+        boost::filesystem::rename(tmp_path, index_path);
+
+        if(index.get_size() != 0)
+            Header().obsolete = 1; // Let other processes know that they have to re-map.
+        if(!MapIndex(ipc::read_write))
+            MIOPEN_THROW("Cache pack: failed mapping " + index_path.string());
+    }
+
+    /// Builds the index from the content of the pack file. Scanning stops at
+    /// the first damaged record, the rest of the file is dropped by the next Store().
+    void RecoverIndex()
+    {
+        std::vector<IndexSlot> entries;
+        uint64_t pack_size = 0;
+
+        if(boost::filesystem::exists(pack_path) && boost::filesystem::file_size(pack_path) != 0)
+        {
+            const ipc::file_mapping file(pack_path.c_str(), ipc::read_only);
+            const ipc::mapped_region region(file, ipc::read_only);
+            const auto begin = static_cast<const char*>(region.get_address());
+            const auto end   = begin + region.get_size();
+
+            for(auto record = begin; record + sizeof(RecordHeader) <= end;)
+            {
+                const auto& header = *reinterpret_cast<const RecordHeader*>(record);
+                const auto size    = AlignUp(header.data_offset + header.data_size);
+                if(header.magic != record_magic ||
+                   header.data_offset < sizeof(RecordHeader) + header.key_size ||
+                   size > static_cast<std::size_t>(end - record) ||
+                   Fnv1a(record + header.data_offset, header.data_size) != header.checksum)
+                    break;
+                const auto key = std::string(record + sizeof(RecordHeader), header.key_size);
+                entries.push_back({KeyHash(key), pack_size, size});
+                record += size;
+                pack_size += size;
+            }
+            if(pack_size != region.get_size())
+                MIOPEN_LOG_W("Cache pack: " << (region.get_size() - pack_size)
+                                            << " bytes at the end of "
+                                            << pack_path
+                                            << " are discarded");
+        }
+
+        auto capacity = initial_capacity;
+        while(entries.size() * 2 >= capacity)
+            capacity *= 2;
+        WriteIndex(capacity, pack_size, entries);
+    }
+
+    void Grow()
+    {
+        std::vector<IndexSlot> entries;
+        const auto capacity = Header().capacity;
+        const auto slots    = Slots();
+        for(uint64_t i = 0; i < capacity; ++i)
+            if(slots[i].hash != 0)
+                entries.push_back(slots[i]);
+        WriteIndex(capacity * 2, Header().pack_size, entries);
+    }
+
+    uint64_t Append(const std::string& key, const char* data, std::size_t size)
+    {
+        if(pack_fd < 0)
+        {
+            pack_fd = open(pack_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666); // NOLINT
+            if(pack_fd < 0)
+                MIOPEN_THROW("Cache pack: failed opening " + pack_path.string() + ": " +
+                             std::strerror(errno));
+        }
+
+        RecordHeader header{};
+        header.magic       = record_magic;
+        header.key_size    = static_cast<uint32_t>(key.size());
+        header.data_offset = AlignUp(sizeof(RecordHeader) + key.size());
+        header.data_size   = size;
+        header.checksum    = Fnv1a(data, size);
+
+        std::vector<char> head(header.data_offset);
+        std::memcpy(head.data(), &header, sizeof(header));
+        std::memcpy(head.data() + sizeof(header), key.data(), key.size());
+        const auto record_size = AlignUp(header.data_offset + size);
+        const std::vector<char> tail(record_size - header.data_offset - size);
+
+        // Drop leftovers of interrupted Store() calls.
+        const auto offset = Header().pack_size;
+        if(ftruncate(pack_fd, offset) != 0)
+            MIOPEN_THROW("Cache pack: failed truncating " + pack_path.string());
+        WriteAll(pack_fd, head.data(), head.size(), offset);
+        WriteAll(pack_fd, data, size, offset + head.size());
+        WriteAll(pack_fd, tail.data(), tail.size(), offset + head.size() + size);
+        if(fdatasync(pack_fd) != 0)
+            MIOPEN_THROW("Cache pack: failed syncing " + pack_path.string());
+        return record_size;
+    }
+};
+
+BinaryCachePack::BinaryCachePack(const boost::filesystem::path& directory)
+    : impl(std::make_unique<Impl>(directory))
+{
+}
+
+BinaryCachePack::~BinaryCachePack() = default;
+
+PackedBinary BinaryCachePack::Find(const std::string& key)
+{
+    try
+    {
+        const auto hash = KeyHash(key);
+        auto stale      = false;
+        {
+            const std::shared_lock<std::shared_timed_mutex> guard(impl->mutex);
+            if(impl->IsIndexMapped())
+            {
+                auto found = impl->Lookup(key, hash, false, stale);
+                if(!stale)
+                    return found;
+            }
+        }
+
+        // Files are not locked for lookups: the index is replaced by renaming, slots and
+        // records are never changed after being published, and records are validated by
+        // their full key.
+        const std::lock_guard<std::shared_timed_mutex> guard(impl->mutex);
+        if(!impl->IsIndexMapped() && !impl->MapIndex(ipc::read_only))
+            return {};
+        return impl->Lookup(key, hash, true, stale);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Cache pack: " << ex.what());
+        return {};
+    }
+}
+
+void BinaryCachePack::Store(const std::string& key, const char* data, std::size_t size)
+{
+    try
+    {
+        const std::lock_guard<std::shared_timed_mutex> guard(impl->mutex);
+        const exclusive_lock lock(impl->GetLockFile());
+        if(!impl->IsIndexMapped() || !impl->index_writable)
+        {
+            if(!impl->MapIndex(ipc::read_write))
+                impl->RecoverIndex();
+        }
+
+        const auto hash = KeyHash(key);
+        auto stale      = false;
+        if(!impl->Lookup(key, hash, true, stale).empty())
+            return;
+        if((impl->Header().count + 1) * 2 > impl->Header().capacity)
+            impl->Grow();
+
+        const auto offset      = impl->Header().pack_size;
+        const auto record_size = impl->Append(key, data, size);
+        // The record is committed by the update of the index.
+        impl->Header().pack_size = offset + record_size;
+        Impl::Insert(impl->Slots(), impl->Header().capacity, {hash, offset, record_size});
+        ++impl->Header().count;
+        impl->index.flush();
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Cache pack: " << ex.what());
+    }
+}
+
+} // namespace miopen
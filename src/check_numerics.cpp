@@ -66,8 +66,8 @@ bool checkNumericsImpl(
 
     CheckNumericsResult abnormal_h;
 
-    auto abnormal_d =
-        handle.Create(sizeof(CheckNumericsResult)); // TODO - someday avoid slow malloc/free here
+    // Served from the handle's memory pool when MIOPEN_DEVICE_MEMORY_POOL_LIMIT is set.
+    auto abnormal_d = handle.Create(sizeof(CheckNumericsResult));
     handle.WriteTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
 
     std::string program_name      = "MIOpenCheckNumerics.cl";
@@ -25,69 +25,391 @@
  *******************************************************************************/
 #include <miopen/exec_utils.hpp>
 #include <miopen/logger.hpp>
-#include <miopen/manage_ptr.hpp>
 #include <miopen/errors.hpp>
-#include <istream>
-#include <ostream>
-#include <string>
-#include <cstdio>
+#include <algorithm>
 #include <array>
-#include <cassert>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
 
 #ifdef __linux__
-#include <unistd.h>
-#include <cstdio>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <spawn.h>
 #include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+extern char** environ; // NOLINT
+
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 29)
+#define MIOPEN_HAS_SPAWN_CHDIR 1
+#endif
+#endif
+#ifndef MIOPEN_HAS_SPAWN_CHDIR
+#define MIOPEN_HAS_SPAWN_CHDIR 0
+#endif
 #endif // __linux__
 
 namespace miopen {
 namespace exec {
 
-int Run(const std::string& p, std::istream* in, std::ostream* out)
+std::vector<std::string> SplitCommandLine(const std::string& line)
 {
+    std::vector<std::string> args;
+    std::string arg;
+    auto in_arg = false;
+    auto quote  = '\0';
+
+    for(auto c = line.begin(); c != line.end(); ++c)
+    {
+        if(quote == '\'')
+        {
+            if(*c == '\'')
+                quote = '\0';
+            else
+                arg += *c;
+        }
+        else if(quote == '"')
+        {
+            if(*c == '"')
+                quote = '\0';
+            else if(*c == '\\' && std::next(c) != line.end() &&
+                    std::string{"\\\"$`"}.find(*std::next(c)) != std::string::npos)
+                arg += *++c;
+            else
+                arg += *c;
+        }
+        else if(std::isspace(static_cast<unsigned char>(*c)) != 0)
+        {
+            if(in_arg)
+                args.push_back(std::move(arg));
+            arg.clear();
+            in_arg = false;
+        }
+        else
+        {
+            in_arg = true;
+            if(*c == '\'' || *c == '"')
+                quote = *c;
+            else if(*c == '\\' && std::next(c) != line.end())
+                arg += *++c;
+            else
+                arg += *c;
+        }
+    }
+
+    if(quote != '\0')
+        MIOPEN_THROW("miopen::exec::SplitCommandLine(): unmatched quote in: " + line);
+    if(in_arg)
+        args.push_back(std::move(arg));
+    return args;
+}
+
 #ifdef __linux__
-    const auto redirect_stdin  = (in != nullptr);
-    const auto redirect_stdout = (out != nullptr);
+namespace {
 
-    assert(!(redirect_stdin && redirect_stdout));
+class Pipe
+{
+    public:
+    Pipe()
+    {
+        if(pipe2(fds.data(), O_CLOEXEC) != 0)
+            MIOPEN_THROW("miopen::exec::Run(): pipe2() failed: " + std::string(strerror(errno)));
+    }
+    ~Pipe()
+    {
+        CloseRead();
+        CloseWrite();
+    }
+    Pipe(const Pipe&) = delete;
+    Pipe& operator=(const Pipe&) = delete;
 
-    const auto file_mode = redirect_stdout ? "r" : "w";
-    MIOPEN_MANAGE_PTR(FILE*, pclose) pipe{popen(p.c_str(), file_mode)};
+    int Read() const { return fds[0]; }
+    int Write() const { return fds[1]; }
+    void CloseRead() { Close(fds[0]); }
+    void CloseWrite() { Close(fds[1]); }
 
-    if(!pipe)
-        MIOPEN_THROW("miopen::exec::Run(): popen() failed");
+    private:
+    std::array<int, 2> fds{{-1, -1}};
 
-    if(redirect_stdin || redirect_stdout)
+    static void Close(int& fd)
     {
-        std::array<char, 1024> buffer{};
+        if(fd == -1)
+            return;
+        close(fd);
+        fd = -1;
+    }
+};
+
+class FileActions
+{
+    public:
+    FileActions() { posix_spawn_file_actions_init(&actions); }
+    ~FileActions() { posix_spawn_file_actions_destroy(&actions); }
+    FileActions(const FileActions&) = delete;
+    FileActions& operator=(const FileActions&) = delete;
 
-        if(redirect_stdout)
+    posix_spawn_file_actions_t* Get() { return &actions; }
+
+    private:
+    posix_spawn_file_actions_t actions{};
+};
+
+/// Writing into a pipe whose reader has exited raises SIGPIPE, which would terminate the
+/// whole process. Keep it blocked in this thread and discard it if it has been raised.
+class SigpipeBlock
+{
+    public:
+    SigpipeBlock()
+    {
+        sigemptyset(&sigpipe);
+        sigaddset(&sigpipe, SIGPIPE);
+        sigset_t pending;
+        sigpending(&pending);
+        was_pending = sigismember(&pending, SIGPIPE) != 0;
+        pthread_sigmask(SIG_BLOCK, &sigpipe, &old_mask);
+    }
+    ~SigpipeBlock()
+    {
+        sigset_t pending;
+        sigpending(&pending);
+        if(!was_pending && sigismember(&pending, SIGPIPE) != 0)
         {
-            while(feof(pipe.get()) == 0)
-                if(fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr)
-                    *out << buffer.data();
+            const timespec no_wait{0, 0};
+            sigtimedwait(&sigpipe, nullptr, &no_wait);
         }
-        else
+        pthread_sigmask(SIG_SETMASK, &old_mask, nullptr);
+    }
+    SigpipeBlock(const SigpipeBlock&) = delete;
+    SigpipeBlock& operator=(const SigpipeBlock&) = delete;
+
+    private:
+    sigset_t sigpipe{};
+    sigset_t old_mask{};
+    bool was_pending = false;
+};
+
+std::vector<std::string> MakeEnvironment(const std::vector<std::string>& overrides)
+{
+    const auto name_of = [](const std::string& entry) { return entry.substr(0, entry.find('=')); };
+
+    std::vector<std::string> result;
+    for(auto e = environ; e != nullptr && *e != nullptr; ++e)
+    {
+        const std::string entry = *e;
+        const auto overridden =
+            std::any_of(overrides.begin(), overrides.end(), [&](const std::string& o) {
+                return name_of(o) == name_of(entry);
+            });
+        if(!overridden)
+            result.push_back(entry);
+    }
+    result.insert(result.end(), overrides.begin(), overrides.end());
+    return result;
+}
+
+std::vector<char*> MakeCStrings(std::vector<std::string>& strings)
+{
+    std::vector<char*> result;
+    result.reserve(strings.size() + 1);
+    for(auto& s : strings)
+        result.push_back(&s[0]);
+    result.push_back(nullptr);
+    return result;
+}
+
+void SetNonBlocking(int fd) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK); }
+
+int ExitCode(int status)
+{
+    if(WIFEXITED(status))
+        return WEXITSTATUS(status);
+    if(WIFSIGNALED(status))
+        return 128 + WTERMSIG(status);
+    return -1;
+}
+
+} // namespace
+
+int Run(const std::string& exe, const std::vector<std::string>& args, const Options& options)
+{
+    using clock            = std::chrono::steady_clock;
+    const auto deadline    = clock::now() + options.timeout;
+    const auto has_timeout = options.timeout.count() > 0;
+
+    std::vector<std::string> argv_strings{exe};
+    std::string input;
+    if(options.in != nullptr)
+    {
+        std::ostringstream ss;
+        ss << options.in->rdbuf();
+        input = ss.str();
+    }
+
+    auto spawned = exe;
+#if !MIOPEN_HAS_SPAWN_CHDIR
+    // There is no way to change the directory of the child here, so let a shell do it.
+    // The arguments are passed as separate words and are not interpreted by the shell.
+    if(!options.working_dir.empty())
+    {
+        spawned      = "/bin/sh";
+        argv_strings = {"sh", "-c", "cd \"$0\" && exec \"$@\"", options.working_dir, exe};
+    }
+#endif
+    argv_strings.insert(argv_strings.end(), args.begin(), args.end());
+    auto env_strings = MakeEnvironment(options.env);
+    auto argv        = MakeCStrings(argv_strings);
+    auto envp        = MakeCStrings(env_strings);
+
+    Pipe in_pipe, out_pipe, err_pipe;
+    FileActions actions;
+    if(options.in != nullptr)
+        posix_spawn_file_actions_adddup2(actions.Get(), in_pipe.Read(), STDIN_FILENO);
+    else
+        posix_spawn_file_actions_addopen(actions.Get(), STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    if(options.out != nullptr)
+        posix_spawn_file_actions_adddup2(actions.Get(), out_pipe.Write(), STDOUT_FILENO);
+    if(options.err != nullptr)
+        posix_spawn_file_actions_adddup2(actions.Get(), err_pipe.Write(), STDERR_FILENO);
+#if MIOPEN_HAS_SPAWN_CHDIR
+    if(!options.working_dir.empty())
+        posix_spawn_file_actions_addchdir_np(actions.Get(), options.working_dir.c_str());
+#endif
+
+    pid_t pid = 0;
+    const auto rc =
+        posix_spawnp(&pid, spawned.c_str(), actions.Get(), nullptr, argv.data(), envp.data());
+    if(rc != 0)
+        MIOPEN_THROW("miopen::exec::Run(): can't start " + exe + ": " + strerror(rc));
+
+    auto status           = 0;
+    const auto kill_child = [&] {
+        kill(pid, SIGKILL);
+        while(waitpid(pid, &status, 0) < 0 && errno == EINTR)
+            ;
+    };
+
+    // The child has its own copies of these ends.
+    in_pipe.CloseRead();
+    out_pipe.CloseWrite();
+    err_pipe.CloseWrite();
+
+    const SigpipeBlock sigpipe_block;
+    std::size_t written = 0;
+    if(options.in == nullptr || input.empty())
+        in_pipe.CloseWrite();
+    if(options.out == nullptr)
+        out_pipe.CloseRead();
+    if(options.err == nullptr)
+        err_pipe.CloseRead();
+    for(auto fd : {in_pipe.Write(), out_pipe.Read(), err_pipe.Read()})
+        if(fd != -1)
+            SetNonBlocking(fd);
+
+    auto timed_out = false;
+    std::array<char, 4096> buffer{};
+    while(in_pipe.Write() != -1 || out_pipe.Read() != -1 || err_pipe.Read() != -1)
+    {
+        auto wait_ms = -1;
+        if(has_timeout)
         {
-            while(!in->eof())
+            const auto left =
+                std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now());
+            if(left.count() <= 0)
             {
-                in->read(buffer.data(), buffer.size() - 1);
-                buffer[in->gcount()] = 0;
-
-                if(fputs(buffer.data(), pipe.get()) == EOF)
-                    MIOPEN_THROW("miopen::exec::Run(): fputs() failed");
+                timed_out = true;
+                break;
             }
+            wait_ms = static_cast<int>(left.count()) + 1;
+        }
+
+        std::array<pollfd, 3> fds{{{in_pipe.Write(), POLLOUT, 0},
+                                   {out_pipe.Read(), POLLIN, 0},
+                                   {err_pipe.Read(), POLLIN, 0}}};
+        const auto n = poll(fds.data(), fds.size(), wait_ms);
+        if(n < 0 && errno != EINTR)
+        {
+            const std::string error = strerror(errno);
+            kill_child(); // Do not leave a zombie behind.
+            MIOPEN_THROW("miopen::exec::Run(): poll() failed: " + error);
         }
+        if(n <= 0)
+            continue;
+
+        if(fds[0].revents != 0)
+        {
+            const auto count =
+                write(in_pipe.Write(), input.data() + written, input.size() - written);
+            if(count > 0)
+                written += count;
+            if(written == input.size() || (count < 0 && errno != EAGAIN && errno != EINTR))
+                in_pipe.CloseWrite();
+        }
+
+        const auto drain = [&](Pipe& pipe, const pollfd& fd, std::ostream& stream) {
+            if(fd.revents == 0)
+                return;
+            const auto count = read(pipe.Read(), buffer.data(), buffer.size());
+            if(count > 0)
+                stream.write(buffer.data(), count);
+            else if(count == 0 || (errno != EAGAIN && errno != EINTR))
+                pipe.CloseRead();
+        };
+        if(options.out != nullptr)
+            drain(out_pipe, fds[1], *options.out);
+        if(options.err != nullptr)
+            drain(err_pipe, fds[2], *options.err);
     }
 
-    auto status = pclose(pipe.release());
-    return WEXITSTATUS(status);
+    if(has_timeout)
+    {
+        // The child may outlive its output streams.
+        while(!timed_out && waitpid(pid, &status, WNOHANG) == 0)
+        {
+            if(clock::now() >= deadline)
+                timed_out = true;
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if(timed_out)
+        {
+            kill_child();
+            MIOPEN_THROW("miopen::exec::Run(): " + exe + " has timed out");
+        }
+    }
+    else
+    {
+        while(waitpid(pid, &status, 0) < 0 && errno == EINTR)
+            ;
+    }
+    return ExitCode(status);
+}
 #else
-    (void)p;
-    (void)in;
-    (void)out;
+int Run(const std::string& exe, const std::vector<std::string>& args, const Options& options)
+{
+    (void)exe;
+    (void)args;
+    (void)options;
     return -1;
+}
 #endif // __linux__
+
+int Run(const std::string& exe,
+        const std::vector<std::string>& args,
+        std::istream* in,
+        std::ostream* out)
+{
+    Options options;
+    options.in  = in;
+    options.out = out;
+    return Run(exe, args, options);
 }
 
 } // namespace exec
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/execution_plan.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/make_unique.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace miopen {
+
+void ExecutionPlan::Record(Launcher launch,
+                           const void* args,
+                           std::size_t size,
+                           const std::vector<std::size_t>& pointer_offsets)
+{
+    const auto bytes = static_cast<const char*>(args);
+    auto recorded    = Launch{std::move(launch), {bytes, bytes + size}, {}};
+
+    for(const auto offset : pointer_offsets)
+    {
+        assert(offset + sizeof(const void*) <= size);
+        const void* captured = nullptr;
+        std::memcpy(&captured, bytes + offset, sizeof(captured));
+        if(captured != nullptr)
+            recorded.pointers.push_back({offset, captured});
+    }
+
+    launches.push_back(std::move(recorded));
+}
+
+void ExecutionPlan::Bind(const std::vector<Binding>& bindings)
+{
+    for(auto& launch : launches)
+    {
+        for(const auto& slot : launch.pointers)
+        {
+            const auto binding =
+                std::find_if(bindings.begin(), bindings.end(), [&](const Binding& b) {
+                    return b.first == slot.captured;
+                });
+            const auto value = binding == bindings.end() ? slot.captured : binding->second;
+            std::memcpy(&launch.args[slot.offset], &value, sizeof(value));
+        }
+    }
+}
+
+void ExecutionPlan::Replay() const
+{
+    for(const auto& launch : launches)
+    {
+        // Launchers take mutable arguments only because the launch APIs do.
+        launch.launch(const_cast<char*>(launch.args.data()), launch.args.size()); // NOLINT
+    }
+}
+
+void ExecutionPlan::Replay(const std::vector<Binding>& bindings)
+{
+    Bind(bindings);
+    Replay();
+}
+
+std::vector<const void*> ExecutionPlan::GetBuffers() const
+{
+    std::vector<const void*> result;
+    for(const auto& launch : launches)
+    {
+        for(const auto& slot : launch.pointers)
+        {
+            if(std::find(result.begin(), result.end(), slot.captured) == result.end())
+                result.push_back(slot.captured);
+        }
+    }
+    return result;
+}
+
+void Handle::BeginCapture()
+{
+    if(capture_plan != nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Capture is already in progress");
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        MIOPEN_THROW(miopenStatusBadParm, "Capture can not start while the stream pool is forked");
+    capture_plan = std::make_unique<ExecutionPlan>();
+}
+
+ExecutionPlan Handle::EndCapture()
+{
+    if(capture_plan == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "No capture is in progress");
+    auto plan = std::move(*capture_plan);
+    capture_plan.reset();
+    MIOPEN_LOG_I2("Captured " << plan.GetLaunchCount() << " kernel launches");
+    return plan;
+}
+
+bool Handle::IsCapturing() const { return capture_plan != nullptr; }
+
+} // namespace miopen
@@ -347,6 +347,8 @@ miopenStatus_t CallGemm(Handle& handle,
     case GemmBackend_t::rocblas: {
 #if MIOPEN_USE_ROCBLAS
         MIOPEN_LOG_FUNCTION("rocBLAS");
+        if(handle.IsCapturing())
+            MIOPEN_THROW(miopenStatusNotImplemented, "rocBLAS calls can not be captured");
 
         HipEventPtr start = nullptr;
         HipEventPtr stop  = nullptr;
@@ -654,6 +656,8 @@ miopenStatus_t CallGemmStridedBatched(Handle& handle,
     case GemmBackend_t::rocblas: {
 #if MIOPEN_USE_ROCBLAS
         MIOPEN_LOG_FUNCTION("rocBLAS");
+        if(handle.IsCapturing())
+            MIOPEN_THROW(miopenStatusNotImplemented, "rocBLAS calls can not be captured");
 
         HipEventPtr start = nullptr;
         HipEventPtr stop  = nullptr;
@@ -917,6 +921,8 @@ miopenStatus_t CallGemmStridedBatchedSequential(Handle& handle,
     case GemmBackend_t::rocblas: {
 #if MIOPEN_USE_ROCBLAS
         MIOPEN_LOG_FUNCTION("rocBLAS");
+        if(handle.IsCapturing())
+            MIOPEN_THROW(miopenStatusNotImplemented, "rocBLAS calls can not be captured");
 
         HipEventPtr start = nullptr;
         HipEventPtr stop  = nullptr;
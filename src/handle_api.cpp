@@ -23,9 +23,11 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <algorithm>
 #include <cstdio>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/metrics.hpp>
 
 extern "C" const char* miopenGetErrorString(miopenStatus_t error)
 {
@@ -97,3 +99,45 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t miopenEnableWorkspaceArena(miopenHandle_t handle, bool enable)
+{
+    return miopen::try_([&] { miopen::deref(handle).EnableWorkspaceArena(enable); });
+}
+
+extern "C" miopenStatus_t miopenReserveWorkspaceArena(miopenHandle_t handle, size_t sizeInBytes)
+{
+    return miopen::try_([&] { miopen::deref(handle).ReserveWorkspace(sizeInBytes); });
+}
+
+extern "C" miopenStatus_t miopenGetWorkspaceArenaPeak(miopenHandle_t handle, size_t* sizeInBytes)
+{
+    return miopen::try_(
+        [&] { miopen::deref(sizeInBytes) = miopen::deref(handle).GetWorkspacePeak(); });
+}
+
+extern "C" miopenStatus_t miopenGetMetricsSnapshot(char* snapshot, size_t* sizeInBytes)
+{
+    return miopen::try_([&] {
+        const auto json     = miopen::metrics::Snapshot();
+        const auto required = json.size() + 1;
+        auto& size          = miopen::deref(sizeInBytes);
+        if(snapshot == nullptr)
+        {
+            size = required;
+            return;
+        }
+        if(size < required)
+        {
+            size = required;
+            MIOPEN_THROW(miopenStatusBadParm, "The metrics snapshot does not fit the buffer");
+        }
+        std::copy(json.c_str(), json.c_str() + required, snapshot);
+        size = required;
+    });
+}
+
+extern "C" miopenStatus_t miopenResetMetrics(void)
+{
+    return miopen::try_([&] { miopen::metrics::Reset(); });
+}
@@ -29,8 +29,10 @@
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/kernel_cache.hpp>
+#include <miopen/memory_pool.hpp>
 #include <miopen/binary_cache.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/gemm_geometry.hpp>
 
@@ -208,6 +210,8 @@ Handle::~Handle() {}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        MIOPEN_THROW("Stream can not be changed while the stream pool is forked");
     this->impl->stream = HandleImpl::reference_stream(streamID);
 
 #if MIOPEN_USE_ROCBLAS
@@ -215,12 +219,53 @@ void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 #endif
 }
 
-miopenAcceleratorQueue_t Handle::GetStream() const { return impl->stream.get(); }
+miopenAcceleratorQueue_t Handle::GetStream() const
+{
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        return stream_pool->GetActive();
+    return impl->stream.get();
+}
+
+StreamPool::Backend Handle::GetStreamPoolBackend()
+{
+    using Stream = StreamPool::Stream;
+    // Only the pointers are captured, they stay valid when the handle is moved.
+    auto impl_ptr = this->impl.get();
+    StreamPool::Backend backend;
+    backend.create = [impl_ptr] {
+        impl_ptr->set_ctx();
+        Stream result = nullptr;
+        auto status   = hipStreamCreateWithFlags(&result, hipStreamNonBlocking);
+        if(status != hipSuccess)
+            MIOPEN_THROW_HIP_STATUS(status, "Failed to allocate stream");
+        return result;
+    };
+    backend.destroy = [](Stream stream) { hipStreamDestroy(stream); };
+    backend.wait    = [](Stream waiting, Stream signaling) {
+        hipEvent_t event = nullptr;
+        auto status      = hipEventCreateWithFlags(&event, hipEventDisableTiming);
+        if(status != hipSuccess)
+            MIOPEN_THROW_HIP_STATUS(status, "Failed to create event");
+        const HipEventPtr event_ptr{event};
+        status = hipEventRecord(event, signaling);
+        if(status == hipSuccess)
+            status = hipStreamWaitEvent(waiting, event, 0);
+        if(status != hipSuccess)
+            MIOPEN_THROW_HIP_STATUS(status, "Failed to make stream wait for event");
+    };
+#if MIOPEN_USE_ROCBLAS
+    auto rhandle     = this->rhandle_.get();
+    backend.activate = [rhandle](Stream stream) { rocblas_set_stream(rhandle, stream); };
+#endif
+    return backend;
+}
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
                           void* allocatorContext) const
 {
+    // Cached buffers must go back to the allocator that created them.
+    this->TrimMemoryPool();
     this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
     this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
 
@@ -233,14 +278,20 @@ float Handle::GetKernelTime() const { return this->impl->profiling_result; }
 
 Allocator::ManageDataPtr Handle::Create(std::size_t sz)
 {
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Allocations can not be captured");
     MIOPEN_HANDLE_LOCK
     this->Finish();
+    if(this->memory_pool != nullptr)
+        return this->memory_pool->Allocate(this->impl->allocator, sz, this->GetStream());
     return this->impl->allocator(sz);
 }
 
 Allocator::ManageDataPtr&
 Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz)
 {
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Memory transfers can not be captured");
     MIOPEN_HANDLE_LOCK
     this->Finish();
     auto status = hipMemcpy(ddata.get(), data, sz, hipMemcpyHostToDevice);
@@ -251,6 +302,8 @@ Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t s
 
 void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz)
 {
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Memory transfers can not be captured");
     MIOPEN_HANDLE_LOCK
     this->Finish();
     auto status = hipMemcpy(data, ddata.get(), sz, hipMemcpyDeviceToHost);
@@ -260,6 +313,8 @@ void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size
 
 void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size)
 {
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Memory transfers can not be captured");
     MIOPEN_HANDLE_LOCK
     this->impl->set_ctx();
     auto status = hipMemcpy(dest, src, size, hipMemcpyDeviceToDevice);
@@ -293,6 +348,26 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
     return this->Run(obj);
 }
 
+KernelInvoke Handle::AddKernel(const std::string& algorithm,
+                               const NetworkConfig& network_config,
+                               const std::string& program_name,
+                               const std::string& kernel_name,
+                               const std::vector<size_t>& vld,
+                               const std::vector<size_t>& vgd,
+                               const std::string& params,
+                               std::size_t cache_index)
+{
+    auto obj = this->impl->cache.AddKernel(*this,
+                                           KernelCache::Key{algorithm, network_config},
+                                           program_name,
+                                           kernel_name,
+                                           vld,
+                                           vgd,
+                                           params,
+                                           cache_index);
+    return this->Run(obj);
+}
+
 void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config)
 {
     this->impl->cache.ClearKernels(algorithm, network_config);
@@ -304,18 +379,30 @@ const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
+const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
+                                                  const NetworkConfig& network_config)
+{
+    return this->impl->cache.GetKernels(KernelCache::Key{algorithm, network_config});
+}
+
 bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.HasKernels(algorithm, network_config);
 }
 
+bool Handle::HasKernel(const std::string& algorithm, const NetworkConfig& network_config) const
+{
+    return this->impl->cache.HasKernels(KernelCache::Key{algorithm, network_config});
+}
+
 KernelInvoke Handle::Run(Kernel k)
 {
     this->impl->set_ctx();
-    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
-        return k.Invoke(this->GetStream(), this->impl->elapsed_time_handler());
-    else
-        return k.Invoke(this->GetStream());
+    auto invoke = this->impl->enable_profiling || MIOPEN_GPU_SYNC
+                      ? k.Invoke(this->GetStream(), this->impl->elapsed_time_handler())
+                      : k.Invoke(this->GetStream());
+    invoke.capture = this->capture_plan.get();
+    return invoke;
 }
 
 Program Handle::LoadProgram(const std::string& program_name,
@@ -325,24 +412,53 @@ Program Handle::LoadProgram(const std::string& program_name,
 {
     this->impl->set_ctx();
     params += " -mcpu=" + this->GetDeviceName();
-    auto cache_file =
-        miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
-    if(cache_file.empty())
-    {
-        auto p =
-            HIPOCProgram{program_name, params, is_kernel_str, this->GetDeviceName(), kernel_src};
+    const auto load_cached = [&](bool is_recheck) -> boost::optional<Program> {
+        const auto packed = miopen::LoadPackedBinary(
+            this->GetDeviceName(), program_name, params, is_kernel_str, is_recheck);
+        if(!packed.empty())
+            return HIPOCProgram{program_name, static_cast<const void*>(packed.data)};
+
+        const auto cache_file = miopen::LoadBinary(
+            this->GetDeviceName(), program_name, params, is_kernel_str, is_recheck);
+        if(!cache_file.empty())
+            return HIPOCProgram{program_name, cache_file};
+        return boost::none;
+    };
+
+    auto cached = load_cached(false);
+    if(cached)
+        return *cached;
+
+    // Only one thread compiles the program, the others pick it up from the cache.
+    miopen::InFlightCompilation compilation{
+        this->GetDeviceName(), program_name, params, is_kernel_str};
+    cached = load_cached(true);
+    if(cached)
+        return *cached;
+
+    MIOPEN_TRACE_SCOPE(Compile, trace::Intern(program_name));
+    const auto start = std::chrono::steady_clock::now();
+    auto p           = [&] {
+        try
+        {
+            return HIPOCProgram{
+                program_name, params, is_kernel_str, this->GetDeviceName(), kernel_src};
+        }
+        catch(...)
+        {
+            compilation.SetFailed(std::current_exception());
+            throw;
+        }
+    }();
+    const std::chrono::duration<double> compile_time = std::chrono::steady_clock::now() - start;
 
-        // Save to cache
-        auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
-        boost::filesystem::copy_file(p.GetBinary(), path);
-        miopen::SaveBinary(path, this->GetDeviceName(), program_name, params, is_kernel_str);
+    // Save to cache
+    auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
+    boost::filesystem::copy_file(p.GetBinary(), path);
+    miopen::SaveBinary(
+        path, this->GetDeviceName(), program_name, params, is_kernel_str, compile_time.count());
 
-        return p;
-    }
-    else
-    {
-        return HIPOCProgram{program_name, cache_file};
-    }
+    return p;
 }
 
 void Handle::Finish() const
@@ -363,11 +479,20 @@ void Handle::Finish() const
     }
 #else
     // hipStreamSynchronize is broken, so we use hipEventSynchronize instead
-    auto ev = make_hip_event();
-    hipEventRecord(ev.get(), this->GetStream());
-    auto status = hipEventSynchronize(ev.get());
-    if(status != hipSuccess)
-        MIOPEN_THROW_HIP_STATUS(status, "Failed hip sychronization");
+    const auto sync = [](hipStream_t stream) {
+        auto ev = make_hip_event();
+        hipEventRecord(ev.get(), stream);
+        auto status = hipEventSynchronize(ev.get());
+        if(status != hipSuccess)
+            MIOPEN_THROW_HIP_STATUS(status, "Failed hip sychronization");
+    };
+    if(stream_pool != nullptr && stream_pool->IsForked())
+    {
+        for(auto stream : stream_pool->GetForked())
+            sync(stream);
+    }
+    else
+        sync(this->GetStream());
 #endif
 }
 void Handle::Flush() const {}
@@ -29,12 +29,18 @@
 #include <miopen/exec_utils.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/env.hpp>
+#include <miopen/tool_probe_cache.hpp>
 #include <boost/optional.hpp>
 #include <sstream>
 #include <string>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HCC_ENABLE_COV3)
 
+#ifndef MIOPEN_HIP_COMPILER
+// The Mock backend has no HIP compiler, so HIP kernels can't be built and its version is unknown.
+#define MIOPEN_HIP_COMPILER ""
+#endif
+
 namespace miopen {
 
 static bool IsEnabledCoV3()
@@ -52,6 +58,8 @@ boost::filesystem::path HipBuild(boost::optional<TmpDir>& tmp_dir,
                                  const std::string& dev_name)
 {
 #ifdef __linux__
+    if(std::string(MIOPEN_HIP_COMPILER).empty())
+        MIOPEN_THROW("HIP kernels can't be built without a HIP compiler");
     const auto isHCC = EndsWith(MIOPEN_HIP_COMPILER, "hcc");
     // write out the include files
     auto inc_list = GetKernelIncList();
@@ -84,18 +92,26 @@ boost::filesystem::path HipBuild(boost::optional<TmpDir>& tmp_dir,
     params += " ";
     auto bin_file = tmp_dir->path / (filename + ".o");
     // compile
-    auto env = std::string("KMOPTLLC=\"-mattr=+enable-ds128 -amdgpu-enable-global-sgpr-addr");
+    auto env = std::string("KMOPTLLC=-mattr=+enable-ds128 -amdgpu-enable-global-sgpr-addr");
     if(miopen::HipGetHccVersion() >= external_tool_version_t{2, 8, 0})
         env += " --amdgpu-spill-vgpr-to-agpr=0";
-    env += '\"';
-    tmp_dir->Execute(env + std::string(" ") + MIOPEN_HIP_COMPILER,
-                     params + filename + " -o " + bin_file.string());
+    params += filename + " -o " + bin_file.string();
+    MIOPEN_LOG_I2(env << " " << MIOPEN_HIP_COMPILER << " " << params);
+    exec::Options options;
+    options.working_dir = tmp_dir->path.string();
+    options.env         = {env};
+    if(exec::Run(MIOPEN_HIP_COMPILER, exec::SplitCommandLine(params), options) != 0)
+        MIOPEN_THROW(filename + " failed to compile");
     if(!boost::filesystem::exists(bin_file))
         MIOPEN_THROW(filename + " failed to compile");
     if(isHCC)
     {
         // call extract kernel
+#ifdef EXTRACTKERNEL_BIN
         tmp_dir->Execute(EXTRACTKERNEL_BIN, " -i " + bin_file.string());
+#else
+        MIOPEN_THROW("extractkernel is required to build HIP kernels with hcc");
+#endif
         auto hsaco =
             std::find_if(boost::filesystem::directory_iterator{tmp_dir->path},
                          {},
@@ -139,7 +155,7 @@ static external_tool_version_t HipGetHccVersionImpl()
 
         std::stringstream out;
         MIOPEN_LOG_NQI2("Running: " << '\'' << path << " --version" << '\'');
-        if(miopen::exec::Run(path + " --version", nullptr, &out) != 0)
+        if(miopen::exec::Run(path, {"--version"}, nullptr, &out) != 0)
             break;
 
         std::string line;
@@ -176,7 +192,20 @@ static external_tool_version_t HipGetHccVersionImpl()
 
 external_tool_version_t HipGetHccVersion()
 {
-    static auto once = HipGetHccVersionImpl();
+    static auto once = [] {
+        const auto probe = [] {
+            const auto v = HipGetHccVersionImpl();
+            if(v.major < 0)
+                return std::string{}; // Not cached, so that the next process retries.
+            std::ostringstream ss;
+            ss << v.major << ' ' << v.minor << ' ' << v.patch;
+            return ss.str();
+        };
+        external_tool_version_t v;
+        std::istringstream(GetCachedToolProbe(MIOPEN_HIP_COMPILER, "hcc_version", probe)) >>
+            v.major >> v.minor >> v.patch;
+        return v;
+    }();
     return once;
 }
 
@@ -28,6 +28,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/hipoc_kernel.hpp>
 #include <miopen/handle_lock.hpp>
+#include <miopen/trace.hpp>
 #include <thread>
 #include <hip/hip_hcc.h>
 #include <hip/hip_runtime.h>
@@ -36,6 +37,7 @@ namespace miopen {
 
 void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 {
+    MIOPEN_TRACE_SCOPE(Launch, trace::Intern(name));
     HipEventPtr start = nullptr;
     HipEventPtr stop  = nullptr;
     void* config[]    = {
@@ -96,6 +98,13 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
     }
 }
 
+ExecutionPlan::Launcher HIPOCKernelInvoke::MakeLauncher() const
+{
+    auto invoke    = *this;
+    invoke.capture = nullptr;
+    return [invoke](void* args, std::size_t size) { invoke.run(args, size); };
+}
+
 HIPOCKernelInvoke HIPOCKernel::Invoke(hipStream_t stream,
                                       std::function<void(hipEvent_t, hipEvent_t)> callback)
 {
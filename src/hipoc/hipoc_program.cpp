@@ -52,6 +52,16 @@ hipModulePtr CreateModule(const boost::filesystem::path& hsaco_file)
     return m;
 }
 
+hipModulePtr CreateModule(const void* code_object)
+{
+    hipModule_t raw_m;
+    auto status = hipModuleLoadData(&raw_m, code_object);
+    hipModulePtr m{raw_m};
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed creating module from memory");
+    return m;
+}
+
 struct HIPOCProgramImpl
 {
     HIPOCProgramImpl(const std::string& program_name, const boost::filesystem::path& hsaco)
@@ -59,6 +69,11 @@ struct HIPOCProgramImpl
     {
         this->module = CreateModule(this->hsaco_file);
     }
+    HIPOCProgramImpl(const std::string& program_name, const void* code_object)
+        : name(program_name)
+    {
+        this->module = CreateModule(code_object);
+    }
     HIPOCProgramImpl(const std::string& program_name,
                      std::string params,
                      bool is_kernel_str,
@@ -86,7 +101,7 @@ struct HIPOCProgramImpl
         hsaco_file = dir->path / (filename + ".o");
         std::string src;
         if(kernel_src.empty())
-            src = is_kernel_str ? program_name : GetKernelSrc(program_name);
+            src = is_kernel_str ? program_name : GetKernelSrc(program_name).to_string();
         else
             src = kernel_src;
         if(!is_kernel_str && miopen::EndsWith(program_name, ".so"))
@@ -145,6 +160,11 @@ HIPOCProgram::HIPOCProgram(const std::string& program_name, const boost::filesys
 {
 }
 
+HIPOCProgram::HIPOCProgram(const std::string& program_name, const void* code_object)
+    : impl(std::make_shared<HIPOCProgramImpl>(program_name, code_object))
+{
+}
+
 hipModule_t HIPOCProgram::GetModule() const { return this->impl->module.get(); }
 
 boost::filesystem::path HIPOCProgram::GetBinary() const { return this->impl->hsaco_file; }
@@ -2,6 +2,7 @@
 #define GUARD_MLOPEN_ALLOCATOR_HPP
 
 #include <cassert>
+#include <memory>
 
 #include <miopen/common.hpp>
 #include <miopen/errors.hpp>
@@ -10,19 +11,28 @@
 
 namespace miopen {
 
+class MemoryPool;
+void ReleaseToPool(MemoryPool& pool, void* ptr);
+
 struct AllocatorDeleter
 {
     miopenDeallocatorFunction deallocator;
     void* context;
+    /// Set for buffers owned by a MemoryPool, which then decides how to free them.
+    std::shared_ptr<MemoryPool> pool;
 
     template <class T>
     void operator()(T* x) const
     {
-        assert(deallocator != nullptr);
-        if(x != nullptr)
+        if(x == nullptr)
+            return;
+        if(pool != nullptr)
         {
-            deallocator(context, x);
+            ReleaseToPool(*pool, x);
+            return;
         }
+        assert(deallocator != nullptr);
+        deallocator(context, x);
     }
 };
 struct Allocator
@@ -44,7 +54,7 @@ struct Allocator
             MIOPEN_THROW("Custom allocator failed to allocate memory for buffer size " +
                          std::to_string(n) + ": ");
         }
-        return ManageDataPtr{DataCast(result), AllocatorDeleter{deallocator, context}};
+        return ManageDataPtr{DataCast(result), AllocatorDeleter{deallocator, context, nullptr}};
     }
 };
 
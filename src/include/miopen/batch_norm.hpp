@@ -39,6 +39,7 @@
 namespace miopen {
 
 struct Handle;
+class NetworkConfig;
 struct TensorDescriptor;
 
 void DeriveBNTensorDescriptor(TensorDescriptor& derivedBnDesc,
@@ -52,7 +53,7 @@ void bnBwdTrainSelectSingle(Handle& handle,
                             std::string& program_name,
                             std::string& algo_name,
                             std::string& kernel_name,
-                            std::string& network_config,
+                            const NetworkConfig& network_config,
                             std::string& parms,
                             std::vector<size_t>& vld,
                             std::vector<size_t>& vgd,
@@ -73,7 +74,7 @@ void bnBwdTrainSelectMulti(Handle& handle,
                            std::string& program_name,
                            std::string& algo_name,
                            std::string& kernel_name,
-                           std::string& network_config,
+                           const NetworkConfig& network_config,
                            std::string& parms,
                            std::vector<size_t>& vld,
                            std::vector<size_t>& vgd,
@@ -94,7 +95,7 @@ void bnFwdTrainSelectSingle(Handle& handle,
                             std::string& program_name,
                             std::string& algo_name,
                             std::string& kernel_name,
-                            std::string& network_config,
+                            const NetworkConfig& network_config,
                             std::string& parms,
                             std::vector<size_t>& vld,
                             std::vector<size_t>& vgd,
@@ -117,7 +118,7 @@ void bnFwdTrainSelectMulti(Handle& handle,
                            std::string& program_name,
                            std::string& algo_name,
                            std::string& kernel_name,
-                           std::string& network_config,
+                           const NetworkConfig& network_config,
                            std::string& parms,
                            std::vector<size_t>& vld,
                            std::vector<size_t>& vgd,
@@ -27,6 +27,12 @@
 #ifndef GUARD_MLOPEN_BINARY_CACHE_HPP
 #define GUARD_MLOPEN_BINARY_CACHE_HPP
 
+#include <miopen/binary_cache_pack.hpp>
+#include <cstddef>
+#include <ctime>
+#include <exception>
+#include <future>
+#include <memory>
 #include <string>
 #include <boost/filesystem/path.hpp>
 
@@ -38,15 +44,82 @@ boost::filesystem::path GetCacheFile(const std::string& device,
                                      bool is_kernel_str);
 
 boost::filesystem::path GetCachePath();
+bool IsCacheDisabled();
+/// Lookups with is_recheck set repeat a lookup after waiting for InFlightCompilation
+/// and are not counted in BinaryCacheStats.
 std::string LoadBinary(const std::string& device,
                        const std::string& name,
                        const std::string& args,
-                       bool is_kernel_str = false);
+                       bool is_kernel_str = false,
+                       bool is_recheck    = false);
+/// Moves the binary to the cache. compile_seconds is the time spent
+/// on building the binary, it is used for statistics.
 void SaveBinary(const boost::filesystem::path& binary_path,
                 const std::string& device,
                 const std::string& name,
                 const std::string& args,
-                bool is_kernel_str = false);
+                bool is_kernel_str     = false,
+                double compile_seconds = 0.0);
+
+/// True if binaries are stored in the pack file (see BinaryCachePack)
+/// instead of the directory tree. Controlled by MIOPEN_CACHE_PACK.
+bool IsCachePackEnabled();
+/// Returns empty binary if not found or the pack file is not used.
+/// Otherwise, the binary stays valid while the returned object exists.
+PackedBinary LoadPackedBinary(const std::string& device,
+                              const std::string& name,
+                              const std::string& args,
+                              bool is_kernel_str = false,
+                              bool is_recheck    = false);
+
+/// Process-wide deduplication of concurrent compilations of the same program.
+/// The first thread which creates an instance for a binary is the owner and is expected
+/// to compile and save the binary. Instances created by other threads for the same
+/// binary wait in the constructor until the owner's instance is destroyed. After that,
+/// the binary is expected to be in the cache. If the owner has failed to compile,
+/// the waiting constructors rethrow its exception instead.
+class InFlightCompilation
+{
+    public:
+    InFlightCompilation(const std::string& device,
+                        const std::string& name,
+                        const std::string& args,
+                        bool is_kernel_str = false);
+    ~InFlightCompilation();
+    InFlightCompilation(const InFlightCompilation&) = delete;
+    InFlightCompilation& operator=(const InFlightCompilation&) = delete;
+
+    /// Called by the owner if the compilation has failed.
+    void SetFailed(std::exception_ptr error);
+
+    private:
+    std::string key;
+    std::unique_ptr<std::promise<void>> promise; // Owner only.
+    std::exception_ptr failure;
+};
+
+/// Removes least recently used binaries from the directory layout of the cache
+/// until its size falls below 90% of the limit. Binaries accessed within last
+/// min_age seconds are retained. Returns the number of removed binaries.
+/// The caller is responsible for serialization against other processes.
+std::size_t
+EvictFromCache(const boost::filesystem::path& directory, std::size_t limit, std::time_t min_age = 60);
+
+/// Counters are per process, except compile_seconds_saved which is estimated
+/// from the average compile time of all the binaries put in the cache so far.
+struct BinaryCacheStats
+{
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t bytes_written;
+    std::size_t evictions;
+    std::size_t bytes_evicted;
+    std::size_t cache_bytes; // As seen by the last eviction check, 0 if none.
+    double compile_seconds;  // Spent on compilation of missed binaries.
+    double compile_seconds_saved;
+};
+
+BinaryCacheStats GetBinaryCacheStats();
 
 } // namespace miopen
 
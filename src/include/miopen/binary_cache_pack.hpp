@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_BINARY_CACHE_PACK_HPP
+#define GUARD_MIOPEN_BINARY_CACHE_PACK_HPP
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace miopen {
+
+/// Binary stored in the pack file. Points directly into the read-only mapping of
+/// the pack file, which is kept alive by this object.
+struct PackedBinary
+{
+    const char* data = nullptr;
+    std::size_t size = 0;
+    std::shared_ptr<const void> mapping;
+
+    bool empty() const { return size == 0; }
+};
+
+/// Single-file alternative to the directory layout of the binary cache.
+///
+/// Binaries are appended to "kernels.pack". "kernels.idx" is an open-addressing
+/// hash table which maps 64-bit hashes of the keys to the records of the pack file.
+/// Both files are memory-mapped, so a warm lookup performs no file system operations.
+///
+/// Records are committed by the index update which follows the (synced) write of
+/// the record, thus an interrupted Store() leaves only an unreferenced tail of the
+/// pack file, which is discarded by the next Store(). Each record holds the full key,
+/// so neither a hash collision nor a damaged index can yield a wrong binary.
+/// Writes are serialized between processes by means of LockFile. Lookups only read
+/// the mapped files without locking them, so a read-only cache can still be used.
+class BinaryCachePack
+{
+    public:
+    BinaryCachePack(const boost::filesystem::path& directory);
+    ~BinaryCachePack();
+    BinaryCachePack(const BinaryCachePack&) = delete;
+    BinaryCachePack& operator=(const BinaryCachePack&) = delete;
+
+    PackedBinary Find(const std::string& key);
+    void Store(const std::string& key, const char* data, std::size_t size);
+
+    private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BINARY_CACHE_PACK_HPP
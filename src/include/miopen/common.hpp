@@ -59,5 +59,19 @@ using ManageDataPtr = MIOPEN_MANAGE_PTR(void, hipFree);
 inline Data_t DataCast(void* p) { return p; }
 
 inline ConstData_t DataCast(const void* p) { return p; }
-#endif // OpenCL vs hip
+
+#elif MIOPEN_BACKEND_MOCK
+
+namespace miopen {
+void MockFree(void* mem);
+} // namespace miopen
+
+using Data_t        = void*;
+using ConstData_t   = const void*;
+using ManageDataPtr = MIOPEN_MANAGE_PTR(void, miopen::MockFree);
+
+inline Data_t DataCast(void* p) { return p; }
+
+inline ConstData_t DataCast(const void* p) { return p; }
+#endif // OpenCL vs hip vs mock
 #endif // GUARD_MIOPEN_COMMON_HPP_
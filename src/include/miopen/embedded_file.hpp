@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_EMBEDDED_FILE_HPP
+#define GUARD_MIOPEN_EMBEDDED_FILE_HPP
+
+#include <boost/utility/string_view.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+
+namespace miopen {
+
+/// A file compiled into the library (see addkernels). Tables of these are
+/// sorted by name and contain only addresses of constants, so they are
+/// initialized at compile time and the contents are never copied.
+struct EmbeddedFile
+{
+    const char* name;
+    const unsigned char* data;
+    std::size_t size;
+
+    boost::string_view Content() const
+    {
+        return {reinterpret_cast<const char*>(data), size}; // NOLINT
+    }
+};
+
+namespace detail {
+
+constexpr int CompareNames(const char* lhs, const char* rhs)
+{
+    while(*lhs != '\0' && *lhs == *rhs)
+    {
+        ++lhs;
+        ++rhs;
+    }
+    return static_cast<unsigned char>(*lhs) - static_cast<unsigned char>(*rhs);
+}
+
+} // namespace detail
+
+template <std::size_t N>
+constexpr bool IsSortedByName(const EmbeddedFile (&files)[N])
+{
+    for(std::size_t i = 1; i < N; ++i)
+        if(detail::CompareNames(files[i - 1].name, files[i].name) >= 0)
+            return false;
+    return true;
+}
+
+/// Returns nullptr if there is no such file.
+template <std::size_t N>
+const EmbeddedFile* FindEmbeddedFile(const EmbeddedFile (&files)[N], const std::string& name)
+{
+    const auto it = std::lower_bound(
+        std::begin(files), std::end(files), name, [](const EmbeddedFile& f, const std::string& n) {
+            return std::strcmp(f.name, n.c_str()) < 0;
+        });
+    if(it == std::end(files) || name != it->name)
+        return nullptr;
+    return it;
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_EMBEDDED_FILE_HPP
@@ -26,15 +26,43 @@
 #ifndef EXEC_UTILS_HPP
 #define EXEC_UTILS_HPP
 
+#include <chrono>
 #include <istream>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace miopen {
 namespace exec {
 
-/// Redirecting both input and output is not supported.
-int Run(const std::string& p, std::istream* in, std::ostream* out);
+struct Options
+{
+    /// Working directory of the child process. Empty means the current one.
+    std::string working_dir;
+    /// "NAME=value" entries which are added to (or override) the inherited environment.
+    std::vector<std::string> env;
+    /// Fed to stdin of the child. If null, stdin is redirected from /dev/null.
+    std::istream* in = nullptr;
+    /// Receive stdout/stderr of the child. If null, the streams are inherited.
+    std::ostream* out = nullptr;
+    std::ostream* err = nullptr;
+    /// The child is killed and an exception is thrown when the timeout expires.
+    /// Zero means no timeout.
+    std::chrono::milliseconds timeout{0};
+};
+
+/// Runs the program directly (without a shell) and returns its exit code.
+/// A program killed by a signal yields 128 + signal number, like in shells.
+int Run(const std::string& exe, const std::vector<std::string>& args, const Options& options);
+
+int Run(const std::string& exe,
+        const std::vector<std::string>& args,
+        std::istream* in,
+        std::ostream* out);
+
+/// Splits a command line into arguments like a shell does, but only honours quotes
+/// and backslashes: there are no expansions, redirections and so on.
+std::vector<std::string> SplitCommandLine(const std::string& line);
 
 } // namespace exec
 } // namespace miopen
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_EXECUTION_PLAN_HPP
+#define GUARD_MIOPEN_EXECUTION_PLAN_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Kernel launches recorded between Handle::BeginCapture and Handle::EndCapture. Each launch
+/// keeps the resolved kernel together with its arguments, packed exactly as they were passed,
+/// and the offsets of the device pointers among them. Replay re-binds those pointers and
+/// launches the kernels in order without building problem descriptions, network configs or
+/// kernel cache keys again.
+class ExecutionPlan
+{
+    public:
+    /// Launches the recorded kernel with the given packed arguments.
+    using Launcher = std::function<void(void* args, std::size_t size)>;
+    /// A buffer pointer seen during capture and the pointer to use instead.
+    using Binding = std::pair<const void*, const void*>;
+
+    void Record(Launcher launch,
+                const void* args,
+                std::size_t size,
+                const std::vector<std::size_t>& pointer_offsets);
+
+    /// Points every argument that held `first` during capture at `second`. Pointers without a
+    /// binding go back to their captured values.
+    void Bind(const std::vector<Binding>& bindings);
+    void Replay() const;
+    void Replay(const std::vector<Binding>& bindings);
+
+    std::size_t GetLaunchCount() const { return launches.size(); }
+    /// Distinct buffer pointers the recorded launches use, in order of first use.
+    std::vector<const void*> GetBuffers() const;
+
+    private:
+    struct PointerSlot
+    {
+        std::size_t offset;
+        const void* captured;
+    };
+
+    struct Launch
+    {
+        Launcher launch;
+        std::vector<char> args;
+        std::vector<PointerSlot> pointers;
+    };
+
+    std::vector<Launch> launches;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_EXECUTION_PLAN_HPP
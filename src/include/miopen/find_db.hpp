@@ -31,6 +31,7 @@
 #include <miopen/db_path.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/readonlyramdb.hpp>
 
@@ -88,11 +89,7 @@ class FindDbRecord_t
                                                     !IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}),
                                                 DbTimer<TDb>{installed_path, path}))
     {
-        if(!db.is_initialized())
-            return;
-
-        content = db->FindRecord(problem);
-        in_sync = content.is_initialized();
+        Load(problem);
     }
 
     template <class TProblemDescription, class TTestDb = TDb>
@@ -103,11 +100,7 @@ class FindDbRecord_t
                                                     !IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}),
                                                 DbTimer<TDb>{path, false}))
     {
-        if(!db.is_initialized())
-            return;
-
-        content = db->FindRecord(problem);
-        in_sync = content.is_initialized();
+        Load(problem);
     }
 
     ~FindDbRecord_t()
@@ -158,6 +151,20 @@ class FindDbRecord_t
 
     static bool HasKernel(Handle& handle, const FindDbKCacheKey& key);
 
+    template <class TProblemDescription>
+    void Load(const TProblemDescription& problem)
+    {
+        if(!db.is_initialized())
+            return;
+
+        {
+            const metrics::Timer timer{metrics::Histogram::FindDbLookupSeconds};
+            content = db->FindRecord(problem);
+        }
+        in_sync = content.is_initialized();
+        metrics::Add(in_sync ? metrics::Counter::FindDbHits : metrics::Counter::FindDbMisses);
+    }
+
     static std::string GetInstalledPath(Handle& handle);
     static std::string GetUserPath(Handle& handle);
 
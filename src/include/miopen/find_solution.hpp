@@ -30,7 +30,9 @@
 #include <miopen/env.hpp>
 #include <miopen/conv_solution.hpp>
 #include <miopen/find_controls.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/solver_id.hpp>
+#include <miopen/trace.hpp>
 
 #include <limits>
 #include <vector>
@@ -64,7 +66,12 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
         {
             using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
             PerformanceConfig config{};
-            if(db.Load(context, SolverDbId(s), config))
+            const auto loaded = [&] {
+                const metrics::Timer timer{metrics::Histogram::PerfDbLookupSeconds};
+                return db.Load(context, SolverDbId(s), config);
+            }();
+            metrics::Add(loaded ? metrics::Counter::PerfDbHits : metrics::Counter::PerfDbMisses);
+            if(loaded)
             {
                 MIOPEN_LOG_I2("Perf Db: record loaded: " << SolverDbId(s));
                 if(s.IsValidPerformanceConfig(context, config))
@@ -119,12 +126,25 @@ ConvSolution FindSolution(Solver s, const Context& context, Db& db)
 {
     static_assert(std::is_empty<Solver>{} && std::is_trivially_constructible<Solver>{},
                   "Solver must be stateless");
+    MIOPEN_TRACE_SCOPE(SolverSolution, trace::Intern(SolverDbId(s)));
     // TODO: This assumes all solutions are ConvSolution
     auto solution      = FindSolutionImpl(rank<1>{}, s, context, db);
     solution.solver_id = SolverDbId(s);
     return solution;
 }
 
+/// IsApplicable, traced with the result as argument.
+template <class Solver, class Context>
+bool IsApplicableTraced(const Solver& s, const Context& context)
+{
+    trace::Scope scope;
+    if(trace::IsEnabled())
+        scope.Begin(trace::Category::SolverApplicable, trace::Intern(SolverDbId(s)));
+    const bool applicable = s.IsApplicable(context);
+    scope.SetArg(applicable ? 1 : 0);
+    return applicable;
+}
+
 template <class... Solvers>
 struct SolverContainer
 {
@@ -145,7 +165,7 @@ struct SolverContainer
                 if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
                 { // Do nothing (and keep silence for the sake of Tuna), just skip.
                 }
-                else if(solver.IsApplicable(search_params))
+                else if(IsApplicableTraced(solver, search_params))
                 {
                     const Solution s = FindSolution(solver, search_params, db);
                     if(s.Succeeded())
@@ -183,7 +203,7 @@ struct SolverContainer
                 if(find_only.IsValid() && find_only != Id{SolverDbId(solver)})
                 { // Do nothing (and keep silence for the sake of Tuna), just skip.
                 }
-                else if(solver.IsApplicable(search_params))
+                else if(IsApplicableTraced(solver, search_params))
                 {
                     auto sz = solver.GetWorkspaceSize(search_params);
                     res.push_back(std::make_pair(SolverDbId(solver), sz));
@@ -35,9 +35,14 @@
 #include <iterator>
 #include <chrono>
 #include <cassert>
+#include <sstream>
+#include <string>
+#include <unordered_set>
 
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/kernel_build_params.hpp>
 
 namespace miopen {
 namespace solver {
@@ -243,6 +248,22 @@ inline void InitRandomly(std::vector<float>& vec)
         *p++ = static_cast<float>(rand() * (1.0 / RAND_MAX));
 }
 
+/// Different performance configs may produce exactly the same set of kernels
+/// (e.g. when some tunable parameters are clamped by the problem config).
+/// The key identifies what is actually going to be launched, so the generic
+/// search can skip re-measuring kernels that were already measured.
+inline std::string GetKernelsKey(const ConvSolution& solution)
+{
+    std::ostringstream ss;
+    for(auto k : solution.construction_params)
+    {
+        k.comp_options = CanonicalBuildOptions(k.comp_options);
+        ss << k << ';';
+    }
+    ss << solution.workspce_sz;
+    return ss.str();
+}
+
 inline size_t divide_round_plus_inf(const size_t x, const unsigned y)
 {
     assert(y > 0);
@@ -461,11 +482,13 @@ auto GenericSearch(const Solver s,
                                << (useSpare ? " (spare)" : "")
                                << "...");
 
-    bool is_passed   = false; // left false only if all iterations failed.
-    float best_time  = std::numeric_limits<float>::max();
-    size_t n_failed  = 0;
-    size_t n_current = 0;
-    size_t n_best    = 0;
+    bool is_passed      = false; // left false only if all iterations failed.
+    float best_time     = std::numeric_limits<float>::max();
+    size_t n_failed     = 0;
+    size_t n_current    = 0;
+    size_t n_best       = 0;
+    size_t n_duplicates = 0;
+    std::unordered_set<std::string> measured_kernels;
     HeartBeat<PerformanceConfig> heartbeat;
     heartbeat.Start();
 
@@ -490,6 +513,15 @@ auto GenericSearch(const Solver s,
                              << current_solution.workspce_sz);
         }
 
+        if(ret == 0 && current_solution.Succeeded() &&
+           !measured_kernels.insert(GetKernelsKey(current_solution)).second)
+        {
+            MIOPEN_LOG_I2('#' << n_current << " skipped: the same kernels were measured before");
+            ++n_duplicates;
+            ++n_current;
+            continue;
+        }
+
         if(ret == 0)
         {
             ret = s.RunAndMeasureSolution(profile_h,
@@ -586,7 +618,9 @@ auto GenericSearch(const Solver s,
                           << ' '
                           << best_time
                           << ' '
-                          << best_config);
+                          << best_config
+                          << ", skipped duplicates: "
+                          << n_duplicates);
     if(!is_passed)
         MIOPEN_THROW("Search failed");
     // Run once with the default config and show score.
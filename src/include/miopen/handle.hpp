@@ -33,11 +33,17 @@
 #include <memory>
 #include <miopen/config.h>
 #include <miopen/common.hpp>
+#include <miopen/execution_plan.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/memory_pool.hpp>
 #include <miopen/miopen.h>
 #include <miopen/object.hpp>
 #include <miopen/allocator.hpp>
+#include <miopen/network_config.hpp>
 #include <miopen/simple_hash.hpp>
+#include <miopen/stream_pool.hpp>
+#include <miopen/tensor_op_launch.hpp>
+#include <miopen/workspace_arena.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <vector>
 #include <unordered_map>
@@ -74,6 +80,42 @@ struct Handle : miopenHandle
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
 
+    /// Keeps up to `limit` bytes of freed buffers for reuse by Create(). Zero disables the pool.
+    /// The initial limit comes from MIOPEN_DEVICE_MEMORY_POOL_LIMIT.
+    void SetMemoryPoolLimit(std::size_t limit);
+    std::size_t GetMemoryPoolLimit() const;
+    /// Returns all cached buffers to the allocator.
+    void TrimMemoryPool() const;
+
+    /// Opt-in scratch buffer serving operations called without a user workspace.
+    /// Disabling it frees the buffer.
+    void EnableWorkspaceArena(bool enable = true);
+    bool IsWorkspaceArenaEnabled() const;
+    /// Grows the arena to at least `size` bytes upfront.
+    void ReserveWorkspace(std::size_t size);
+    /// Largest workspace requested from the arena so far.
+    std::size_t GetWorkspacePeak() const;
+    /// Returns the arena buffer grown to at least `size` bytes. Only valid until the next call.
+    Data_t GetWorkspace(std::size_t size);
+
+    /// Opt-in pool of `size` extra streams, see StreamPool. Zero, the default, disables it.
+    void SetStreamPoolSize(std::size_t size);
+    std::size_t GetStreamPoolSize() const;
+    /// Runs the work queued between Fork and Join on up to `branches` streams. While forked
+    /// GetStream returns the stream of the selected branch. Without a pool, or while capturing,
+    /// all branches stay on the main stream. Use StreamFork rather than calling these directly.
+    void Fork(std::size_t branches);
+    void SelectBranch(std::size_t index);
+    void Join();
+    StreamPool::Backend GetStreamPoolBackend();
+
+    /// Records the kernels launched through this handle until EndCapture, see ExecutionPlan.
+    /// Memory transfers and rocBLAS calls can not be replayed and throw while capturing, as do
+    /// allocations, which the plan would not own. Reserve the workspace arena beforehand.
+    void BeginCapture();
+    ExecutionPlan EndCapture();
+    bool IsCapturing() const;
+
     void EnableProfiling(bool enable = true);
 
     void ResetKernelTime();
@@ -93,7 +135,17 @@ struct Handle : miopenHandle
                            bool is_kernel_str            = false,
                            const std::string& kernel_src = "");
 
+    KernelInvoke AddKernel(const std::string& algorithm,
+                           const NetworkConfig& network_config,
+                           const std::string& program_name,
+                           const std::string& kernel_name,
+                           const std::vector<size_t>& vld,
+                           const std::vector<size_t>& vgd,
+                           const std::string& params,
+                           std::size_t cache_index = 0);
+
     bool HasKernel(const std::string& algorithm, const std::string& network_config) const;
+    bool HasKernel(const std::string& algorithm, const NetworkConfig& network_config) const;
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
@@ -102,6 +154,11 @@ struct Handle : miopenHandle
         return this->GetKernelsImpl(algorithm, network_config) |
                boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
     }
+    auto GetKernels(const std::string& algorithm, const NetworkConfig& network_config)
+    {
+        return this->GetKernelsImpl(algorithm, network_config) |
+               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+    }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config)
     {
         auto ks = this->GetKernelsImpl(algorithm, network_config);
@@ -116,6 +173,8 @@ struct Handle : miopenHandle
     KernelInvoke Run(Kernel k);
     const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
                                               const std::string& network_config);
+    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
+                                              const NetworkConfig& network_config);
 
     Program LoadProgram(const std::string& program_name,
                         std::string params,
@@ -125,6 +184,11 @@ struct Handle : miopenHandle
     void Finish() const;
     void Flush() const;
 
+#if MIOPEN_BACKEND_MOCK
+    /// Kernels launched through this handle, the mock backend does not execute them.
+    MockLaunchLog& GetMockLaunches();
+#endif
+
     std::size_t GetLocalMemorySize();
     std::size_t GetGlobalMemorySize();
     std::size_t GetMaxComputeUnits();
@@ -144,7 +208,7 @@ struct Handle : miopenHandle
     WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz);
     void ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz);
     shared<Data_t> CreateSubBuffer(Data_t data, std::size_t offset, std::size_t size);
-#if MIOPEN_BACKEND_HIP
+#if MIOPEN_BACKEND_HIP || MIOPEN_BACKEND_MOCK
     shared<ConstData_t> CreateSubBuffer(ConstData_t data, std::size_t offset, std::size_t size);
 #endif
 
@@ -186,7 +250,12 @@ struct Handle : miopenHandle
     }
 
     std::unique_ptr<HandleImpl> impl;
+    std::shared_ptr<MemoryPool> memory_pool = CreateMemoryPoolFromEnv();
+    WorkspaceArena workspace_arena;
+    std::unique_ptr<ExecutionPlan> capture_plan;
+    std::unique_ptr<StreamPool> stream_pool;
     std::unordered_map<std::string, std::vector<miopenConvSolution_t>> find_map;
+    OpTensorLaunchCache op_tensor_launches;
 #if MIOPEN_USE_MIOPENGEMM
     std::unordered_map<GemmKey, std::unique_ptr<GemmGeometry>, SimpleHash> geo_map;
 #endif
@@ -222,6 +291,32 @@ struct AutoEnableProfiling
     bool prev_state;
 };
 
+/// Forks the handle and joins it again at Join or, at the latest, when it goes out of scope.
+struct StreamFork
+{
+    StreamFork(Handle& x, std::size_t branches) : h(x) { h.Fork(branches); }
+    StreamFork(const StreamFork&) = delete;
+    StreamFork& operator=(const StreamFork&) = delete;
+
+    ~StreamFork()
+    {
+        try
+        {
+            h.Join();
+        }
+        catch(...)
+        {
+            // Join only fails if the backend does, which the next call on the handle reports.
+        }
+    }
+
+    void Branch(std::size_t index) { h.SelectBranch(index); }
+    void Join() { h.Join(); }
+
+    private:
+    Handle& h;
+};
+
 } // namespace miopen
 MIOPEN_DEFINE_OBJECT(miopenHandle, miopen::Handle);
 
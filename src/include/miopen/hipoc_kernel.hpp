@@ -29,9 +29,12 @@
 #include <array>
 #include <cassert>
 #include <miopen/errors.hpp>
+#include <miopen/execution_plan.hpp>
 #include <miopen/hipoc_program.hpp>
+#include <miopen/kernel_args.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/op_kernel_args.hpp>
+#include <type_traits>
 #include <vector>
 #include <memory.h>
 
@@ -45,77 +48,6 @@ inline HipEventPtr make_hip_event()
     return HipEventPtr{result};
 }
 
-#if 1
-
-#if 1
-template <class T, class U>
-struct KernelArgsPair
-{
-    static const int alignment    = sizeof(U);
-    static const int padding      = (alignment - (sizeof(T) % alignment)) % alignment;
-    static const int second_index = sizeof(T) + padding;
-    KernelArgsPair(T x, U y)
-    {
-        new(buffer) T(x);
-        new(buffer + second_index) U(y);
-    }
-    char buffer[second_index + sizeof(U)] = {};
-};
-#else
-template <class T, class U>
-struct KernelArgsPair
-{
-    KernelArgsPair(T x, U y) : first(x), second(y) {}
-    T first;
-    U second;
-};
-#endif
-
-template <class... Ts>
-struct KernelArgsPack;
-
-template <class T, class U, class... Ts>
-struct KernelArgsPack<T, U, Ts...>
-{
-    using data_t = KernelArgsPack<KernelArgsPair<T, U>, Ts...>;
-    KernelArgsPack(T x, U y, Ts... xs) : data(KernelArgsPair<T, U>(x, y), xs...) {}
-    data_t data;
-};
-
-template <class T>
-struct KernelArgsPack<T>
-{
-    KernelArgsPack(T x) : head(x) {}
-    T head;
-};
-
-#else
-
-template <class... Ts>
-struct KernelArgsPack;
-
-template <class T, class... Ts>
-struct KernelArgsPack<T, Ts...>
-{
-    KernelArgsPack(T x, Ts... xs) : head(x), tail(xs...) {}
-    T head;
-    KernelArgsPack<Ts...> tail;
-};
-
-template <>
-struct KernelArgsPack<>
-{
-};
-
-#endif
-template <class... Ts>
-struct KernelArgs
-{
-    KernelArgs(Ts... xs) : pack(xs...) { std::fill(std::begin(hidden), std::end(hidden), 0); }
-    KernelArgsPack<Ts...> pack;
-    uint64_t hidden[6] = {};
-};
-
 struct HIPOCKernelInvoke
 {
     hipStream_t stream = nullptr;
@@ -124,6 +56,7 @@ struct HIPOCKernelInvoke
     std::array<size_t, 3> gdims = {};
     std::string name;
     std::function<void(hipEvent_t, hipEvent_t)> callback;
+    ExecutionPlan* capture = nullptr;
 
     // Workaround for aggregate types in c++11
     HIPOCKernelInvoke() {}
@@ -138,8 +71,8 @@ struct HIPOCKernelInvoke
     }
     void operator()(std::vector<OpKernelArg>& any_args) const
     {
-        char hip_args[256] = {0};
-        auto sz_left       = any_args[0].size();
+        alignas(std::uint64_t) char hip_args[256] = {0};
+        auto sz_left                              = any_args[0].size();
 
         memcpy(hip_args, &(any_args[0].buffer[0]), any_args[0].size());
         //        copy_arg(any_args[0], hip_args, 0);
@@ -154,6 +87,8 @@ struct HIPOCKernelInvoke
             // copy_arg(any_arg, hip_args, second_index);
             sz_left = second_index + alignment;
         }
+        if(capture != nullptr)
+            capture->Record(MakeLauncher(), hip_args, sz_left, OpKernelArgsPointerOffsets(any_args));
         run(hip_args, sz_left);
     }
 
@@ -161,10 +96,15 @@ struct HIPOCKernelInvoke
     void operator()(Ts... xs) const
     {
         KernelArgs<Ts...> args{xs...};
+        if(capture != nullptr)
+            capture->Record(
+                MakeLauncher(), &args, sizeof(args), KernelArgsPointerOffsets<Ts...>());
         run(&args, sizeof(args));
     }
 
     void run(void* args, std::size_t size) const;
+    /// Launches this kernel with already packed arguments, used to replay captured launches.
+    ExecutionPlan::Launcher MakeLauncher() const;
 
     const std::string& GetName() const { return name; }
 };
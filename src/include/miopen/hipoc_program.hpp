@@ -44,6 +44,8 @@ struct HIPOCProgram
                  std::string dev_name,
                  const std::string& kernel_src);
     HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco);
+    /// The code object is not used after the construction.
+    HIPOCProgram(const std::string& program_name, const void* code_object);
     std::shared_ptr<const HIPOCProgramImpl> impl;
     hipModule_t GetModule() const;
     boost::filesystem::path GetBinary() const;
@@ -29,11 +29,13 @@
 #include <string>
 #include <vector>
 
+#include <boost/utility/string_view.hpp>
 #include <miopen/config.h>
 
 namespace miopen {
-std::string GetKernelSrc(std::string name);
-std::string GetKernelInc(std::string key);
+/// The returned views point to the constant data of the library.
+boost::string_view GetKernelSrc(const std::string& name);
+boost::string_view GetKernelInc(const std::string& key);
 std::vector<std::string> GetKernelIncList();
 } // namespace miopen
 
@@ -56,6 +58,16 @@ using Kernel       = HIPOCKernel;
 using KernelInvoke = HIPOCKernelInvoke;
 using Program      = HIPOCProgram;
 
+} // namespace miopen
+
+#elif MIOPEN_BACKEND_MOCK
+#include <miopen/mock_kernel.hpp>
+
+namespace miopen {
+using Kernel       = MockKernel;
+using KernelInvoke = MockKernelInvoke;
+using Program      = MockProgram;
+
 } // namespace miopen
 #endif
 
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_ARGS_HPP
+#define GUARD_MIOPEN_KERNEL_ARGS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Layout of the arguments of a kernel taking Ts..., known at compile time. Every argument is
+/// aligned to its own size right after the previous one, which is what the kernels expect.
+template <class... Ts>
+struct KernelSignature
+{
+    static constexpr std::size_t count = sizeof...(Ts);
+
+    static constexpr std::size_t ArgSize(std::size_t n)
+    {
+        const std::size_t sizes[] = {sizeof(Ts)..., 0};
+        return sizes[n];
+    }
+
+    static constexpr bool IsPointer(std::size_t n)
+    {
+        const bool is_pointer[] = {std::is_pointer<Ts>{}..., false};
+        return is_pointer[n];
+    }
+
+    static constexpr std::size_t Offset(std::size_t n)
+    {
+        std::size_t offset = 0;
+        std::size_t end    = 0;
+        for(std::size_t i = 0; i <= n; ++i)
+        {
+            offset = end + (ArgSize(i) - end % ArgSize(i)) % ArgSize(i);
+            end    = offset + ArgSize(i);
+        }
+        return offset;
+    }
+
+    /// End of the last argument.
+    static constexpr std::size_t Size()
+    {
+        return count == 0 ? 0 : Offset(count - 1) + ArgSize(count - 1);
+    }
+
+    static constexpr std::size_t Alignment()
+    {
+        std::size_t result = 1;
+        for(std::size_t i = 0; i < count; ++i)
+            result = std::max(result, ArgSize(i));
+        return result;
+    }
+
+    /// Writes the arguments at their offsets into buffer, which must hold Size() bytes.
+    static void Pack(char* buffer, Ts... xs)
+    {
+        Pack(buffer, std::index_sequence_for<Ts...>{}, xs...);
+    }
+
+    static std::vector<std::size_t> PointerOffsets()
+    {
+        std::vector<std::size_t> result;
+        for(std::size_t i = 0; i < count; ++i)
+            if(IsPointer(i))
+                result.push_back(Offset(i));
+        return result;
+    }
+
+    private:
+    template <std::size_t... Is>
+    static void Pack(char* buffer, std::index_sequence<Is...>, Ts... xs)
+    {
+        (void)std::initializer_list<int>{
+            (new(buffer + std::integral_constant<std::size_t, Offset(Is)>{}) Ts(xs), 0)...};
+    }
+};
+
+/// Kernel arguments packed by their KernelSignature, followed by the hidden arguments. The
+/// arguments are rounded up to the hidden ones, so there are no uninitialized padding bytes.
+template <class... Ts>
+struct KernelArgs
+{
+    using Signature = KernelSignature<Ts...>;
+
+    static constexpr std::size_t size =
+        (std::max<std::size_t>(Signature::Size(), 1) + sizeof(std::uint64_t) - 1) /
+        sizeof(std::uint64_t) * sizeof(std::uint64_t);
+
+    KernelArgs(Ts... xs) { Signature::Pack(buffer, xs...); }
+
+    alignas(std::uint64_t) char buffer[size] = {};
+    std::uint64_t hidden[6]                  = {};
+};
+
+/// Offsets of the pointer arguments within KernelArgs<Ts...>.
+template <class... Ts>
+std::vector<std::size_t> KernelArgsPointerOffsets()
+{
+    return KernelSignature<Ts...>::PointerOffsets();
+}
+
+} // namespace miopen
+
+#endif
@@ -132,6 +132,13 @@ class KernelBuildParameters
     }
 };
 
+/// Canonical form of a compiler options string, used in the keys of the kernel and binary
+/// caches. Programs are still compiled with the options as given. -D and -Wa,-defsym,
+/// defines go after the other options and are sorted by name, "-D NAME" is joined into
+/// "-DNAME" and the whitespace is collapsed. Strings with quotes or escapes, -U options or
+/// a name defined more than once are returned unchanged, as the order may matter there.
+std::string CanonicalBuildOptions(const std::string& options);
+
 namespace kbp {
 struct OpenCL
 {
@@ -44,8 +44,15 @@
 
 #include <miopen/handle.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/network_config.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <boost/utility/string_view.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -55,14 +62,66 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * The cache is safe to use from several threads. Kernels are kept in several
+ * independently locked shards, so lookups of different keys do not contend.
+ * References returned by GetKernels stay valid for the lifetime of the cache,
+ * but changing the kernels of a key while they are used requires external
+ * synchronization.
  */
 class KernelCache
 {
 
     public:
-    using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    /// Refers to the algorithm and network config without copying them, so looking up
+    /// kernels does not allocate. It must not outlive the strings or the NetworkConfig
+    /// it is built from. The network config is either a string or a binary NetworkConfig,
+    /// the other one is left empty.
+    struct Key
+    {
+        Key(boost::string_view algorithm_, boost::string_view network_config_);
+        Key(boost::string_view algorithm_, const NetworkConfig& network_config_);
+
+        bool operator==(const Key& other) const
+        {
+            return hash == other.hash && algorithm == other.algorithm &&
+                   network_config == other.network_config &&
+                   (binary_config == other.binary_config ||
+                    (binary_config != nullptr && other.binary_config != nullptr &&
+                     *binary_config == *other.binary_config));
+        }
+
+        bool HasNetworkConfig() const
+        {
+            return !network_config.empty() || (binary_config != nullptr && !binary_config->Empty());
+        }
+        /// For logs
+        std::string GetNetworkConfig() const;
+
+        boost::string_view algorithm;
+        boost::string_view network_config;
+        const NetworkConfig* binary_config = nullptr;
+        std::uint64_t hash;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const { return key.hash; }
+    };
+
+    /// Owns what the key of its map entry refers to.
+    struct Entry
+    {
+        explicit Entry(const Key& key);
+
+        std::string algorithm;
+        std::string network_config;
+        NetworkConfig binary_config;
+        Key key;
+        std::vector<Kernel> kernels;
+    };
+
+    using KernelMap  = std::unordered_map<Key, std::unique_ptr<Entry>, KeyHash>;
+    using ProgramMap = std::unordered_map<std::pair<std::string, std::string>, Program, SimpleHash>;
 
     Kernel AddKernel(Handle& h,
                      const std::string& algorithm,
@@ -76,19 +135,47 @@ class KernelCache
                      bool is_kernel_miopengemm_str = false,
                      const std::string& kernel_src = "");
 
-    void AddKernel(Key key, Kernel k, std::size_t cache_index);
+    Kernel AddKernel(Handle& h,
+                     const Key& key,
+                     const std::string& program_name,
+                     const std::string& kernel_name,
+                     const std::vector<size_t>& vld,
+                     const std::vector<size_t>& vgd,
+                     std::string params            = "",
+                     std::size_t cache_index       = 0,
+                     bool is_kernel_miopengemm_str = false,
+                     const std::string& kernel_src = "");
+
+    void AddKernel(const Key& key, Kernel k, std::size_t cache_index);
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
+    void ClearKernels(const Key& key);
 
     const std::vector<Kernel>& GetKernels(const std::string& algorithm,
                                           const std::string& network_config);
+    const std::vector<Kernel>& GetKernels(const Key& key);
 
     bool HasKernels(const std::string& algorithm, const std::string& network_config) const;
+    bool HasKernels(const Key& key) const;
 
     KernelCache();
 
     private:
-    KernelMap kernel_map;
+    struct Shard
+    {
+        mutable std::shared_timed_mutex mutex;
+        KernelMap kernel_map;
+    };
+
+    static constexpr std::size_t shard_count = 16;
+
+    static std::vector<Kernel>& GetOrAddKernels(Shard& shard, const Key& key);
+
+    Shard& GetShard(const Key& key) { return shards[key.hash % shard_count]; }
+    const Shard& GetShard(const Key& key) const { return shards[key.hash % shard_count]; }
+
+    std::array<Shard, shard_count> shards;
+    std::mutex program_mutex;
     ProgramMap program_map;
 };
 
@@ -32,8 +32,15 @@
 #include <iostream>
 
 namespace miopen {
+
+struct ConvolutionContext;
+
 namespace solver {
 
+/// The search space consists of two parts. The first one is used by ConvOclDirectFwd
+/// (grp_tile* are derived from in_tile* and out_pix_tile*), the second one by
+/// ConvOclDirectFwd1x1 and is marked by in_tile1 == in_tile0 == grp_tile1 == 1.
+/// The part which is not applicable for the given problem is filtered out by IsValid().
 struct LegacyPerformanceConfig : Serializable<LegacyPerformanceConfig>
 {
     int grp_tile1       = 0;
@@ -46,6 +53,13 @@ struct LegacyPerformanceConfig : Serializable<LegacyPerformanceConfig>
     int n_in_data_tiles = 0;
     int n_stacks        = 0;
 
+    LegacyPerformanceConfig() = default;
+    LegacyPerformanceConfig(bool spare);
+
+    bool SetNextValue();
+    bool IsValid(const ConvolutionContext& params) const;
+    bool operator==(const LegacyPerformanceConfig& other) const;
+
     template <class Solution>
     void CopyTo(Solution& iud) const
     {
@@ -33,6 +33,8 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
 
+#include <miopen/metrics.hpp>
+
 #include <chrono>
 #include <fstream>
 #include <shared_mutex>
@@ -67,9 +69,14 @@ class LockFile
     LockFile(const LockFile&) = delete;
     LockFile operator=(const LockFile&) = delete;
 
-    void lock() { std::lock(access_mutex, flock); }
+    void lock()
+    {
+        const metrics::Timer timer{metrics::Histogram::LockWaitSeconds};
+        std::lock(access_mutex, flock);
+    }
     void lock_shared()
     {
+        const metrics::Timer timer{metrics::Histogram::LockWaitSeconds};
         access_mutex.lock_shared();
         flock.lock_sharable();
     }
@@ -102,6 +109,7 @@ class LockFile
     template <class TDuration>
     bool try_lock_for(TDuration duration)
     {
+        const metrics::Timer timer{metrics::Histogram::LockWaitSeconds};
         if(!access_mutex.try_lock_for(duration))
             return false;
 
@@ -116,6 +124,7 @@ class LockFile
     template <class TDuration>
     bool try_lock_shared_for(TDuration duration)
     {
+        const metrics::Timer timer{metrics::Histogram::LockWaitSeconds};
         if(!access_mutex.try_lock_shared_for(duration))
             return false;
 
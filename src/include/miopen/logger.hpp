@@ -31,10 +31,12 @@
 #include <vector>
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <type_traits>
 
 #include <miopen/each_args.hpp>
 #include <miopen/object.hpp>
+#include <miopen/trace.hpp>
 
 // See https://github.com/pfultz2/Cloak/wiki/C-Preprocessor-tricks,-tips,-and-idioms
 #define MIOPEN_PP_CAT(x, y) MIOPEN_PP_PRIMITIVE_CAT(x, y)
@@ -206,8 +208,21 @@ bool IsLogging(LoggingLevel level, bool disableQuieting = false);
 bool IsLoggingCmd();
 bool IsLoggingFunctionCalls();
 
+/// Writes a formatted record to std::cerr. With MIOPEN_LOG_ASYNC set, or after
+/// SetLoggingAsync(true), records are queued and written by a background thread instead.
+/// The queue is bounded, records which do not fit are dropped and counted.
+void LogWrite(std::string record);
+bool IsLoggingAsync();
+void SetLoggingAsync(bool enable);
+/// Waits until the queued records are written.
+void LoggingFlush();
+std::size_t LoggingDroppedRecords();
+
 namespace logger {
 
+/// Empty stream owned by the calling thread, reused to format function call records.
+std::ostringstream& GetFunctionStream();
+
 template <typename T, typename S>
 struct CArray
 {
@@ -260,34 +275,25 @@ std::ostream& LogParam(std::ostream& os, std::string name, const std::vector<T>&
     return os;
 }
 
-#define MIOPEN_LOG_FUNCTION_EACH(param)                                         \
-    do                                                                          \
-    {                                                                           \
-        /* Clear temp stringstream & reset its state: */                        \
-        std::ostringstream().swap(miopen_log_func_ss);                          \
-        /* Use stringstram as ostream to engage existing template functions: */ \
-        std::ostream& miopen_log_func_ostream = miopen_log_func_ss;             \
-        miopen_log_func_ostream << miopen::LoggingPrefix();                     \
-        miopen::LogParam(miopen_log_func_ostream, #param, param) << std::endl;  \
-        std::cerr << miopen_log_func_ss.str();                                  \
-    } while(false);
-
-#define MIOPEN_LOG_FUNCTION(...)                                                        \
-    do                                                                                  \
-        if(miopen::IsLoggingFunctionCalls())                                            \
-        {                                                                               \
-            std::ostringstream miopen_log_func_ss;                                      \
-            miopen_log_func_ss << miopen::LoggingPrefix() << __PRETTY_FUNCTION__ << "{" \
-                               << std::endl;                                            \
-            std::cerr << miopen_log_func_ss.str();                                      \
-            MIOPEN_PP_EACH_ARGS(MIOPEN_LOG_FUNCTION_EACH, __VA_ARGS__)                  \
-            std::ostringstream().swap(miopen_log_func_ss);                              \
-            miopen_log_func_ss << miopen::LoggingPrefix() << "}" << std::endl;          \
-            std::cerr << miopen_log_func_ss.str();                                      \
-        }                                                                               \
+#define MIOPEN_LOG_FUNCTION_EACH(param) \
+    miopen::LogParam(miopen_log_func_ss << miopen_log_func_prefix, #param, param) << '\n';
+
+/// The call is written as one record, so calls from different threads do not interleave.
+#define MIOPEN_LOG_FUNCTION(...)                                                          \
+    MIOPEN_TRACE_SCOPE(Api, __func__);                                                    \
+    do                                                                                    \
+        if(miopen::IsLoggingFunctionCalls())                                              \
+        {                                                                                 \
+            auto& miopen_log_func_ss          = miopen::logger::GetFunctionStream();      \
+            const auto miopen_log_func_prefix = miopen::LoggingPrefix();                  \
+            miopen_log_func_ss << miopen_log_func_prefix << __PRETTY_FUNCTION__ << "{\n"; \
+            MIOPEN_PP_EACH_ARGS(MIOPEN_LOG_FUNCTION_EACH, __VA_ARGS__)                    \
+            miopen_log_func_ss << miopen_log_func_prefix << "}\n";                        \
+            miopen::LogWrite(miopen_log_func_ss.str());                                   \
+        }                                                                                 \
     while(false)
 #else
-#define MIOPEN_LOG_FUNCTION(...)
+#define MIOPEN_LOG_FUNCTION(...) MIOPEN_TRACE_SCOPE(Api, __func__)
 #endif
 
 std::string LoggingParseFunction(const char* func, const char* pretty_func);
@@ -302,7 +308,7 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
                           << miopen::LoggingParseFunction(__func__,            /* NOLINT */  \
                                                           __PRETTY_FUNCTION__) /* NOLINT */  \
                           << "] " << __VA_ARGS__ << std::endl;                               \
-            std::cerr << miopen_log_ss.str();                                                \
+            miopen::LogWrite(miopen_log_ss.str());                                           \
         }                                                                                    \
     } while(false)
 
@@ -333,7 +339,7 @@ std::string LoggingParseFunction(const char* func, const char* pretty_func);
                              << " [" << miopen::LoggingParseFunction(                   \
                                             __func__, __PRETTY_FUNCTION__) /* NOLINT */ \
                              << "] ./bin/MIOpenDriver " << __VA_ARGS__ << std::endl;    \
-        std::cerr << miopen_driver_cmd_ss.str();                                        \
+        miopen::LogWrite(miopen_driver_cmd_ss.str());                                   \
     } while(false)
 
 } // namespace miopen
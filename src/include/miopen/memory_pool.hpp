@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_MEMORY_POOL_HPP
+#define GUARD_MIOPEN_MEMORY_POOL_HPP
+
+#include <miopen/allocator.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+/// Caches buffers released by a Handle so that repeated allocations of similar size are
+/// served without a round trip to the allocator. Requests are rounded up to size classes
+/// and a cached buffer is only reused by the stream it was released on, so work already
+/// queued on other streams can never observe it being recycled. Buffers always go back to
+/// the allocator that created them, which keeps custom allocators set with SetAllocator
+/// working. At most `limit` bytes are kept cached; anything above that is freed at once.
+class MemoryPool : public std::enable_shared_from_this<MemoryPool>
+{
+    public:
+    explicit MemoryPool(std::size_t limit_);
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+    ~MemoryPool();
+
+    /// Returns a buffer of at least n bytes. The pool must be owned by a shared_ptr.
+    Allocator::ManageDataPtr Allocate(const Allocator& upstream, std::size_t n, const void* stream);
+    /// Frees all cached buffers.
+    void Trim();
+
+    void SetLimit(std::size_t limit_);
+    std::size_t GetLimit() const;
+    std::size_t GetCachedBytes() const;
+
+    static std::size_t SizeClass(std::size_t n);
+
+    private:
+    friend void ReleaseToPool(MemoryPool& pool, void* ptr);
+
+    struct Block
+    {
+        void* ptr;
+        std::size_t size;
+        const void* stream;
+        miopenDeallocatorFunction deallocator;
+        void* context;
+    };
+
+    void Release(void* ptr);
+    static void Free(const std::vector<Block>& blocks);
+
+    mutable std::mutex mutex;
+    std::size_t limit;
+    std::size_t cached_bytes = 0;
+    std::map<std::size_t, std::vector<Block>> cached;
+    std::unordered_map<void*, Block> in_use;
+};
+
+/// Returns a pool caching up to MIOPEN_DEVICE_MEMORY_POOL_LIMIT bytes, or nullptr if the
+/// variable is not set.
+std::shared_ptr<MemoryPool> CreateMemoryPoolFromEnv();
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MEMORY_POOL_HPP
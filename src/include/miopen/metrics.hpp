@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_METRICS_HPP
+#define GUARD_MIOPEN_METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+namespace metrics {
+
+/// Process-wide counters and latency histograms of the work MIOpen does on the host before
+/// kernels can run: database lookups, compilation, cache hits. They are always on, every
+/// update is one relaxed atomic increment. A JSON snapshot is available through
+/// miopenGetMetricsSnapshot, and is written to MIOPEN_METRICS_FILE at exit when it is set.
+
+enum class Counter : std::uint8_t
+{
+    FindDbHits,
+    FindDbMisses,
+    PerfDbHits,
+    PerfDbMisses,
+    KernelCacheHits,
+    KernelCacheMisses,
+    BinaryCacheHits,
+    BinaryCacheMisses,
+    Count,
+};
+
+/// Durations in seconds, counted into buckets with the upper bounds 1us, 10us, ... 100s and
+/// one for everything above.
+enum class Histogram : std::uint8_t
+{
+    FindDbLookupSeconds,
+    PerfDbLookupSeconds,
+    LockWaitSeconds,
+    CompileSeconds,
+    Count,
+};
+
+void Add(Counter counter, std::uint64_t value = 1);
+void Observe(Histogram histogram, double seconds);
+
+/// The counter of how many times `solver` has been selected, either as the best result of
+/// a Find call or for immediate mode. It lives until the process exits.
+std::atomic<std::uint64_t>& GetSolverCounter(const std::string& solver);
+
+std::string Snapshot();
+void Reset();
+
+/// Observes the lifetime of the timer.
+class Timer
+{
+    public:
+    explicit Timer(Histogram histogram_) : histogram(histogram_) {}
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+    ~Timer()
+    {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        Observe(histogram, elapsed.count());
+    }
+
+    private:
+    Histogram histogram;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+} // namespace metrics
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_METRICS_HPP
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MOCK_KERNEL_HPP
+#define GUARD_MIOPEN_MOCK_KERNEL_HPP
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include <miopen/errors.hpp>
+#include <miopen/execution_plan.hpp>
+#include <miopen/kernel_args.hpp>
+#include <miopen/op_kernel_args.hpp>
+
+namespace miopen {
+
+/// Host memory standing in for device memory, see default_allocator in handlemock.cpp.
+void MockFree(void* mem);
+std::size_t MockAllocatedBytes();
+std::size_t MockPeakAllocatedBytes();
+
+struct MockLaunch
+{
+    void* stream;
+    std::string name;
+    std::array<size_t, 3> ldims;
+    std::array<size_t, 3> gdims;
+    std::vector<char> args;
+};
+
+/// `waiting` waits for the work queued on `signaling` before the launch with index `launch`.
+struct MockStreamWait
+{
+    void* waiting;
+    void* signaling;
+    std::size_t launch;
+};
+
+/// Launches seen by the mock backend. They are only counted unless `keep` is set, so long
+/// benchmarks do not grow the log. Together with the waits between streams the kept launches
+/// form the dependency graph the device would execute.
+struct MockLaunchLog
+{
+    std::size_t count = 0;
+    bool keep         = false;
+    std::vector<MockLaunch> launches;
+    std::vector<MockStreamWait> waits;
+
+    void Clear()
+    {
+        count = 0;
+        launches.clear();
+        waits.clear();
+    }
+};
+
+/// Programs are not compiled, the source is only looked up so unknown programs still fail.
+struct MockProgram
+{
+    MockProgram() {}
+    MockProgram(const std::string& program_name,
+                std::string params,
+                bool is_kernel_str,
+                const std::string& kernel_src);
+
+    std::string name;
+    std::string params;
+};
+
+struct MockKernelInvoke
+{
+    void* stream       = nullptr;
+    MockLaunchLog* log = nullptr;
+    std::array<size_t, 3> ldims = {};
+    std::array<size_t, 3> gdims = {};
+    std::string name;
+    /// Receives the elapsed time, which is always zero.
+    std::function<void(float)> callback;
+    ExecutionPlan* capture = nullptr;
+
+    MockKernelInvoke() {}
+    MockKernelInvoke(void* pstream,
+                     MockLaunchLog* plog,
+                     std::array<size_t, 3> pldims,
+                     std::array<size_t, 3> pgdims,
+                     std::string pname,
+                     std::function<void(float)> pcallback)
+        : stream(pstream), log(plog), ldims(pldims), gdims(pgdims), name(pname), callback(pcallback)
+    {
+    }
+
+    void operator()(std::vector<OpKernelArg>& any_args) const
+    {
+        alignas(std::uint64_t) char args[256] = {0};
+        std::size_t size                      = 0;
+        for(auto& any_arg : any_args)
+        {
+            const auto alignment = any_arg.size();
+            const auto offset    = size + (alignment - size % alignment) % alignment;
+            std::memcpy(args + offset, &(any_arg.buffer[0]), any_arg.size());
+            size = offset + alignment;
+        }
+        if(capture != nullptr)
+            capture->Record(MakeLauncher(), args, size, OpKernelArgsPointerOffsets(any_args));
+        run(args, size);
+    }
+
+    template <class... Ts>
+    void operator()(Ts... xs) const
+    {
+        KernelArgs<Ts...> args{xs...};
+        if(capture != nullptr)
+            capture->Record(
+                MakeLauncher(), &args, sizeof(args), KernelArgsPointerOffsets<Ts...>());
+        run(&args, sizeof(args));
+    }
+
+    void run(void* args, std::size_t size) const;
+    ExecutionPlan::Launcher MakeLauncher() const;
+
+    const std::string& GetName() const { return name; }
+};
+
+struct MockKernel
+{
+    MockProgram program;
+    std::string name;
+    std::array<size_t, 3> ldims = {};
+    std::array<size_t, 3> gdims = {};
+
+    MockKernel() {}
+    MockKernel(MockProgram p,
+               const std::string kernel_name,
+               std::vector<size_t> local_dims,
+               std::vector<size_t> global_dims)
+        : program(p), name(kernel_name)
+    {
+        assert(!local_dims.empty() && local_dims.size() <= 3);
+        assert(!global_dims.empty() && global_dims.size() <= 3);
+        ldims.fill(1);
+        gdims.fill(1);
+        std::copy(local_dims.begin(), local_dims.end(), ldims.begin());
+        std::copy(global_dims.begin(), global_dims.end(), gdims.begin());
+    }
+
+    MockKernelInvoke
+    Invoke(void* stream, MockLaunchLog* log, std::function<void(float)> callback = nullptr);
+};
+
+} // namespace miopen
+
+#endif
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_NETWORK_CONFIG_HPP
+#define GUARD_MIOPEN_NETWORK_CONFIG_HPP
+
+#include <miopen/errors.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace miopen {
+
+/// Network config built from typed fields instead of string concatenation.
+///
+/// The fields are packed into a fixed size buffer and hashed as they are added, so building a
+/// config and looking a kernel up with it does not allocate. The name has to be a string
+/// literal or otherwise outlive the config. ToString renders the config for logs only.
+class NetworkConfig
+{
+    public:
+    static constexpr std::size_t max_fields = 32;
+
+    NetworkConfig() = default;
+    explicit NetworkConfig(const char* name_) : name(name_)
+    {
+        for(auto c = name; *c != '\0'; ++c)
+            hash = (hash ^ static_cast<unsigned char>(*c)) * 1099511628211ULL;
+    }
+
+    template <class T, class = std::enable_if_t<std::is_integral<T>{} || std::is_enum<T>{}>>
+    NetworkConfig& operator<<(T x)
+    {
+        return Push(Kind::Integer, static_cast<std::uint64_t>(x));
+    }
+
+    NetworkConfig& operator<<(float x)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return Push(Kind::Float, bits);
+    }
+
+    bool operator==(const NetworkConfig& other) const
+    {
+        return hash == other.hash && size == other.size &&
+               (name == other.name || std::strcmp(name, other.name) == 0) &&
+               kinds == other.kinds && fields == other.fields;
+    }
+    bool operator!=(const NetworkConfig& other) const { return !(*this == other); }
+
+    bool Empty() const { return size == 0 && *name == '\0'; }
+    std::uint64_t GetHash() const { return hash; }
+    std::string ToString() const;
+
+    private:
+    enum class Kind : std::uint8_t
+    {
+        None,
+        Integer,
+        Float,
+    };
+
+    NetworkConfig& Push(Kind kind, std::uint64_t value)
+    {
+        if(size == max_fields)
+            MIOPEN_THROW("Too many fields in network config " + ToString());
+        kinds[size]  = kind;
+        fields[size] = value;
+        ++size;
+        // FNV-1a, the kind separates fields like a delimiter in a string config would.
+        hash = (hash ^ static_cast<std::uint8_t>(kind)) * 1099511628211ULL;
+        for(std::size_t i = 0; i < sizeof(value); ++i)
+            hash = (hash ^ ((value >> (8 * i)) & 0xffU)) * 1099511628211ULL;
+        return *this;
+    }
+
+    const char* name   = "";
+    std::uint64_t hash = 14695981039346656037ULL;
+    std::size_t size   = 0;
+    std::array<Kind, max_fields> kinds{};
+    std::array<std::uint64_t, max_fields> fields{};
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_NETWORK_CONFIG_HPP
@@ -35,12 +35,14 @@
 #include <miopen/miopen.h>
 #include <numeric>
 #include <sstream>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <miopen/clhelper.hpp>
 #include <miopen/each_args.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/execution_plan.hpp>
 #include <miopen/op_kernel_args.hpp>
 
 namespace miopen {
@@ -83,6 +85,43 @@ struct OCLSetKernelArg
     }
 };
 
+/// Arguments of a captured launch, stored back to back. An offset of npos marks local memory.
+struct OCLCapturedArgs
+{
+    static constexpr std::size_t npos = std::size_t(-1);
+
+    std::vector<char> data;
+    std::vector<std::pair<std::size_t, std::size_t>> layout;
+    std::vector<std::size_t> pointer_offsets;
+
+    template <class T>
+    void operator()(const T& x)
+    {
+        if(std::is_pointer<T>{})
+            pointer_offsets.push_back(data.size());
+        Append(&x, sizeof(T));
+    }
+
+    void operator()(const LocalMemArg& lmem)
+    {
+        layout.emplace_back(std::size_t{npos}, lmem.GetSize());
+    }
+
+    void operator()(const OpKernelArg& arg)
+    {
+        if(arg.is_ptr)
+            pointer_offsets.push_back(data.size());
+        Append(arg.buffer.data(), arg.size());
+    }
+
+    void Append(const void* x, std::size_t size)
+    {
+        const auto bytes = static_cast<const char*>(x);
+        layout.emplace_back(data.size(), size);
+        data.insert(data.end(), bytes, bytes + size);
+    }
+};
+
 struct OCLKernelInvoke
 {
     cl_command_queue queue = nullptr;
@@ -92,9 +131,18 @@ struct OCLKernelInvoke
     std::array<size_t, 3> global_work_dim    = {};
     std::array<size_t, 3> local_work_dim     = {};
     std::function<void(cl_event&)> callback;
+    ExecutionPlan* capture = nullptr;
 
     void operator()(std::vector<OpKernelArg> args) const
     {
+        if(capture != nullptr)
+        {
+            OCLCapturedArgs captured;
+            for(const auto& arg : args)
+                captured(arg);
+            Record(captured);
+        }
+
         for(size_t idx = 0; idx < args.size(); idx++)
         {
             auto arg      = args[idx];
@@ -113,6 +161,12 @@ struct OCLKernelInvoke
     template <class... Ts>
     void operator()(const Ts&... xs) const
     {
+        if(capture != nullptr)
+        {
+            OCLCapturedArgs captured;
+            each_args(std::ref(captured), xs...);
+            Record(captured);
+        }
         each_args_i(
             std::bind(
                 OCLSetKernelArg{}, kernel.get(), std::placeholders::_1, std::placeholders::_2),
@@ -121,6 +175,7 @@ struct OCLKernelInvoke
     }
 
     void run() const;
+    void Record(const OCLCapturedArgs& args) const;
     std::string GetName() const;
 };
 
@@ -3,6 +3,7 @@
 
 #include <type_traits>
 #include <cstdint>
+#include <vector>
 #include <half.hpp>
 
 #include <boost/container/small_vector.hpp>
@@ -32,4 +33,19 @@ struct OpKernelArg
     bool is_ptr = false;
 };
 
+/// Offsets of the pointers among arguments packed one after another, each aligned to its size.
+inline std::vector<std::size_t> OpKernelArgsPointerOffsets(const std::vector<OpKernelArg>& args)
+{
+    std::vector<std::size_t> result;
+    std::size_t end = 0;
+    for(const auto& arg : args)
+    {
+        const auto offset = end + (arg.size() - end % arg.size()) % arg.size();
+        if(arg.is_ptr)
+            result.push_back(offset);
+        end = offset + arg.size();
+    }
+    return result;
+}
+
 #endif
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_STREAM_POOL_HPP
+#define GUARD_MIOPEN_STREAM_POOL_HPP
+
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace miopen {
+
+/// Extra streams owned by a Handle that internal code forks independent work onto. Fork makes
+/// the branches wait for everything already queued on the main stream and Join makes the main
+/// stream wait for all of them, so callers see the same ordering as with a single stream.
+/// Branch 0 is the main stream itself. When there are more branches than streams they share
+/// streams round robin, which only serializes them again.
+class StreamPool
+{
+    public:
+    using Stream = miopenAcceleratorQueue_t;
+
+    /// Stream operations of the backend.
+    struct Backend
+    {
+        std::function<Stream()> create;
+        std::function<void(Stream)> destroy;
+        /// Makes `waiting` wait for the work queued on `signaling` so far, through an event.
+        std::function<void(Stream waiting, Stream signaling)> wait;
+        /// Called whenever the stream returned by GetActive changes, may be empty.
+        std::function<void(Stream)> activate;
+    };
+
+    StreamPool(Backend backend_, std::size_t size);
+    StreamPool(const StreamPool&) = delete;
+    StreamPool& operator=(const StreamPool&) = delete;
+    ~StreamPool();
+
+    std::size_t GetSize() const { return streams.size(); }
+    bool IsForked() const { return forked; }
+
+    void Fork(Stream main_, std::size_t branches_);
+    /// Directs the work queued from now on to branch `index`.
+    void Select(std::size_t index);
+    void Join();
+
+    /// The stream work is queued on while forked.
+    Stream GetActive() const { return active; }
+    /// Streams the current fork uses, the main stream first.
+    std::vector<Stream> GetForked() const;
+
+    private:
+    Stream GetBranch(std::size_t index) const;
+    void Activate(Stream stream);
+
+    Backend backend;
+    std::vector<Stream> streams;
+    bool forked          = false;
+    Stream main          = nullptr;
+    Stream active        = nullptr;
+    std::size_t branches = 0;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_STREAM_POOL_HPP
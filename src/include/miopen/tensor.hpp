@@ -33,6 +33,8 @@
 #include <miopen/returns.hpp>
 #include <miopen/errors.hpp>
 
+#include <boost/container/small_vector.hpp>
+
 #include <cassert>
 #include <vector>
 
@@ -114,6 +116,18 @@ std::ptrdiff_t integer_division_ceil(X x, Y y)
     return (tx + ty - 1) / ty;
 }
 
+/// Lengths or strides of a tensor. Up to 8 dimensions are kept inline, so descriptors can be
+/// created, copied and compared without allocating.
+struct TensorDims : boost::container::small_vector<std::size_t, 8>
+{
+    using base = boost::container::small_vector<std::size_t, 8>;
+    using base::base;
+
+    TensorDims() = default;
+
+    operator std::vector<std::size_t>() const { return {begin(), end()}; }
+};
+
 struct TensorDescriptor : miopenTensorDescriptor
 {
     TensorDescriptor();
@@ -139,13 +153,13 @@ struct TensorDescriptor : miopenTensorDescriptor
     TensorDescriptor(miopenDataType_t t, const Range1& plens, const Range2& pstrides)
         : lens(plens.begin(), plens.end()), strides(pstrides.begin(), pstrides.end()), type(t)
     {
-        packed = (this->GetElementSize() == this->GetElementSpace());
+        this->UpdateCache();
     }
 
     void CalculateStrides();
 
-    const std::vector<std::size_t>& GetLengths() const;
-    const std::vector<std::size_t>& GetStrides() const;
+    const TensorDims& GetLengths() const;
+    const TensorDims& GetStrides() const;
     int GetSize() const;
 
     miopenDataType_t GetType() const;
@@ -156,6 +170,9 @@ struct TensorDescriptor : miopenTensorDescriptor
 
     std::size_t GetNumBytes() const;
 
+    /// Hash of the type, lengths and strides, computed on construction.
+    std::size_t GetHash() const;
+
     std::size_t GetIndex(std::initializer_list<int> l) const;
 
     template <class... Ts>
@@ -176,10 +193,14 @@ struct TensorDescriptor : miopenTensorDescriptor
     friend std::ostream& operator<<(std::ostream& stream, const TensorDescriptor& t);
 
     private:
-    std::vector<std::size_t> lens;
-    std::vector<std::size_t> strides;
+    void UpdateCache();
+
+    TensorDims lens;
+    TensorDims strides;
 
     bool packed;
+    std::size_t element_size = 1;
+    std::size_t hash         = 0;
 
     miopenDataType_t type = miopenFloat;
 };
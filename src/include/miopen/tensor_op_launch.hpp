@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_TENSOR_OP_LAUNCH_HPP
+#define GUARD_MIOPEN_TENSOR_OP_LAUNCH_HPP
+
+#include <miopen/common.hpp>
+#include <miopen/kernel.hpp>
+#include <miopen/tensor.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace miopen {
+
+/// Arguments of an OpTensor call which do not change how the kernel is launched.
+struct OpTensorArgs
+{
+    ConstData_t A;
+    ConstData_t B;
+    Data_t C;
+    float alpha0;
+    float alpha1;
+    float beta;
+    long Aoffset;
+    long Boffset;
+    long Coffset;
+};
+
+/// The kernel an OpTensor configuration resolves to, with its launch dims, and a function
+/// passing OpTensorArgs to it in the argument layout of that kernel.
+struct OpTensorLaunch
+{
+    Kernel kernel;
+    std::function<void(const KernelInvoke&, const OpTensorArgs&)> run;
+};
+
+/// Everything the OpTensor launch depends on. Besides the operation and descriptors the
+/// kernels are specialized on whether the scalars are zero.
+struct OpTensorKey
+{
+    OpTensorKey(miopenTensorOp_t op_,
+                const TensorDescriptor& a_,
+                const TensorDescriptor& b_,
+                const TensorDescriptor& c_,
+                unsigned zero_scalars_);
+
+    bool operator==(const OpTensorKey& other) const
+    {
+        return hash == other.hash && op == other.op && zero_scalars == other.zero_scalars &&
+               a == other.a && b == other.b && c == other.c;
+    }
+
+    miopenTensorOp_t op;
+    TensorDescriptor a;
+    TensorDescriptor b;
+    TensorDescriptor c;
+    unsigned zero_scalars;
+    std::size_t hash;
+};
+
+struct OpTensorKeyHash
+{
+    std::size_t operator()(const OpTensorKey& key) const { return key.hash; }
+};
+
+/// Per-handle memo of resolved OpTensor launches, so repeated calls skip the kernel lookup and
+/// launch configuration and go straight to the launch. Safe to use from several threads sharing
+/// a handle. Holds at most Capacity launches and drops an arbitrary one when full.
+class OpTensorLaunchCache
+{
+    public:
+    static constexpr std::size_t Capacity = 256;
+
+    OpTensorLaunchCache() = default;
+    OpTensorLaunchCache(OpTensorLaunchCache&& other) noexcept;
+
+    std::shared_ptr<const OpTensorLaunch> Find(const OpTensorKey& key) const;
+    void Insert(const OpTensorKey& key, OpTensorLaunch launch);
+    std::size_t Size() const;
+
+    private:
+    mutable std::mutex mutex;
+    std::unordered_map<OpTensorKey, std::shared_ptr<const OpTensorLaunch>, OpTensorKeyHash>
+        launches;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TENSOR_OP_LAUNCH_HPP
@@ -6,8 +6,6 @@
 
 namespace miopen {
 
-void SystemCmd(std::string cmd);
-
 struct TmpDir
 {
     boost::filesystem::path path;
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_TOOL_PROBE_CACHE_HPP
+#define GUARD_MIOPEN_TOOL_PROBE_CACHE_HPP
+
+#include <boost/filesystem/path.hpp>
+#include <functional>
+#include <string>
+
+namespace miopen {
+
+/// Returns the result of a toolchain probe (for example, whether the assembler supports
+/// some option). Results are kept in the user cache directory and are reused by other
+/// processes as long as the tool, with symbolic links resolved, has the same path, size
+/// and modification time. The probe is just run when the cache is disabled or the tool
+/// can't be found. The result must be a single line without tabs.
+/// A probe which has failed returns an empty string or throws. Failures are not cached,
+/// and an exception is logged and results in an empty string.
+std::string GetCachedToolProbe(const std::string& tool_path,
+                               const std::string& probe_name,
+                               const std::function<std::string()>& probe);
+
+/// Same as above, but the results are kept in `directory`.
+std::string GetCachedToolProbe(const boost::filesystem::path& directory,
+                               const std::string& tool_path,
+                               const std::string& probe_name,
+                               const std::function<std::string()>& probe);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TOOL_PROBE_CACHE_HPP
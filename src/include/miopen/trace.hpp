@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TRACE_HPP
+#define GUARD_MIOPEN_TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace miopen {
+namespace trace {
+
+/// Tracing records where host time goes into per-thread ring buffers of fixed size events,
+/// which can be exported in the Chrome trace event format read by chrome://tracing and
+/// Perfetto. It is switched on by MIOPEN_TRACE_FILE, the file the trace is written to at exit.
+/// MIOPEN_TRACE_BUFFER_EVENTS sets how many of the most recent events each thread keeps.
+/// While tracing is off every instrumentation point costs one load and one branch.
+
+enum class Category : std::uint8_t
+{
+    Api,
+    Db,
+    SolverApplicable,
+    SolverSolution,
+    Compile,
+    KernelCache,
+    Launch,
+};
+
+enum class Phase : std::uint8_t
+{
+    Begin,
+    End,
+    Instant,
+};
+
+/// Names are not copied, they have to outlive the trace. Use Intern for names that do not.
+struct Event
+{
+    std::uint64_t time;
+    std::uint64_t arg;
+    const char* name;
+    Category category;
+    Phase phase;
+};
+
+namespace detail {
+
+extern std::atomic<bool> enabled;
+
+} // namespace detail
+
+inline bool IsEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+void Enable(bool enable = true);
+
+/// Appends an event to the buffer of the calling thread.
+void Record(Category category, Phase phase, const char* name, std::uint64_t arg = 0);
+/// Returns a copy of `name` that lives until the process exits.
+const char* Intern(const std::string& name);
+
+/// Writes the events of all threads as Chrome trace JSON. Events recorded while exporting
+/// may be missing.
+void Export(std::ostream& os);
+/// Drops the events recorded so far.
+void Clear();
+
+/// Begin and end events of a scope, only recorded if tracing was on when it began.
+class Scope
+{
+    public:
+    Scope() = default;
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    ~Scope()
+    {
+        if(name != nullptr)
+            Record(category, Phase::End, name, arg);
+    }
+
+    void Begin(Category category_, const char* name_)
+    {
+        category = category_;
+        name     = name_;
+        Record(category, Phase::Begin, name);
+    }
+
+    /// Attached to the end event.
+    void SetArg(std::uint64_t arg_) { arg = arg_; }
+
+    private:
+    const char* name  = nullptr;
+    std::uint64_t arg = 0;
+    Category category = Category::Api;
+};
+
+} // namespace trace
+} // namespace miopen
+
+#define MIOPEN_TRACE_PP_CAT(x, y) MIOPEN_TRACE_PP_PRIMITIVE_CAT(x, y)
+#define MIOPEN_TRACE_PP_PRIMITIVE_CAT(x, y) x##y
+
+/// Traces the rest of the enclosing scope. The name is only evaluated while tracing is on.
+#define MIOPEN_TRACE_SCOPE(category, name)                             \
+    miopen::trace::Scope MIOPEN_TRACE_PP_CAT(miopen_trace_, __LINE__); \
+    if(miopen::trace::IsEnabled())                                     \
+        MIOPEN_TRACE_PP_CAT(miopen_trace_, __LINE__)                   \
+            .Begin(miopen::trace::Category::category, name)
+
+#define MIOPEN_TRACE_INSTANT(category, name, arg)                                             \
+    do                                                                                        \
+    {                                                                                         \
+        if(miopen::trace::IsEnabled())                                                        \
+            miopen::trace::Record(                                                            \
+                miopen::trace::Category::category, miopen::trace::Phase::Instant, name, arg); \
+    } while(false)
+
+#endif // GUARD_MIOPEN_TRACE_HPP
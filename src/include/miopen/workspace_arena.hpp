@@ -0,0 +1,57 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_WORKSPACE_ARENA_HPP
+#define GUARD_MIOPEN_WORKSPACE_ARENA_HPP
+
+#include <miopen/allocator.hpp>
+#include <miopen/conv_algo_name.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+
+namespace miopen {
+
+/// Scratch buffer owned by a Handle. Operations on a handle run one at a time, so they can
+/// all share one buffer that grows to the largest workspace requested and is then reused.
+struct WorkspaceArena
+{
+    bool enabled                    = false;
+    std::size_t peak                = 0;
+    std::size_t capacity            = 0;
+    Allocator::ManageDataPtr buffer = nullptr;
+    /// Workspace sizes of the convolution solutions served so far, by direction, solver id
+    /// and network config.
+    std::map<std::tuple<miopenConvDirection_t, std::uint64_t, std::string>, std::size_t>
+        solution_sizes;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WORKSPACE_ARENA_HPP
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <sstream>
+#include <utility>
 
 #include <boost/range/adaptor/transformed.hpp>
 
@@ -63,6 +64,48 @@ static std::string GenerateDefines(const std::vector<KernelBuildParameter>& opti
     return JoinStrings(strs, " ");
 }
 
+std::string CanonicalBuildOptions(const std::string& options)
+{
+    if(options.find_first_of("\"'\\") != std::string::npos)
+        return options;
+
+    std::vector<std::string> others;
+    std::vector<std::pair<std::string, std::string>> defines; // full name, token
+    std::istringstream ss(options);
+    std::string token;
+    while(ss >> token)
+    {
+        std::string value;
+        if(token == "-D" && ss >> value)
+            token += value;
+        if(StartsWith(token, "-U"))
+            return options;
+
+        std::string prefix;
+        if(StartsWith(token, "-D"))
+            prefix = "-D";
+        else if(StartsWith(token, "-Wa,-defsym,"))
+            prefix = "-Wa,-defsym,";
+
+        if(prefix.empty() || token.size() == prefix.size())
+            others.push_back(token);
+        else
+            defines.emplace_back(token.substr(0, token.find('=')), token);
+    }
+
+    auto sorted = defines;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+    const auto same_name = [](const auto& lhs, const auto& rhs) { return lhs.first == rhs.first; };
+    if(std::adjacent_find(sorted.begin(), sorted.end(), same_name) != sorted.end())
+        return options;
+
+    for(const auto& define : sorted)
+        others.push_back(define.second);
+    return JoinStrings(others, " ");
+}
+
 std::string kbp::OpenCL::Generate(const std::vector<KernelBuildParameter>& options)
 {
     // Ensure only one space after the -cl-std.
@@ -40,12 +40,16 @@
  * ************************************************************************ */
 
 #include <miopen/errors.hpp>
+#include <miopen/kernel_build_params.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/stringutils.hpp>
+#include <miopen/trace.hpp>
 
 #include <iostream>
 #include <iterator>
+#include <utility>
 
 namespace miopen {
 
@@ -112,36 +116,117 @@ static void AddKernelDumpKernelParams(const std::string& program_name,
                            << params);
 }
 
+KernelCache::Key::Key(boost::string_view algorithm_, boost::string_view network_config_)
+    : algorithm(algorithm_),
+      network_config(network_config_),
+      hash([&] {
+          // FNV-1a
+          std::uint64_t h   = 14695981039346656037ULL;
+          const auto append = [&](boost::string_view s) {
+              for(const auto c : s)
+                  h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+          };
+          append(algorithm);
+          h = (h ^ 0xffU) * 1099511628211ULL; // Separator, the byte never occurs in UTF-8.
+          append(network_config);
+          return h;
+      }())
+{
+}
+
+KernelCache::Key::Key(boost::string_view algorithm_, const NetworkConfig& network_config_)
+    : algorithm(algorithm_),
+      binary_config(&network_config_),
+      hash([&] {
+          // FNV-1a
+          std::uint64_t h = 14695981039346656037ULL;
+          for(const auto c : algorithm)
+              h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+          return (h ^ network_config_.GetHash()) * 1099511628211ULL;
+      }())
+{
+}
+
+std::string KernelCache::Key::GetNetworkConfig() const
+{
+    if(!network_config.empty())
+        return network_config.to_string();
+    return binary_config == nullptr ? std::string{} : binary_config->ToString();
+}
+
+KernelCache::Entry::Entry(const Key& key_)
+    : algorithm(key_.algorithm.to_string()),
+      network_config(key_.network_config.to_string()),
+      binary_config(key_.binary_config == nullptr ? NetworkConfig{} : *key_.binary_config),
+      key(key_)
+{
+    key.algorithm      = algorithm;
+    key.network_config = network_config;
+    if(key.binary_config != nullptr)
+        key.binary_config = &binary_config;
+}
+
+std::vector<Kernel>& KernelCache::GetOrAddKernels(Shard& shard, const Key& key)
+{
+    auto it = shard.kernel_map.find(key);
+    if(it == shard.kernel_map.end())
+    {
+        auto entry            = std::make_unique<Entry>(key);
+        const auto& entry_key = entry->key;
+        it                    = shard.kernel_map.emplace(entry_key, std::move(entry)).first;
+    }
+    return it->second->kernels;
+}
+
 const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
                                                    const std::string& network_config)
 {
+    return GetKernels(Key{algorithm, network_config});
+}
 
-    std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
+const std::vector<Kernel>& KernelCache::GetKernels(const Key& key)
+{
+    auto& shard = GetShard(key);
+    const std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
 
-    const auto it = kernel_map.find(key);
-    if(it != kernel_map.end())
+    // Entries are never moved or removed, so the reference outlives the lock.
+    const auto it = shard.kernel_map.find(key);
+    MIOPEN_TRACE_INSTANT(
+        KernelCache, "GetKernels", it != shard.kernel_map.end() ? it->second->kernels.size() : 0);
+    const auto found = it != shard.kernel_map.end() && !it->second->kernels.empty();
+    metrics::Add(found ? metrics::Counter::KernelCacheHits : metrics::Counter::KernelCacheMisses);
+    if(it != shard.kernel_map.end())
     {
-        MIOPEN_LOG_I2(it->second.size() << " kernels for key: " << key.first << " \"" << key.second
-                                        << '\"');
-        return it->second;
+        const auto& kernels = it->second->kernels;
+        MIOPEN_LOG_I2(kernels.size() << " kernels for key: " << key.algorithm << " \""
+                                     << key.GetNetworkConfig()
+                                     << '\"');
+        return kernels;
     }
 
     static const std::vector<Kernel> empty{};
-    MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
+    MIOPEN_LOG_I2("0 kernels for key: " << key.algorithm << " \"" << key.GetNetworkConfig() << '\"');
     return empty;
 }
 
 bool KernelCache::HasKernels(const std::string& algorithm, const std::string& network_config) const
 {
-    const auto key = std::make_pair(algorithm, network_config);
+    return HasKernels(Key{algorithm, network_config});
+}
+
+bool KernelCache::HasKernels(const Key& key) const
+{
 #ifndef NDEBUG
-    MIOPEN_LOG_I("Key: " << key.first << " \"" << key.second << '\"');
+    MIOPEN_LOG_I("Key: " << key.algorithm << " \"" << key.GetNetworkConfig() << '\"');
 #endif
-    const auto it = kernel_map.find(key);
-    if(it == kernel_map.end())
+    const auto& shard = GetShard(key);
+    const std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+    const auto it = shard.kernel_map.find(key);
+    MIOPEN_TRACE_INSTANT(KernelCache, "HasKernels", it != shard.kernel_map.end() ? 1 : 0);
+    if(it == shard.kernel_map.end())
         return false;
 
-    if(it->second.empty())
+    if(it->second->kernels.empty())
     {
         MIOPEN_THROW("There should be at least one kernel in kernel cache if an entry exists");
     }
@@ -161,6 +246,33 @@ Kernel KernelCache::AddKernel(Handle& h,
                               bool is_kernel_miopengemm_str,
                               const std::string& kernel_src)
 {
+    return AddKernel(h,
+                     Key{algorithm, network_config},
+                     program_name,
+                     kernel_name,
+                     vld,
+                     vgd,
+                     std::move(params),
+                     cache_index,
+                     is_kernel_miopengemm_str,
+                     kernel_src);
+}
+
+Kernel KernelCache::AddKernel(Handle& h,
+                              const Key& key,
+                              const std::string& program_name,
+                              const std::string& kernel_name,
+                              const std::vector<size_t>& vld,
+                              const std::vector<size_t>& vgd,
+                              std::string params,
+                              std::size_t cache_index,
+                              bool is_kernel_miopengemm_str,
+                              const std::string& kernel_src)
+{
+    trace::Scope scope;
+    if(trace::IsEnabled())
+        scope.Begin(trace::Category::KernelCache, "AddKernel");
+
     if(params.length() > 0)
     {
         // Ensure only one space after the -cl-std.
@@ -171,18 +283,25 @@ Kernel KernelCache::AddKernel(Handle& h,
         }
     }
 
-    const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
-        MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
+    const auto& algorithm = key.algorithm;
+    if(key.HasNetworkConfig() || !algorithm.empty()) // Don't log only _empty_ keys.
+        MIOPEN_LOG_I2("Key: " << key.algorithm << " \"" << key.GetNetworkConfig() << '\"');
 
     Program program;
+    auto found = false;
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
+    // The same set of options written differently should not produce another program, but the
+    // compiler still gets them as written.
+    const auto program_key = std::make_pair(program_name, CanonicalBuildOptions(params));
     {
-        program = program_it->second;
+        const std::lock_guard<std::mutex> lock(program_mutex);
+        const auto program_it = program_map.find(program_key);
+        found                 = program_it != program_map.end();
+        if(found)
+            program = program_it->second;
     }
-    else
+    scope.SetArg(found ? 1 : 0);
+    if(!found)
     {
         if(!is_kernel_miopengemm_str) // default value
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
@@ -199,20 +318,24 @@ Kernel KernelCache::AddKernel(Handle& h,
                                       vgd,
                                       params);
         }
+        // The program is loaded without the lock, another thread may have added it meanwhile.
         program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+        const std::lock_guard<std::mutex> lock(program_mutex);
+        program = program_map.emplace(program_key, program).first->second;
     }
     Kernel kernel{program, kernel_name, vld, vgd};
-    if(!network_config.empty() && !algorithm.empty())
+    if(key.HasNetworkConfig() && !algorithm.empty())
     {
         this->AddKernel(key, kernel, cache_index);
     }
     return kernel;
 }
 
-void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
+void KernelCache::AddKernel(const Key& key, Kernel k, std::size_t cache_index)
 {
-    auto&& v = kernel_map[key];
+    auto& shard = GetShard(key);
+    const std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+    auto& v = GetOrAddKernels(shard, key);
     if(cache_index >= v.size())
     {
         v.resize(cache_index + 1);
@@ -222,15 +345,23 @@ void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
 
 void KernelCache::ClearKernels(const std::string& algorithm, const std::string& network_config)
 {
-    if(network_config.empty() || algorithm.empty())
+    ClearKernels(Key{algorithm, network_config});
+}
+
+void KernelCache::ClearKernels(const Key& key)
+{
+    if(!key.HasNetworkConfig() || key.algorithm.empty())
     {
         MIOPEN_THROW("Network config or algorithm empty.");
     }
-    const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v = this->kernel_map[key];
+    auto& shard = GetShard(key);
+    const std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+    auto& v = GetOrAddKernels(shard, key);
     if(!v.empty())
     {
-        MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.algorithm << " \""
+                               << key.GetNetworkConfig()
+                               << '\"');
     }
     v.clear();
 }
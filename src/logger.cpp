@@ -27,13 +27,20 @@
 #include <miopen/logger.hpp>
 #include <miopen/config.h>
 
+#include <atomic>
+#include <cerrno>
 #include <cstdlib>
 #include <chrono>
+#include <condition_variable>
+#include <csignal>
 #include <ios>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
 
-#ifdef __linux__
 #include <unistd.h>
+#ifdef __linux__
 #include <sys/syscall.h> /* For SYS_xxx definitions */
 #endif
 
@@ -60,6 +67,13 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME)
 /// See LoggingLevel in the header.
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_LOG_LEVEL)
 
+/// Write log records from a background thread instead of the logging one.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_LOG_ASYNC)
+
+/// Number of records the asynchronous sink holds, rounded up to a power of two.
+/// Records logged while it is full are dropped and counted.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_LOG_ASYNC_RECORDS)
+
 namespace debug {
 
 bool LoggingQuiet = false;
@@ -110,6 +124,259 @@ inline float GetTimeDiff()
     return rv;
 }
 
+const std::size_t default_async_records = 8192;
+const std::size_t max_batch             = 64 * 1024;
+
+/// Bounded multi-producer queue of formatted records (D. Vyukov's design). Producers only
+/// take a slot with a compare and swap, the background thread writes the records out.
+/// Anything else which drains the queue, such as Flush, serializes with it on a mutex.
+/// Once stopped, the writer is gone and records are no longer accepted.
+class AsyncSink
+{
+    public:
+    explicit AsyncSink(std::size_t capacity)
+        : cells(new Cell[capacity]), mask(capacity - 1)
+    {
+        for(std::size_t i = 0; i < capacity; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        writer = std::thread([this] { Run(); });
+    }
+
+    AsyncSink(const AsyncSink&) = delete;
+    AsyncSink& operator=(const AsyncSink&) = delete;
+
+    ~AsyncSink() { Stop(); }
+
+    void Stop()
+    {
+        if(stop.exchange(true))
+            return;
+        wakeup.notify_one();
+        writer.join();
+        Flush();
+    }
+
+    /// Returns false if the sink is stopped and the record was not taken.
+    bool Push(std::string& record)
+    {
+        if(stop.load(std::memory_order_relaxed))
+            return false;
+        auto pos = enqueue_pos.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            auto& cell     = cells[pos & mask];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            if(seq == pos)
+            {
+                if(enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.record = std::move(record);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    ++pos;
+                    break;
+                }
+            }
+            else if(seq < pos + 1)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            else
+            {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        // The writer wakes up by itself to write a few records, it is only woken up early
+        // when the queue fills, and then only once.
+        if(IsHalfFull(pos) && waiting.load(std::memory_order_relaxed) && waiting.exchange(false))
+            wakeup.notify_one();
+        return true;
+    }
+
+    void Flush()
+    {
+        const std::lock_guard<std::mutex> lock(drain_mutex);
+        // Only FlushFromSignal sets it without the lock, and it never waits for anything.
+        while(draining.exchange(true, std::memory_order_acquire))
+            std::this_thread::yield();
+        Drain();
+        draining.store(false, std::memory_order_release);
+    }
+
+    /// Writes the queued records from a signal handler, so only does async-signal-safe things:
+    /// no locks, allocations or streams. Gives up if the records are being written already,
+    /// as that may be the interrupted thread.
+    void FlushFromSignal()
+    {
+        if(draining.exchange(true, std::memory_order_acquire))
+            return;
+        auto pos = dequeue_pos.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            auto& cell = cells[pos & mask];
+            if(cell.sequence.load(std::memory_order_acquire) != pos + 1)
+                break;
+            WriteFromSignal(cell.record.data(), cell.record.size());
+            ++pos;
+        }
+        // The records are not released, as that would free their memory.
+        if(GetDropped() != reported_dropped)
+            WriteFromSignal(dropped_on_abort, sizeof(dropped_on_abort) - 1);
+        draining.store(false, std::memory_order_release);
+    }
+
+    std::size_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0};
+        std::string record;
+    };
+
+    bool IsHalfFull(std::size_t pushed) const
+    {
+        return pushed - dequeue_pos.load(std::memory_order_relaxed) > mask / 2;
+    }
+
+    void Drain()
+    {
+        // Records are written in batches, std::cerr is unbuffered.
+        auto pos = dequeue_pos.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            auto& cell = cells[pos & mask];
+            if(cell.sequence.load(std::memory_order_acquire) != pos + 1)
+                break;
+            batch += cell.record;
+            cell.record.clear();
+            cell.sequence.store(pos + mask + 1, std::memory_order_release);
+            ++pos;
+            if(batch.size() >= max_batch)
+                Write();
+        }
+        dequeue_pos.store(pos, std::memory_order_relaxed);
+
+        const auto now_dropped = GetDropped();
+        if(now_dropped != reported_dropped)
+        {
+            batch += LoggingPrefix() + "Warning [AsyncSink] " +
+                     std::to_string(now_dropped - reported_dropped) +
+                     " log records dropped, the queue was full\n";
+            reported_dropped = now_dropped;
+        }
+        Write();
+    }
+
+    static void WriteFromSignal(const char* data, std::size_t size)
+    {
+        while(size > 0)
+        {
+            const auto written = ::write(2, data, size);
+            if(written < 0 && errno == EINTR)
+                continue;
+            if(written <= 0)
+                return;
+            data += written;
+            size -= written;
+        }
+    }
+
+    static constexpr const char dropped_on_abort[] =
+        "MIOpen: Warning [AsyncSink] log records were dropped, the queue was full\n";
+
+    void Write()
+    {
+        if(batch.empty())
+            return;
+        std::cerr.write(batch.data(), batch.size());
+        std::cerr.flush();
+        batch.clear();
+    }
+
+    void Run()
+    {
+        while(!stop.load())
+        {
+            Flush();
+            // Waking up periodically bounds how long a record stays in the queue, also when
+            // a producer misses that the writer is about to wait.
+            std::unique_lock<std::mutex> lock(wakeup_mutex);
+            waiting.store(true, std::memory_order_relaxed);
+            wakeup.wait_for(lock, std::chrono::milliseconds(10), [this] {
+                return stop.load() || IsHalfFull(enqueue_pos.load(std::memory_order_relaxed));
+            });
+            waiting.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    std::unique_ptr<Cell[]> cells;
+    const std::size_t mask;
+    std::atomic<std::size_t> enqueue_pos{0};
+    std::atomic<std::size_t> dequeue_pos{0};
+    std::atomic<std::size_t> dropped{0};
+    std::size_t reported_dropped = 0;
+    std::string batch;
+    std::mutex drain_mutex;
+    std::mutex wakeup_mutex;
+    std::condition_variable wakeup;
+    std::atomic<bool> draining{false};
+    std::atomic<bool> waiting{false};
+    std::atomic<bool> stop{false};
+    std::thread writer;
+};
+
+std::atomic<bool>& GetAsyncEnabled()
+{
+    static std::atomic<bool> enabled{miopen::IsEnabled(MIOPEN_LOG_ASYNC{})};
+    return enabled;
+}
+
+constexpr const char AsyncSink::dropped_on_abort[];
+
+/// Never destroyed, as threads may still log while the process exits.
+std::atomic<AsyncSink*> async_sink{nullptr};
+
+using SignalHandler = void (*)(int);
+SignalHandler previous_abort_handler = SIG_DFL;
+
+/// Records queued before an abort would otherwise be lost.
+void FlushOnAbort(int signal)
+{
+    const auto sink = async_sink.load();
+    if(sink != nullptr)
+        sink->FlushFromSignal();
+    std::signal(signal, previous_abort_handler);
+    std::raise(signal);
+}
+
+/// Writes out what is queued at exit. Logging continues synchronously after that.
+void StopAsyncSink()
+{
+    GetAsyncEnabled().store(false);
+    const auto sink = async_sink.load();
+    if(sink != nullptr)
+        sink->Stop();
+}
+
+void CreateAsyncSink()
+{
+    static const auto created = [] {
+        const auto requested = miopen::Value(MIOPEN_LOG_ASYNC_RECORDS{});
+        const auto records   = requested == 0 ? default_async_records : requested;
+        std::size_t capacity = 2;
+        while(capacity < records)
+            capacity <<= 1;
+        async_sink.store(new AsyncSink(capacity)); // NOLINT
+        const auto previous = std::signal(SIGABRT, FlushOnAbort);
+        if(previous != SIG_ERR)
+            previous_abort_handler = previous;
+        std::atexit(StopAsyncSink);
+        return true;
+    }();
+    (void)created;
+}
+
 } // namespace
 
 bool IsLoggingDebugQuiet()
@@ -180,6 +447,8 @@ std::string LoggingPrefix()
     ss << "(OpenCL)";
 #elif MIOPEN_BACKEND_HIP
     ss << "(HIP)";
+#elif MIOPEN_BACKEND_MOCK
+    ss << "(Mock)";
 #endif
     if(miopen::IsEnabled(MIOPEN_ENABLE_LOGGING_ELAPSED_TIME{}))
     {
@@ -189,6 +458,58 @@ std::string LoggingPrefix()
     return ss.str();
 }
 
+bool IsLoggingAsync() { return GetAsyncEnabled().load(std::memory_order_relaxed); }
+
+void SetLoggingAsync(bool enable)
+{
+    if(enable)
+    {
+        CreateAsyncSink();
+        GetAsyncEnabled().store(true);
+    }
+    else if(GetAsyncEnabled().exchange(false))
+    {
+        LoggingFlush();
+    }
+}
+
+void LoggingFlush()
+{
+    const auto sink = async_sink.load();
+    if(sink != nullptr)
+        sink->Flush();
+}
+
+std::size_t LoggingDroppedRecords()
+{
+    const auto sink = async_sink.load();
+    return sink == nullptr ? 0 : sink->GetDropped();
+}
+
+void LogWrite(std::string record)
+{
+    if(IsLoggingAsync())
+    {
+        CreateAsyncSink();
+        const auto sink = async_sink.load();
+        if(sink != nullptr && sink->Push(record))
+            return;
+    }
+    std::cerr << record;
+}
+
+namespace logger {
+
+std::ostringstream& GetFunctionStream()
+{
+    thread_local std::ostringstream ss;
+    ss.str({});
+    ss.clear();
+    return ss;
+}
+
+} // namespace logger
+
 /// Expected to be invoked with __func__ and __PRETTY_FUNCTION__.
 std::string LoggingParseFunction(const char* func, const char* pretty_func)
 {
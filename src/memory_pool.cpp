@@ -0,0 +1,229 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/memory_pool.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_MEMORY_POOL_LIMIT)
+
+namespace miopen {
+
+std::shared_ptr<MemoryPool> CreateMemoryPoolFromEnv()
+{
+    const auto limit = Value(MIOPEN_DEVICE_MEMORY_POOL_LIMIT{});
+    if(limit == 0)
+        return nullptr;
+    return std::make_shared<MemoryPool>(limit);
+}
+
+void ReleaseToPool(MemoryPool& pool, void* ptr) { pool.Release(ptr); }
+
+void Handle::SetMemoryPoolLimit(std::size_t limit)
+{
+    if(limit == 0)
+    {
+        this->TrimMemoryPool();
+        this->memory_pool = nullptr;
+    }
+    else if(this->memory_pool == nullptr)
+        this->memory_pool = std::make_shared<MemoryPool>(limit);
+    else
+        this->memory_pool->SetLimit(limit);
+}
+
+std::size_t Handle::GetMemoryPoolLimit() const
+{
+    return this->memory_pool == nullptr ? 0 : this->memory_pool->GetLimit();
+}
+
+void Handle::TrimMemoryPool() const
+{
+    if(this->memory_pool != nullptr)
+        this->memory_pool->Trim();
+}
+
+MemoryPool::MemoryPool(std::size_t limit_) : limit(limit_) {}
+
+MemoryPool::~MemoryPool() { Trim(); }
+
+std::size_t MemoryPool::SizeClass(std::size_t n)
+{
+    // Four classes per power of two keep the rounding overhead under 25%.
+    const std::size_t min_size = 512;
+    if(n <= min_size)
+        return min_size;
+    if(n > std::numeric_limits<std::size_t>::max() / 2)
+        return n;
+
+    std::size_t power = min_size;
+    while(power * 2 <= n)
+        power *= 2;
+    const auto step = power / 4;
+    return (n + step - 1) / step * step;
+}
+
+static Allocator::ManageDataPtr TryAllocate(const Allocator& upstream, std::size_t n)
+{
+    try
+    {
+        return upstream(n);
+    }
+    catch(const Exception&)
+    {
+        return nullptr;
+    }
+}
+
+Allocator::ManageDataPtr
+MemoryPool::Allocate(const Allocator& upstream, std::size_t n, const void* stream)
+{
+    if(n == 0)
+        return upstream(n);
+
+    const auto size = SizeClass(n);
+    auto block      = Block{nullptr, size, stream, upstream.deallocator, upstream.context};
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto bin = cached.find(size);
+        if(bin != cached.end())
+        {
+            auto& blocks    = bin->second;
+            const auto last = std::find_if(blocks.rbegin(), blocks.rend(), [&](const Block& b) {
+                return b.stream == stream && b.deallocator == upstream.deallocator &&
+                       b.context == upstream.context;
+            });
+            if(last != blocks.rend())
+            {
+                block.ptr = last->ptr;
+                blocks.erase(std::next(last).base());
+                cached_bytes -= size;
+            }
+        }
+    }
+
+    if(block.ptr == nullptr)
+    {
+        auto buffer = TryAllocate(upstream, size);
+        if(buffer == nullptr && GetCachedBytes() != 0)
+        {
+            MIOPEN_LOG_I2("Allocation of " << size << " bytes failed, trimming the memory pool");
+            Trim();
+            buffer = TryAllocate(upstream, size);
+        }
+        if(buffer == nullptr)
+            buffer = upstream(size);
+        block.ptr = buffer.release();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        in_use.emplace(block.ptr, block);
+    }
+    return Allocator::ManageDataPtr{DataCast(block.ptr),
+                                    AllocatorDeleter{nullptr, nullptr, shared_from_this()}};
+}
+
+void MemoryPool::Release(void* ptr)
+{
+    Block block{};
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = in_use.find(ptr);
+        if(it == in_use.end())
+        {
+            MIOPEN_LOG_E("Buffer " << ptr << " was not allocated by the memory pool");
+            return;
+        }
+        block = it->second;
+        in_use.erase(it);
+
+        if(cached_bytes + block.size <= limit)
+        {
+            cached[block.size].push_back(block);
+            cached_bytes += block.size;
+            return;
+        }
+    }
+
+    block.deallocator(block.context, block.ptr);
+}
+
+void MemoryPool::Free(const std::vector<Block>& blocks)
+{
+    for(const auto& block : blocks)
+        block.deallocator(block.context, block.ptr);
+}
+
+void MemoryPool::Trim()
+{
+    std::vector<Block> blocks;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(auto& bin : cached)
+            blocks.insert(blocks.end(), bin.second.begin(), bin.second.end());
+        cached.clear();
+        cached_bytes = 0;
+    }
+
+    Free(blocks);
+}
+
+void MemoryPool::SetLimit(std::size_t limit_)
+{
+    bool trim;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        limit = limit_;
+        trim  = cached_bytes > limit;
+    }
+
+    if(trim)
+        Trim();
+}
+
+std::size_t MemoryPool::GetLimit() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return limit;
+}
+
+std::size_t MemoryPool::GetCachedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return cached_bytes;
+}
+
+} // namespace miopen
@@ -0,0 +1,230 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/metrics.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace miopen {
+namespace metrics {
+
+/// The metrics snapshot is written to this file at exit.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_METRICS_FILE)
+
+namespace {
+
+const std::size_t counter_count   = static_cast<std::size_t>(Counter::Count);
+const std::size_t histogram_count = static_cast<std::size_t>(Histogram::Count);
+const std::size_t bucket_count    = 10;
+
+const std::array<double, bucket_count - 1>& GetBucketBounds()
+{
+    static const std::array<double, bucket_count - 1> bounds = {
+        {1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2}};
+    return bounds;
+}
+
+struct HistogramData
+{
+    std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+    std::atomic<std::uint64_t> count{0};
+    /// Kept in nanoseconds to be updated atomically.
+    std::atomic<std::uint64_t> sum{0};
+};
+
+struct Registry
+{
+    std::array<std::atomic<std::uint64_t>, counter_count> counters{};
+    std::array<HistogramData, histogram_count> histograms;
+    std::mutex solvers_mutex;
+    /// Counters are never removed, references to them stay valid.
+    std::map<std::string, std::unique_ptr<std::atomic<std::uint64_t>>> solvers;
+};
+
+Registry& GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+const char* GetName(Counter counter)
+{
+    switch(counter)
+    {
+    case Counter::FindDbHits: return "find_db_hits";
+    case Counter::FindDbMisses: return "find_db_misses";
+    case Counter::PerfDbHits: return "perf_db_hits";
+    case Counter::PerfDbMisses: return "perf_db_misses";
+    case Counter::KernelCacheHits: return "kernel_cache_hits";
+    case Counter::KernelCacheMisses: return "kernel_cache_misses";
+    case Counter::BinaryCacheHits: return "binary_cache_hits";
+    case Counter::BinaryCacheMisses: return "binary_cache_misses";
+    case Counter::Count: break;
+    }
+    return "unknown";
+}
+
+const char* GetName(Histogram histogram)
+{
+    switch(histogram)
+    {
+    case Histogram::FindDbLookupSeconds: return "find_db_lookup_seconds";
+    case Histogram::PerfDbLookupSeconds: return "perf_db_lookup_seconds";
+    case Histogram::LockWaitSeconds: return "lock_wait_seconds";
+    case Histogram::CompileSeconds: return "compile_seconds";
+    case Histogram::Count: break;
+    }
+    return "unknown";
+}
+
+struct ExitDumper
+{
+    ExitDumper()
+    {
+        // Constructing the registry first keeps it alive until the snapshot is written.
+        GetRegistry();
+    }
+
+    ~ExitDumper()
+    {
+        const auto path = GetStringEnv(MIOPEN_METRICS_FILE{});
+        if(path == nullptr)
+            return;
+        std::ofstream file(path);
+        if(!file)
+        {
+            MIOPEN_LOG_E("Failed to write metrics to " << path);
+            return;
+        }
+        file << Snapshot();
+    }
+};
+
+const ExitDumper exit_dumper;
+
+} // namespace
+
+void Add(Counter counter, std::uint64_t value)
+{
+    GetRegistry().counters[static_cast<std::size_t>(counter)].fetch_add(
+        value, std::memory_order_relaxed);
+}
+
+void Observe(Histogram histogram, double seconds)
+{
+    const auto& bounds = GetBucketBounds();
+    const auto bucket =
+        std::lower_bound(bounds.begin(), bounds.end(), seconds) - bounds.begin();
+    auto& data = GetRegistry().histograms[static_cast<std::size_t>(histogram)];
+    data.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    data.count.fetch_add(1, std::memory_order_relaxed);
+    data.sum.fetch_add(static_cast<std::uint64_t>(std::max(seconds, 0.0) * 1e9),
+                       std::memory_order_relaxed);
+}
+
+std::atomic<std::uint64_t>& GetSolverCounter(const std::string& solver)
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.solvers_mutex);
+    auto& counter = registry.solvers[solver];
+    if(counter == nullptr)
+        counter.reset(new std::atomic<std::uint64_t>{0});
+    return *counter;
+}
+
+/// Counters are read one by one, a snapshot taken while they are updated is not consistent
+/// between them.
+std::string Snapshot()
+{
+    auto& registry = GetRegistry();
+    std::ostringstream ss;
+    ss << "{\n\"counters\":{";
+    for(std::size_t i = 0; i < counter_count; ++i)
+    {
+        ss << (i == 0 ? "\n" : ",\n") << '"' << GetName(static_cast<Counter>(i))
+           << "\":" << registry.counters[i].load(std::memory_order_relaxed);
+    }
+
+    ss << "\n},\n\"histograms\":{";
+    for(std::size_t i = 0; i < histogram_count; ++i)
+    {
+        const auto& data = registry.histograms[i];
+        ss << (i == 0 ? "\n" : ",\n") << '"' << GetName(static_cast<Histogram>(i))
+           << "\":{\"count\":" << data.count.load(std::memory_order_relaxed)
+           << ",\"sum\":" << data.sum.load(std::memory_order_relaxed) * 1e-9 << ",\"buckets\":[";
+        for(std::size_t b = 0; b < bucket_count; ++b)
+        {
+            ss << (b == 0 ? "" : ",") << "{\"le\":";
+            if(b < GetBucketBounds().size())
+                ss << GetBucketBounds()[b];
+            else
+                ss << "\"+Inf\"";
+            ss << ",\"count\":" << data.buckets[b].load(std::memory_order_relaxed) << '}';
+        }
+        ss << "]}";
+    }
+
+    ss << "\n},\n\"solvers\":{";
+    {
+        const std::lock_guard<std::mutex> lock(registry.solvers_mutex);
+        auto first = true;
+        for(const auto& solver : registry.solvers)
+        {
+            ss << (first ? "\n" : ",\n") << '"' << solver.first
+               << "\":" << solver.second->load(std::memory_order_relaxed);
+            first = false;
+        }
+    }
+    ss << "\n}\n}\n";
+    return ss.str();
+}
+
+void Reset()
+{
+    auto& registry = GetRegistry();
+    for(auto& counter : registry.counters)
+        counter.store(0, std::memory_order_relaxed);
+    for(auto& data : registry.histograms)
+    {
+        for(auto& bucket : data.buckets)
+            bucket.store(0, std::memory_order_relaxed);
+        data.count.store(0, std::memory_order_relaxed);
+        data.sum.store(0, std::memory_order_relaxed);
+    }
+    const std::lock_guard<std::mutex> lock(registry.solvers_mutex);
+    for(auto& solver : registry.solvers)
+        solver.second->store(0, std::memory_order_relaxed);
+}
+
+} // namespace metrics
+} // namespace miopen
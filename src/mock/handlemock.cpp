@@ -0,0 +1,380 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/device_name.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/memory_pool.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MOCK_DEVICE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_MOCK_COMPUTE_UNITS)
+
+namespace miopen {
+
+namespace {
+
+/// Mirrors the properties solvers query, defaults to a 60 CU gfx906.
+const std::size_t mock_global_memory = std::size_t{16} << 30;
+const std::size_t mock_local_memory  = 65536;
+const std::size_t mock_wavefront     = 64;
+
+struct MockMemory
+{
+    std::mutex mutex;
+    std::unordered_map<void*, std::size_t> sizes;
+    std::size_t allocated = 0;
+    std::size_t peak      = 0;
+};
+
+MockMemory& GetMockMemory()
+{
+    static MockMemory memory;
+    return memory;
+}
+
+void* default_allocator(void*, size_t sz)
+{
+    auto& memory = GetMockMemory();
+    std::lock_guard<std::mutex> lock(memory.mutex);
+    if(sz > mock_global_memory - memory.allocated)
+        MIOPEN_THROW("Memory not available to allocate buffer: " + std::to_string(sz));
+    // Never returns null, zero sized buffers are valid handles.
+    auto result = std::malloc(std::max<std::size_t>(sz, 1));
+    if(result == nullptr)
+        MIOPEN_THROW(miopenStatusAllocFailed, "Host error creating buffer " + std::to_string(sz));
+    memory.sizes[result] = sz;
+    memory.allocated += sz;
+    memory.peak = std::max(memory.peak, memory.allocated);
+    return result;
+}
+
+void default_deallocator(void*, void* mem) { MockFree(mem); }
+
+} // namespace
+
+void MockFree(void* mem)
+{
+    if(mem == nullptr)
+        return;
+    auto& memory = GetMockMemory();
+    std::lock_guard<std::mutex> lock(memory.mutex);
+    const auto it = memory.sizes.find(mem);
+    if(it == memory.sizes.end())
+    {
+        // Called from deleters, which must not throw.
+        MIOPEN_LOG_E("Freeing a buffer not allocated by the mock device: " << mem);
+        return;
+    }
+    memory.allocated -= it->second;
+    memory.sizes.erase(it);
+    std::free(mem);
+}
+
+std::size_t MockAllocatedBytes()
+{
+    auto& memory = GetMockMemory();
+    std::lock_guard<std::mutex> lock(memory.mutex);
+    return memory.allocated;
+}
+
+std::size_t MockPeakAllocatedBytes()
+{
+    auto& memory = GetMockMemory();
+    std::lock_guard<std::mutex> lock(memory.mutex);
+    return memory.peak;
+}
+
+struct HandleImpl
+{
+    void elapsed_time(float time)
+    {
+        if(enable_profiling)
+            this->profiling_result = time;
+    }
+
+    std::function<void(float)> elapsed_time_handler()
+    {
+        return [this](float time) { this->elapsed_time(time); };
+    }
+
+    bool enable_profiling           = false;
+    miopenAcceleratorQueue_t stream = nullptr;
+    float profiling_result          = 0.0;
+    Allocator allocator{};
+    KernelCache cache;
+    MockLaunchLog launches;
+};
+
+Handle::Handle(miopenAcceleratorQueue_t stream) : impl(new HandleImpl())
+{
+    this->impl->stream = stream;
+    this->SetAllocator(nullptr, nullptr, nullptr);
+    MIOPEN_LOG_NQI(*this);
+}
+
+Handle::Handle() : impl(new HandleImpl())
+{
+    this->SetAllocator(nullptr, nullptr, nullptr);
+    MIOPEN_LOG_NQI(*this);
+}
+
+Handle::~Handle() {}
+
+void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
+{
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        MIOPEN_THROW("Stream can not be changed while the stream pool is forked");
+    this->impl->stream = streamID;
+}
+
+miopenAcceleratorQueue_t Handle::GetStream() const
+{
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        return stream_pool->GetActive();
+    return impl->stream;
+}
+
+StreamPool::Backend Handle::GetStreamPoolBackend()
+{
+    using Stream = StreamPool::Stream;
+    // Mock streams only need distinct addresses.
+    auto launches = &this->impl->launches;
+    StreamPool::Backend backend;
+    backend.create  = [] { return static_cast<Stream>(new char{}); };
+    backend.destroy = [](Stream stream) { delete static_cast<char*>(stream); };
+    backend.wait    = [launches](Stream waiting, Stream signaling) {
+        if(launches->keep)
+            launches->waits.push_back({waiting, signaling, launches->launches.size()});
+    };
+    return backend;
+}
+
+void Handle::SetAllocator(miopenAllocatorFunction allocator,
+                          miopenDeallocatorFunction deallocator,
+                          void* allocatorContext) const
+{
+    // Cached buffers must go back to the allocator that created them.
+    this->TrimMemoryPool();
+    this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
+    this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
+
+    this->impl->allocator.context = allocatorContext;
+}
+
+void Handle::EnableProfiling(bool enable) { this->impl->enable_profiling = enable; }
+
+float Handle::GetKernelTime() const { return this->impl->profiling_result; }
+
+Allocator::ManageDataPtr Handle::Create(std::size_t sz)
+{
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Allocations can not be captured");
+    if(this->memory_pool != nullptr)
+        return this->memory_pool->Allocate(this->impl->allocator, sz, this->GetStream());
+    return this->impl->allocator(sz);
+}
+
+Allocator::ManageDataPtr&
+Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz)
+{
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Memory transfers can not be captured");
+    std::memcpy(ddata.get(), data, sz);
+    return ddata;
+}
+
+void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz)
+{
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Memory transfers can not be captured");
+    std::memcpy(data, ddata.get(), sz);
+}
+
+void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size)
+{
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Memory transfers can not be captured");
+    std::memmove(dest, src, size);
+}
+
+KernelInvoke Handle::AddKernel(const std::string& algorithm,
+                               const std::string& network_config,
+                               const std::string& program_name,
+                               const std::string& kernel_name,
+                               const std::vector<size_t>& vld,
+                               const std::vector<size_t>& vgd,
+                               const std::string& params,
+                               std::size_t cache_index,
+                               bool is_kernel_str,
+                               const std::string& kernel_src)
+{
+
+    auto obj = this->impl->cache.AddKernel(*this,
+                                           algorithm,
+                                           network_config,
+                                           program_name,
+                                           kernel_name,
+                                           vld,
+                                           vgd,
+                                           params,
+                                           cache_index,
+                                           is_kernel_str,
+                                           kernel_src);
+    return this->Run(obj);
+}
+
+KernelInvoke Handle::AddKernel(const std::string& algorithm,
+                               const NetworkConfig& network_config,
+                               const std::string& program_name,
+                               const std::string& kernel_name,
+                               const std::vector<size_t>& vld,
+                               const std::vector<size_t>& vgd,
+                               const std::string& params,
+                               std::size_t cache_index)
+{
+    auto obj = this->impl->cache.AddKernel(*this,
+                                           KernelCache::Key{algorithm, network_config},
+                                           program_name,
+                                           kernel_name,
+                                           vld,
+                                           vgd,
+                                           params,
+                                           cache_index);
+    return this->Run(obj);
+}
+
+void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config)
+{
+    this->impl->cache.ClearKernels(algorithm, network_config);
+}
+
+const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
+                                                  const std::string& network_config)
+{
+    return this->impl->cache.GetKernels(algorithm, network_config);
+}
+
+const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
+                                                  const NetworkConfig& network_config)
+{
+    return this->impl->cache.GetKernels(KernelCache::Key{algorithm, network_config});
+}
+
+bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
+{
+    return this->impl->cache.HasKernels(algorithm, network_config);
+}
+
+bool Handle::HasKernel(const std::string& algorithm, const NetworkConfig& network_config) const
+{
+    return this->impl->cache.HasKernels(KernelCache::Key{algorithm, network_config});
+}
+
+KernelInvoke Handle::Run(Kernel k)
+{
+    auto invoke = this->impl->enable_profiling
+                      ? k.Invoke(this->GetStream(),
+                                 &this->impl->launches,
+                                 this->impl->elapsed_time_handler())
+                      : k.Invoke(this->GetStream(), &this->impl->launches);
+    invoke.capture = this->capture_plan.get();
+    return invoke;
+}
+
+Program Handle::LoadProgram(const std::string& program_name,
+                            std::string params,
+                            bool is_kernel_str,
+                            const std::string& kernel_src)
+{
+    params += " -mcpu=" + this->GetDeviceName();
+    return MockProgram{program_name, params, is_kernel_str, kernel_src};
+}
+
+MockLaunchLog& Handle::GetMockLaunches() { return this->impl->launches; }
+
+void Handle::Finish() const {}
+void Handle::Flush() const {}
+
+bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
+
+void Handle::ResetKernelTime() { this->impl->profiling_result = 0.0; }
+void Handle::AccumKernelTime(float curr_time) { this->impl->profiling_result += curr_time; }
+
+std::size_t Handle::GetLocalMemorySize() { return mock_local_memory; }
+
+std::size_t Handle::GetGlobalMemorySize() { return mock_global_memory; }
+
+std::size_t Handle::GetMaxComputeUnits()
+{
+    const auto result = Value(MIOPEN_MOCK_COMPUTE_UNITS{});
+    return result == 0 ? 60 : result;
+}
+
+std::size_t Handle::GetImage3dMaxWidth() { return 2147483647; }
+
+std::size_t Handle::GetWavefrontWidth() { return mock_wavefront; }
+
+std::size_t Handle::GetMaxMemoryAllocSize()
+{
+    if(m_MaxMemoryAllocSizeCached == 0)
+        m_MaxMemoryAllocSizeCached = floor(mock_global_memory * 0.85);
+    return m_MaxMemoryAllocSizeCached;
+}
+
+std::string Handle::GetDeviceName()
+{
+    const char* const name = GetStringEnv(MIOPEN_MOCK_DEVICE{});
+    return GetDeviceNameFromMap(name == nullptr ? "gfx906" : name);
+}
+
+std::ostream& Handle::Print(std::ostream& os) const
+{
+    os << "stream: " << this->impl->stream << ", device_id: mock";
+    return os;
+}
+
+shared<Data_t> Handle::CreateSubBuffer(Data_t data, std::size_t offset, std::size_t)
+{
+    auto cdata = reinterpret_cast<char*>(data);
+    return {cdata + offset, null_deleter{}};
+}
+
+shared<ConstData_t> Handle::CreateSubBuffer(ConstData_t data, std::size_t offset, std::size_t)
+{
+    auto cdata = reinterpret_cast<const char*>(data);
+    return {cdata + offset, null_deleter{}};
+}
+
+} // namespace miopen
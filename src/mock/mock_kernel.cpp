@@ -0,0 +1,78 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/mock_kernel.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle_lock.hpp>
+#include <miopen/kernel.hpp>
+#include <miopen/trace.hpp>
+
+namespace miopen {
+
+MockProgram::MockProgram(const std::string& program_name,
+                         std::string program_params,
+                         bool is_kernel_str,
+                         const std::string& kernel_src)
+    : name(program_name), params(std::move(program_params))
+{
+    // Kernel strings come either in kernel_src or, from miopengemm, in the program name.
+    const auto source = !kernel_src.empty() ? boost::string_view{kernel_src}
+                                            : is_kernel_str ? boost::string_view{program_name}
+                                                            : GetKernelSrc(program_name);
+    if(source.empty())
+        MIOPEN_THROW("Kernel source not found: " + program_name);
+}
+
+void MockKernelInvoke::run(void* args, std::size_t size) const
+{
+    MIOPEN_TRACE_SCOPE(Launch, trace::Intern(name));
+    MIOPEN_HANDLE_LOCK
+    if(log != nullptr)
+    {
+        ++log->count;
+        if(log->keep)
+        {
+            const auto bytes = static_cast<const char*>(args);
+            log->launches.push_back({stream, name, ldims, gdims, {bytes, bytes + size}});
+        }
+    }
+    if(callback)
+        callback(0.0f);
+}
+
+ExecutionPlan::Launcher MockKernelInvoke::MakeLauncher() const
+{
+    auto invoke    = *this;
+    invoke.capture = nullptr;
+    return [invoke](void* args, std::size_t size) { invoke.run(args, size); };
+}
+
+MockKernelInvoke
+MockKernel::Invoke(void* stream, MockLaunchLog* log, std::function<void(float)> callback)
+{
+    return MockKernelInvoke{stream, log, ldims, gdims, name, callback};
+}
+
+} // namespace miopen
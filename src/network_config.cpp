@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/network_config.hpp>
+
+namespace miopen {
+
+std::string NetworkConfig::ToString() const
+{
+    std::string s = name;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        if(i != 0 || !s.empty())
+            s += i == 0 ? '-' : 'x';
+        if(kinds[i] == Kind::Float)
+        {
+            float x;
+            const auto bits = static_cast<std::uint32_t>(fields[i]);
+            std::memcpy(&x, &bits, sizeof(x));
+            s += std::to_string(x);
+        }
+        else
+        {
+            s += std::to_string(static_cast<std::int64_t>(fields[i]));
+        }
+    }
+    return s;
+}
+
+} // namespace miopen
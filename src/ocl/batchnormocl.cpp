@@ -204,16 +204,10 @@ void BatchNormForwardTraining(Handle& handle,
             ldsnogcn     = ylocalsize;
         }
 
-        std::string network_config =
-            "variant" + std::to_string(variant) + "gx" + std::to_string(xgridsize) + "gy" +
-            std::to_string(ygridsize) + "xl" + std::to_string(xlocalsize) + "yl" +
-            std::to_string(ylocalsize) + "ldsgcn" + std::to_string(ldsgcn) + "rs" +
-            std::to_string(static_cast<int>(resultsave)) + "rr" +
-            std::to_string(static_cast<int>(resultrunning)) + "fp16" +
-            std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
-            std::to_string(static_cast<int>(bfp32parm)) + "single" +
-            std::to_string(static_cast<int>(single)) + "n" + std::to_string(n) + "c" +
-            std::to_string(c) + "hw" + std::to_string(in_cstride);
+        auto network_config = NetworkConfig{} << variant << xgridsize << ygridsize << xlocalsize
+                                              << ylocalsize << ldsgcn << resultsave
+                                              << resultrunning << bfp16parm << bfp32parm << single
+                                              << n << c << in_cstride;
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
@@ -335,7 +329,7 @@ void BatchNormForwardTraining(Handle& handle,
 
                     MIOPEN_LOG_I2(kernel_name << ":: " << algo_name);
                     MIOPEN_LOG_I2("..." << parms);
-                    MIOPEN_LOG_I2("..." << network_config);
+                    MIOPEN_LOG_I2("..." << network_config.ToString());
                 }
 
                 vld.push_back(xlocalsize);
@@ -548,14 +542,9 @@ void BatchNormForwardTraining(Handle& handle,
         xgridsize             = c;
         ygridsize             = segment * ylocalsize;
         std::string algo_name = "miopenBatchNormForwardTrainingPerActivation";
-        std::string network_config =
-            "fp16" + std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
-            std::to_string(static_cast<int>(bfp32parm)) + "gx" + std::to_string(xgridsize) + "gy" +
-            std::to_string(ygridsize) + "lx" + std::to_string(xlocalsize) + "ly" +
-            std::to_string(ylocalsize) + "rs" + std::to_string(static_cast<int>(resultsave)) +
-            "rr" + std::to_string(static_cast<int>(resultrunning)) + "segment" +
-            std::to_string(segment) + "n" + std::to_string(n) + "c" + std::to_string(c) + "hw" +
-            std::to_string(in_cstride);
+        auto network_config = NetworkConfig{} << bfp16parm << bfp32parm << xgridsize << ygridsize
+                                              << xlocalsize << ylocalsize << resultsave
+                                              << resultrunning << segment << n << c << in_cstride;
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
@@ -788,13 +777,9 @@ void BatchNormForwardInference(Handle& handle,
         auto ygridsize = size_t(segment * ylocalsize);
 
         std::string algo_name = "miopenBatchNormalizationForwardInference";
-        std::string network_config =
-            "n" + std::to_string(n) + +"c" + std::to_string(c) + "hw" + std::to_string(in_cstride) +
-            "chw" + std::to_string(in_nstride) + "segment" + std::to_string(segment) + "gx" +
-            std::to_string(xgridsize) + "gy" + std::to_string(ygridsize) + "lx" +
-            std::to_string(xlocalsize) + "ly" + std::to_string(ylocalsize) + "fp16" +
-            std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
-            std::to_string(static_cast<int>(bfp32parm)) + "mode" + std::to_string(bn_mode);
+        auto network_config = NetworkConfig{} << n << c << in_cstride << in_nstride << segment
+                                              << xgridsize << ygridsize << xlocalsize << ylocalsize
+                                              << bfp16parm << bfp32parm << bn_mode;
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
         if(!kernels.empty())
@@ -1058,14 +1043,9 @@ void BatchNormBackward(Handle& handle,
             ldsnogcn   = xlocalsize;
         }
         std::string algo_name = "miopenBatchNormBackwardPropSpatial";
-        std::string network_config =
-            "variant" + std::to_string(variant) + "gx" + std::to_string(xgridsize) + "n" +
-            std::to_string(n) + "c" + std::to_string(c) + "hw" + std::to_string(in_cstride) + "gy" +
-            std::to_string(ygridsize) + "lx" + std::to_string(xlocalsize) + "ly" +
-            std::to_string(ylocalsize) + "us" + std::to_string(static_cast<int>(useSaved)) +
-            "fp16" + std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
-            std::to_string(static_cast<int>(bfp32parm)) + "single" +
-            std::to_string(static_cast<int>(single)) + "gcn" + std::to_string(ldsgcn);
+        auto network_config = NetworkConfig{} << variant << xgridsize << n << c << in_cstride
+                                              << ygridsize << xlocalsize << ylocalsize << useSaved
+                                              << bfp16parm << bfp32parm << single << ldsgcn;
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
@@ -1161,7 +1141,7 @@ void BatchNormBackward(Handle& handle,
 
                 MIOPEN_LOG_I2(kernel_name << ":: " << algo_name);
                 MIOPEN_LOG_I2("..." << parms);
-                MIOPEN_LOG_I2("..." << network_config);
+                MIOPEN_LOG_I2("..." << network_config.ToString());
                 vld.push_back(xlocalsize);
                 vld.push_back(ylocalsize);
                 vld.push_back(zlocalsize);
@@ -1311,13 +1291,9 @@ void BatchNormBackward(Handle& handle,
         }
 
         std::string algo_name = "miopenBatchNormBackwardPropPerActivation";
-        std::string network_config =
-            "gx" + std::to_string(xgridsize) + "gy" + std::to_string(ygridsize) + "lx" +
-            std::to_string(xlocalsize) + "ly" + std::to_string(ylocalsize) + "n" +
-            std::to_string(n) + "c" + std::to_string(c) + "hw" + std::to_string(in_cstride) + "u" +
-            std::to_string(static_cast<int>(useSaved)) + "fp16" +
-            std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
-            std::to_string(static_cast<int>(bfp32parm)) + "nhw" + std::to_string(in_nhw);
+        auto network_config = NetworkConfig{} << xgridsize << ygridsize << xlocalsize << ylocalsize
+                                              << n << c << in_cstride << useSaved << bfp16parm
+                                              << bfp32parm << in_nhw;
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
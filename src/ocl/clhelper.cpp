@@ -121,13 +121,19 @@ static void BuildProgram(cl_program program, cl_device_id device, const std::str
     }
 }
 
-ClProgramPtr LoadBinaryProgram(cl_context ctx, cl_device_id device, const std::string& source)
+ClProgramPtr
+LoadBinaryProgram(cl_context ctx, cl_device_id device, const char* binary, std::size_t size)
 {
-    ClProgramPtr result{CreateProgramWithBinary(ctx, device, source.data(), source.size())};
+    ClProgramPtr result{CreateProgramWithBinary(ctx, device, binary, size)};
     BuildProgram(result.get(), device);
     return result;
 }
 
+ClProgramPtr LoadBinaryProgram(cl_context ctx, cl_device_id device, const std::string& source)
+{
+    return LoadBinaryProgram(ctx, device, source.data(), source.size());
+}
+
 ClProgramPtr LoadProgram(cl_context ctx,
                          cl_device_id device,
                          const std::string& program_name,
@@ -144,7 +150,7 @@ ClProgramPtr LoadProgram(cl_context ctx,
     else
     {
         if(kernel_src.empty())
-            source = miopen::GetKernelSrc(program_name);
+            source = miopen::GetKernelSrc(program_name).to_string();
         else
             source  = kernel_src;
         auto is_asm = miopen::EndsWith(program_name, ".s");
@@ -35,6 +35,7 @@
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/metrics.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
@@ -112,6 +113,29 @@ static inline void AddKernels(Handle& handle,
     }
 }
 
+/// Lets calls made without a user workspace run on the handle's workspace arena. The size a
+/// solution needs is only computed the first time, then it is kept by the direction, solver
+/// and network config, like the kernels of the solution.
+template <class F>
+static inline void UseWorkspaceArena(Handle& handle,
+                                     miopenConvDirection_t direction,
+                                     solver::Id solver_id,
+                                     const std::string& network_config,
+                                     Data_t& workSpace,
+                                     std::size_t& workSpaceSize,
+                                     F required_size)
+{
+    if(workSpace != nullptr || !handle.IsWorkspaceArenaEnabled())
+        return;
+    auto& sizes    = handle.workspace_arena.solution_sizes;
+    const auto key = std::make_tuple(direction, solver_id.Value(), network_config);
+    auto it        = sizes.find(key);
+    if(it == sizes.end())
+        it = sizes.emplace(key, required_size()).first;
+    workSpaceSize = it->second;
+    workSpace     = handle.GetWorkspace(workSpaceSize);
+}
+
 static inline void ValidateGroupCount(const TensorDescriptor& xDesc,
                                       const TensorDescriptor& wDesc,
                                       const ConvolutionDescriptor& conv)
@@ -142,13 +166,18 @@ inline int EvaluateDataDirectSolution(Handle& handle,
                                       Data_t out, // Fwd: y, Bwd: dx
                                       const TensorDescriptor& outDesc,
                                       Data_t workSpace,
-                                      const size_t workSpaceSize,
+                                      size_t workSpaceSize,
                                       T padding_val,
                                       float& elapsed)
 {
     // Fail if required workspace is not provided.
     if(solution.workspce_sz != 0)
     {
+        if(workSpace == nullptr && handle.IsWorkspaceArenaEnabled())
+        {
+            workSpace     = handle.GetWorkspace(solution.workspce_sz);
+            workSpaceSize = solution.workspce_sz;
+        }
         if(workSpace == nullptr || workSpaceSize < solution.workspce_sz)
             return -1;
     }
@@ -1170,6 +1199,7 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
         perfResults[i].memory   = perf_db[i].workspace;
     }
 
+    metrics::GetSolverCounter(perf_db[0].solver_id).fetch_add(1, std::memory_order_relaxed);
     MIOPEN_LOG_I("FW Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
                                          << ", "
                                          << perf_db[0].time);
@@ -1636,6 +1666,24 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
         MIOPEN_THROW("GEMM convolution is unsupported");
     }
 
+    if(workSpace == nullptr && handle.IsWorkspaceArenaEnabled())
+    {
+        std::string network_config;
+        auto ctx = ConvolutionContext{tensors.xDesc, tensors.wDesc, tensors.yDesc, *this, 1};
+        ctx.SetStream(&handle);
+        ctx.mloBuildConf_Key(network_config);
+        UseWorkspaceArena(handle,
+                          miopenConvFwd,
+                          solver::Id::gemm(),
+                          network_config,
+                          workSpace,
+                          workSpaceSize,
+                          [&]() {
+                              return ForwardGetValidWorkSpaceSizeGemm(
+                                  handle, tensors.wDesc, tensors.xDesc, tensors.yDesc);
+                          });
+    }
+
     std::size_t in_n, in_c;
     std::tie(in_n, in_c) = tie_pick<0, 1>()(tensors.xDesc.GetLengths());
 
@@ -2666,7 +2714,7 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
                                                         const TensorDescriptor& yDesc,
                                                         Data_t y,
                                                         Data_t workSpace,
-                                                        const std::size_t workSpaceSize,
+                                                        std::size_t workSpaceSize,
                                                         const solver::Id solver_id) const
 {
     MIOPEN_LOG_I("solver_id = " << solver_id.ToString() << ", workspace = " << workSpaceSize);
@@ -2676,6 +2724,18 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
     if(!solver_id.IsValid())
         MIOPEN_THROW(miopenStatusBadParm);
 
+    metrics::GetSolverCounter(solver_id.ToString()).fetch_add(1, std::memory_order_relaxed);
+
+    std::string network_config;
+    auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, 1};
+    ctx.SetStream(&handle);
+    ctx.mloBuildConf_Key(network_config);
+
+    UseWorkspaceArena(
+        handle, miopenConvFwd, solver_id, network_config, workSpace, workSpaceSize, [&]() {
+            return GetForwardSolutionWorkspaceSize(handle, wDesc, xDesc, yDesc, solver_id);
+        });
+
     ConvForwardCheckNumerics(handle, tensors, [&]() {
 
         if(solver_id == solver::Id::gemm())
@@ -2684,10 +2744,6 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
             return;
         }
 
-        std::string network_config;
-        auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, 1};
-        ctx.SetStream(&handle);
-        ctx.mloBuildConf_Key(network_config);
         auto algo_name           = solver_id.GetAlgo(miopenConvFwd);
         const auto&& chk_kernels = handle.GetKernels(algo_name, network_config);
         auto v_chk_kernels = std::vector<KernelInvoke>{chk_kernels.begin(), chk_kernels.end()};
@@ -3255,6 +3311,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
         perfResults[i].memory        = perf_db[i].workspace;
     }
 
+    metrics::GetSolverCounter(perf_db[0].solver_id).fetch_add(1, std::memory_order_relaxed);
     MIOPEN_LOG_I("BWD Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
                                           << ", "
                                           << perf_db[0].time);
@@ -3935,6 +3992,18 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
     if(wDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
 
+    metrics::GetSolverCounter(solver_id.ToString()).fetch_add(1, std::memory_order_relaxed);
+
+    std::string network_config;
+    auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, 0};
+    ctx.SetStream(&handle);
+    ctx.mloBuildConf_Key(network_config);
+
+    UseWorkspaceArena(
+        handle, miopenConvBwdData, solver_id, network_config, workSpace, workSpaceSize, [&]() {
+            return GetBackwardSolutionWorkspaceSize(handle, dyDesc, wDesc, dxDesc, solver_id);
+        });
+
     static const float beta = 0.0f;
     ConvBwdCheckNumerics(handle, tensors, &beta, [&]() {
         if(dyDesc.GetLengths()[1] != wDesc.GetLengths()[0])
@@ -3949,10 +4018,6 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
             return;
         }
 
-        std::string network_config;
-        auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, 0};
-        ctx.SetStream(&handle);
-        ctx.mloBuildConf_Key(network_config);
         auto algo_name           = solver_id.GetAlgo(miopenConvBwdData);
         const auto&& chk_kernels = handle.GetKernels(algo_name, network_config);
         auto v_chk_kernels = std::vector<KernelInvoke>{chk_kernels.begin(), chk_kernels.end()};
@@ -4802,6 +4867,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
         perfResults[i].time             = perf_db[i].time;
         perfResults[i].memory           = perf_db[i].workspace;
     }
+    metrics::GetSolverCounter(perf_db[0].solver_id).fetch_add(1, std::memory_order_relaxed);
     MIOPEN_LOG_I("BWrW Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
                                            << ", "
                                            << perf_db[0].time);
@@ -5439,6 +5505,19 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
     if(xDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
 
+    metrics::GetSolverCounter(solver_id.ToString()).fetch_add(1, std::memory_order_relaxed);
+
+    std::string network_config;
+    auto ctx = ConvolutionContext{xDesc, dwDesc, dyDesc, *this, 0};
+    ctx.SetStream(&handle);
+    ctx.direction.SetBackwardWrW();
+    ctx.mloBuildConf_Key(network_config);
+
+    UseWorkspaceArena(
+        handle, miopenConvBwdWeights, solver_id, network_config, workSpace, workSpaceSize, [&]() {
+            return GetWrwSolutionWorkspaceSize(handle, dyDesc, xDesc, dwDesc, solver_id);
+        });
+
     float beta = 0;
     ConvWrwCheckNumerics(handle, tensors, &beta, [&]() {
         ValidateGroupCount(xDesc, dwDesc, *this);
@@ -5449,11 +5528,6 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
             return;
         }
 
-        std::string network_config;
-        auto ctx = ConvolutionContext{xDesc, dwDesc, dyDesc, *this, 0};
-        ctx.SetStream(&handle);
-        ctx.direction.SetBackwardWrW();
-        ctx.mloBuildConf_Key(network_config);
         auto algo_name           = solver_id.GetAlgo(miopenConvBwdWeights);
         const auto&& chk_kernels = handle.GetKernels(algo_name, network_config);
         auto v_chk_kernels = std::vector<KernelInvoke>{chk_kernels.begin(), chk_kernels.end()};
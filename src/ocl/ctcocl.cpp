@@ -38,6 +38,7 @@
 #include <vector>
 #include <numeric>
 #include <algorithm>
+#include <cstring>
 
 #define MAX_ACTIVE_THREADS (64 * 4 * 64)
 #define MAX_LOCAL_MEM 65536
@@ -167,6 +168,14 @@ void CTCLossDescriptor::CTCLoss(Handle& handle,
               labels,
               total_label_len * sizeof(int),
               hipMemcpyHostToDevice);
+#elif MIOPEN_BACKEND_MOCK
+
+    std::memcpy(static_cast<int*>(workSpace), inputLengths, batch_bytes);
+    std::memcpy(static_cast<int*>(workSpace) + batch_size, labelLengths, batch_bytes);
+    std::memcpy(static_cast<int*>(workSpace) + 2 * batch_size, labels_offset.data(), batch_bytes);
+    std::memcpy(static_cast<int*>(workSpace) + 3 * batch_size, repeat.data(), batch_bytes);
+    std::memcpy(
+        static_cast<int*>(workSpace) + 4 * batch_size, labels, total_label_len * sizeof(int));
 #endif
 
     std::string program_name = "MIOpenCTCLoss.cl";
@@ -42,15 +42,14 @@
 
 namespace miopen {
 
-template <typename T>
-inline void SquashPairedTensor(const std::vector<T> x_len,
-                               const std::vector<T> x_str,
-                               const std::vector<T> y_len,
-                               const std::vector<T> y_str,
-                               std::vector<T>& in_len,
-                               std::vector<T>& in_str,
-                               std::vector<T>& out_len,
-                               std::vector<T>& out_str)
+inline void SquashPairedTensor(const TensorDims& x_len,
+                               const TensorDims& x_str,
+                               const TensorDims& y_len,
+                               const TensorDims& y_str,
+                               std::vector<std::size_t>& in_len,
+                               std::vector<std::size_t>& in_str,
+                               std::vector<std::size_t>& out_len,
+                               std::vector<std::size_t>& out_str)
 {
 
     auto itr_xl = x_len.end() - 1;
@@ -110,10 +109,8 @@ void DropoutDescriptor::InitPRNGState(Handle& handle,
     size_t states_num = prng_stateSizeInBytes / sizeof(prngStates);
     size_t wk_grp_num = std::min(size_t(MAX_PRNG_STATE / 256), (states_num + 255) / 256);
 
-    std::string network_config = "initprngs-" + std::to_string(states_num) + "x" +
-                                 std::to_string(sizeof(prngStates)) + "x" +
-                                 std::to_string(rng_mode) + "x" + std::to_string(prng_seed) + "x" +
-                                 std::to_string(wk_grp_num);
+    auto network_config = NetworkConfig{"initprngs"} << states_num << sizeof(prngStates)
+                                                     << rng_mode << prng_seed << wk_grp_num;
 
     auto&& kernels = handle.GetKernels(kernel_name, network_config);
     if(!kernels.empty())
@@ -245,24 +242,18 @@ void DropoutDescriptor::DropoutForward(Handle& handle,
     std::string program_name = "MIOpenDropout.cl";
     std::string kernel_name  = "DropoutForward";
 
-    std::string network_config =
-        "fwd-" + std::string(xDesc.GetType() == miopenHalf ? "fp16-" : "fp32-") + "dim" +
-        std::to_string(in_len[0]) + "x" + std::to_string(in_len[1]) + "x" +
-        std::to_string(in_len[2]) + "x" + std::to_string(in_len[3]) + "x" +
-        std::to_string(in_len[4]) + "-xstr" + std::to_string(in_str[0]) + "x" +
-        std::to_string(in_str[1]) + "x" + std::to_string(in_str[2]) + "x" +
-        std::to_string(in_str[3]) + "x" + std::to_string(in_str[4]) + "-ystr" +
-        std::to_string(out_str[0]) + "x" + std::to_string(out_str[1]) + "x" +
-        std::to_string(out_str[2]) + "x" + std::to_string(out_str[3]) + "x" +
-        std::to_string(out_str[4]) + "-dropout" + std::to_string(dropout) + "-seed" +
-        std::to_string(seed) + "-rng" + std::to_string(rng_mode) + "-rsvsp" +
-        std::to_string(static_cast<int>(use_rsvsp)) + "-mask" +
-        std::to_string(static_cast<int>(use_mask)) + "-evo" +
-        std::to_string(static_cast<int>(state_evo)) + "-blk" + std::to_string(RD_BLCK) + "-wg" +
-        std::to_string(wk_grp_num) + "-noise" + std::to_string(noise_shape.GetLengths()[0]);
-
-    for(int i = 1; i < noise_shape.GetSize(); i++)
-        network_config += "x" + std::to_string(noise_shape.GetLengths()[i]);
+    NetworkConfig network_config{"fwd"};
+    network_config << xDesc.GetType();
+    for(auto v : in_len)
+        network_config << v;
+    for(auto v : in_str)
+        network_config << v;
+    for(auto v : out_str)
+        network_config << v;
+    network_config << dropout << seed << rng_mode << use_rsvsp << use_mask << state_evo << RD_BLCK
+                   << wk_grp_num;
+    for(auto len : noise_shape.GetLengths())
+        network_config << len;
 
     auto&& kernels = handle.GetKernels(kernel_name, network_config);
 
@@ -453,24 +444,18 @@ void DropoutDescriptor::DropoutBackward(Handle& handle,
     std::string program_name = "MIOpenDropout.cl";
     std::string kernel_name  = "DropoutBackward";
 
-    std::string network_config =
-        "bwd-" + std::string(dyDesc.GetType() == miopenHalf ? "fp16-" : "fp32-") + "dim" +
-        std::to_string(in_len[0]) + "x" + std::to_string(in_len[1]) + "x" +
-        std::to_string(in_len[2]) + "x" + std::to_string(in_len[3]) + "x" +
-        std::to_string(in_len[4]) + "-xstr" + std::to_string(in_str[0]) + "x" +
-        std::to_string(in_str[1]) + "x" + std::to_string(in_str[2]) + "x" +
-        std::to_string(in_str[3]) + "x" + std::to_string(in_str[4]) + "-ystr" +
-        std::to_string(out_str[0]) + "x" + std::to_string(out_str[1]) + "x" +
-        std::to_string(out_str[2]) + "x" + std::to_string(out_str[3]) + "x" +
-        std::to_string(out_str[4]) + "-dropout" + std::to_string(dropout) + "-seed" +
-        std::to_string(seed) + "-rng" + std::to_string(rng_mode) + "-prng" +
-        std::to_string(static_cast<int>(use_prng)) + "-mask" +
-        std::to_string(static_cast<int>(use_mask)) + "-evo" +
-        std::to_string(static_cast<int>(state_evo)) + "-blk" + std::to_string(RD_BLCK) + "-wg" +
-        std::to_string(wk_grp_num) + "-noise" + std::to_string(noise_shape.GetLengths()[0]);
-
-    for(int i = 1; i < noise_shape.GetSize(); i++)
-        network_config += "x" + std::to_string(noise_shape.GetLengths()[i]);
+    NetworkConfig network_config{"bwd"};
+    network_config << dyDesc.GetType();
+    for(auto v : in_len)
+        network_config << v;
+    for(auto v : in_str)
+        network_config << v;
+    for(auto v : out_str)
+        network_config << v;
+    network_config << dropout << seed << rng_mode << use_prng << use_mask << state_evo << RD_BLCK
+                   << wk_grp_num;
+    for(auto len : noise_shape.GetLengths())
+        network_config << len;
 
     auto&& kernels = handle.GetKernels(kernel_name, network_config);
 
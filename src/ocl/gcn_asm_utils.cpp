@@ -36,6 +36,7 @@
 #include <miopen/kernel.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/exec_utils.hpp>
+#include <miopen/tool_probe_cache.hpp>
 #include <sstream>
 
 #ifdef __linux__
@@ -90,11 +91,12 @@ bool ValidateGcnAssemblerImpl()
 
     std::stringstream clang_stdout;
     MIOPEN_LOG_NQI2("Running: " << '\'' << path << " --version" << '\'');
-    auto clang_rc = miopen::exec::Run(path + " --version", nullptr, &clang_stdout);
+    auto clang_rc = miopen::exec::Run(path, {"--version"}, nullptr, &clang_stdout);
 
     if(clang_rc != 0)
     {
-        return false;
+        // Not a property of the assembler, so the probe fails instead of being cached.
+        MIOPEN_THROW(path + " --version has failed: " + std::to_string(clang_rc));
     }
 
     std::string clang_result_line;
@@ -118,7 +120,10 @@ bool ValidateGcnAssemblerImpl()
 
 bool ValidateGcnAssembler()
 {
-    static bool result = ValidateGcnAssemblerImpl();
+    static bool result =
+        miopen::GetCachedToolProbe(GetGcnAssemblerPath(), "validate", [] {
+            return ValidateGcnAssemblerImpl() ? "1" : "0";
+        }) == "1";
     return result;
 }
 
@@ -171,8 +176,8 @@ void AmdgcnAssemble(std::string& source, const std::string& params)
 
     std::istringstream clang_stdin(source);
     const auto clang_path = GetGcnAssemblerPath();
-    const auto clang_rc =
-        miopen::exec::Run(clang_path + " " + options.str(), &clang_stdin, nullptr);
+    const auto clang_rc = miopen::exec::Run(
+        clang_path, miopen::exec::SplitCommandLine(options.str()), &clang_stdin, nullptr);
     if(clang_rc != 0)
     {
         MIOPEN_LOG_W(options.str());
@@ -217,13 +222,16 @@ void AmdgcnAssemble(std::string& source, const std::string& params)
 static void AmdgcnAssembleQuiet(std::string& source, const std::string& params)
 {
 #ifdef __linux__
-    std::stringstream clang_stdout_unused;
+    std::stringstream clang_output_unused;
     const auto clang_path = GetGcnAssemblerPath();
     const auto args       = " -x assembler -target amdgcn--amdhsa " + params + " " + source +
-                      " -o /dev/null" + // We do not need output file
-                      " 2>&1";          // Keep console clean from error messages.
+                      " -o /dev/null"; // We do not need output file
     MIOPEN_LOG_NQI2(clang_path << " " << args);
-    const int clang_rc = miopen::exec::Run(clang_path + " " + args, nullptr, &clang_stdout_unused);
+    miopen::exec::Options options;
+    options.out = &clang_output_unused;
+    options.err = &clang_output_unused; // Keep console clean from error messages.
+    const int clang_rc =
+        miopen::exec::Run(clang_path, miopen::exec::SplitCommandLine(args), options);
     if(clang_rc != 0)
         MIOPEN_THROW("Assembly error(" + std::to_string(clang_rc) + ")");
 #else
@@ -252,11 +260,14 @@ static bool GcnAssemblerHasBug34765Impl()
 
 bool GcnAssemblerHasBug34765()
 {
-    const static bool b = GcnAssemblerHasBug34765Impl();
+    const static bool b =
+        miopen::GetCachedToolProbe(GetGcnAssemblerPath(), "bug_34765", [] {
+            return GcnAssemblerHasBug34765Impl() ? "1" : "0";
+        }) == "1";
     return b;
 }
 
-static bool GcnAssemblerSupportsOption(const std::string& option)
+static bool GcnAssemblerSupportsOptionImpl(const std::string& option)
 {
     auto p = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
     miopen::WriteFile(miopen::GetKernelSrc("dummy_kernel"), p);
@@ -274,6 +285,13 @@ static bool GcnAssemblerSupportsOption(const std::string& option)
     }
 }
 
+static bool GcnAssemblerSupportsOption(const std::string& option)
+{
+    return miopen::GetCachedToolProbe(GetGcnAssemblerPath(), "supports " + option, [&] {
+               return GcnAssemblerSupportsOptionImpl(option) ? "1" : "0";
+           }) == "1";
+}
+
 static bool GcnAssemblerSupportsNoCOv3()
 {
     const static bool b = GcnAssemblerSupportsOption(option_no_co_v3);
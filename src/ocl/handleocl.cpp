@@ -29,6 +29,7 @@
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/kernel_cache.hpp>
+#include <miopen/memory_pool.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/ocldeviceinfo.hpp>
 #include <miopen/binary_cache.hpp>
@@ -38,6 +39,7 @@
 #if MIOPEN_USE_MIOPENGEMM
 #include <miopen/gemm_geometry.hpp>
 #endif
+#include <chrono>
 #include <string>
 
 #ifndef _WIN32
@@ -444,16 +446,66 @@ void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
         MIOPEN_THROW("Error setting stream to nullptr");
     }
 
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        MIOPEN_THROW("Stream can not be changed while the stream pool is forked");
+
     clRetainCommandQueue(streamID);
     impl->queue = HandleImpl::AqPtr{streamID};
 }
 
-miopenAcceleratorQueue_t Handle::GetStream() const { return impl->queue.get(); }
+miopenAcceleratorQueue_t Handle::GetStream() const
+{
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        return stream_pool->GetActive();
+    return impl->queue.get();
+}
+
+StreamPool::Backend Handle::GetStreamPoolBackend()
+{
+    using Stream = StreamPool::Stream;
+    // Pool queues live in the context of the current queue.
+    const auto queue = this->GetStream();
+    StreamPool::Backend backend;
+    backend.create = [queue] {
+        cl_int status = 0;
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+        auto result = clCreateCommandQueue(miopen::GetContext(queue),
+                                           miopen::GetDevice(queue),
+                                           CL_QUEUE_PROFILING_ENABLE,
+                                           &status);
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+        if(status != CL_SUCCESS)
+            MIOPEN_THROW_CL_STATUS(status, "Creating Command Queue. (clCreateCommandQueue)");
+        return result;
+    };
+    backend.destroy = [](Stream stream) { clReleaseCommandQueue(stream); };
+    backend.wait    = [](Stream waiting, Stream signaling) {
+        cl_event event = nullptr;
+        auto status    = clEnqueueMarkerWithWaitList(signaling, 0, nullptr, &event);
+        if(status != CL_SUCCESS)
+            MIOPEN_THROW_CL_STATUS(status, "OpenCL error enqueueing a marker");
+        // The marker has to be submitted before another queue can wait for it.
+        status = clFlush(signaling);
+        if(status == CL_SUCCESS)
+            status = clEnqueueBarrierWithWaitList(waiting, 1, &event, nullptr);
+        clReleaseEvent(event);
+        if(status != CL_SUCCESS)
+            MIOPEN_THROW_CL_STATUS(status, "OpenCL error making a queue wait for an event");
+    };
+    return backend;
+}
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
                           void* allocatorContext) const
 {
+    // Cached buffers must go back to the allocator that created them.
+    this->TrimMemoryPool();
     if(allocator == nullptr && allocatorContext != nullptr)
     {
         MIOPEN_THROW("Allocator context can not be used with the default allocator");
@@ -498,11 +550,36 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
     return this->Run(obj);
 }
 
+KernelInvoke Handle::AddKernel(const std::string& algorithm,
+                               const NetworkConfig& network_config,
+                               const std::string& program_name,
+                               const std::string& kernel_name,
+                               const std::vector<size_t>& vld,
+                               const std::vector<size_t>& vgd,
+                               const std::string& params,
+                               std::size_t cache_index)
+{
+    auto obj = this->impl->cache.AddKernel(*this,
+                                           KernelCache::Key{algorithm, network_config},
+                                           program_name,
+                                           kernel_name,
+                                           vld,
+                                           vgd,
+                                           params,
+                                           cache_index);
+    return this->Run(obj);
+}
+
 bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.HasKernels(algorithm, network_config);
 }
 
+bool Handle::HasKernel(const std::string& algorithm, const NetworkConfig& network_config) const
+{
+    return this->impl->cache.HasKernels(KernelCache::Key{algorithm, network_config});
+}
+
 void Handle::ClearKernels(const std::string& algorithm, const std::string& network_config)
 {
 
@@ -515,20 +592,24 @@ const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
+const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
+                                                  const NetworkConfig& network_config)
+{
+    return this->impl->cache.GetKernels(KernelCache::Key{algorithm, network_config});
+}
+
 KernelInvoke Handle::Run(Kernel k)
 {
     auto q = this->GetStream();
-    if(this->impl->enable_profiling || MIOPEN_GPU_SYNC)
-    {
-        return k.Invoke(q,
-                        std::bind(&HandleImpl::SetProfilingResult,
-                                  std::ref(*this->impl),
-                                  std::placeholders::_1));
-    }
-    else
-    {
-        return k.Invoke(q);
-    }
+    auto invoke =
+        this->impl->enable_profiling || MIOPEN_GPU_SYNC
+            ? k.Invoke(q,
+                       std::bind(&HandleImpl::SetProfilingResult,
+                                 std::ref(*this->impl),
+                                 std::placeholders::_1))
+            : k.Invoke(q);
+    invoke.capture = this->capture_plan.get();
+    return invoke;
 }
 
 Program Handle::LoadProgram(const std::string& program_name,
@@ -536,35 +617,79 @@ Program Handle::LoadProgram(const std::string& program_name,
                             bool is_kernel_str,
                             const std::string& kernel_src)
 {
-    auto cache_file =
-        miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
-    if(cache_file.empty())
-    {
-        auto p = miopen::LoadProgram(miopen::GetContext(this->GetStream()),
+    const auto load_cached = [&](bool is_recheck) -> Program {
+        const auto packed = miopen::LoadPackedBinary(
+            this->GetDeviceName(), program_name, params, is_kernel_str, is_recheck);
+        if(!packed.empty())
+            return LoadBinaryProgram(miopen::GetContext(this->GetStream()),
                                      miopen::GetDevice(this->GetStream()),
-                                     program_name,
-                                     params,
-                                     is_kernel_str,
-                                     kernel_src);
-
-        // Save to cache
-        auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
-        miopen::SaveProgramBinary(p, path.string());
-        miopen::SaveBinary(
-            path.string(), this->GetDeviceName(), program_name, params, is_kernel_str);
-
-        return std::move(p);
-    }
-    else
+                                     packed.data,
+                                     packed.size);
+
+        const auto cache_file = miopen::LoadBinary(
+            this->GetDeviceName(), program_name, params, is_kernel_str, is_recheck);
+        if(!cache_file.empty())
+            return LoadBinaryProgram(miopen::GetContext(this->GetStream()),
+                                     miopen::GetDevice(this->GetStream()),
+                                     miopen::LoadFile(cache_file));
+        return nullptr;
+    };
+
+    auto cached = load_cached(false);
+    if(cached != nullptr)
+        return cached;
+
+    // Only one thread compiles the program, the others pick it up from the cache.
+    miopen::InFlightCompilation compilation{
+        this->GetDeviceName(), program_name, params, is_kernel_str};
+    cached = load_cached(true);
+    if(cached != nullptr)
+        return cached;
+
+    MIOPEN_TRACE_SCOPE(Compile, trace::Intern(program_name));
+    const auto start = std::chrono::steady_clock::now();
+    auto p           = [&] {
+        try
+        {
+            return miopen::LoadProgram(miopen::GetContext(this->GetStream()),
+                                       miopen::GetDevice(this->GetStream()),
+                                       program_name,
+                                       params,
+                                       is_kernel_str,
+                                       kernel_src);
+        }
+        catch(...)
+        {
+            compilation.SetFailed(std::current_exception());
+            throw;
+        }
+    }();
+    const std::chrono::duration<double> compile_time = std::chrono::steady_clock::now() - start;
+
+    // Save to cache
+    auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
+    miopen::SaveProgramBinary(p, path.string());
+    miopen::SaveBinary(path.string(),
+                       this->GetDeviceName(),
+                       program_name,
+                       params,
+                       is_kernel_str,
+                       compile_time.count());
+
+    return std::move(p);
+}
+
+void Handle::Finish() const
+{
+    if(stream_pool != nullptr && stream_pool->IsForked())
     {
-        return LoadBinaryProgram(miopen::GetContext(this->GetStream()),
-                                 miopen::GetDevice(this->GetStream()),
-                                 miopen::LoadFile(cache_file));
+        for(auto stream : stream_pool->GetForked())
+            clFinish(stream);
     }
+    else
+        clFinish(this->GetStream());
 }
 
-void Handle::Finish() const { clFinish(this->GetStream()); }
-
 void Handle::Flush() const { clFlush(this->GetStream()); }
 
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
@@ -618,14 +743,20 @@ std::size_t Handle::GetWavefrontWidth()
 
 Allocator::ManageDataPtr Handle::Create(std::size_t sz)
 {
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Allocations can not be captured");
     MIOPEN_HANDLE_LOCK
     this->Finish();
+    if(this->memory_pool != nullptr)
+        return this->memory_pool->Allocate(this->impl->allocator, sz, this->GetStream());
     return this->impl->allocator(sz);
 }
 
 Allocator::ManageDataPtr&
 Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t sz)
 {
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Memory transfers can not be captured");
     MIOPEN_HANDLE_LOCK
     this->Finish();
     cl_int status = clEnqueueWriteBuffer(
@@ -639,6 +770,8 @@ Handle::WriteTo(const void* data, Allocator::ManageDataPtr& ddata, std::size_t s
 
 void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size_t sz)
 {
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Memory transfers can not be captured");
     MIOPEN_HANDLE_LOCK
     this->Finish();
     auto status = clEnqueueReadBuffer(
@@ -651,6 +784,8 @@ void Handle::ReadTo(void* data, const Allocator::ManageDataPtr& ddata, std::size
 
 void Handle::Copy(ConstData_t src, Data_t dest, std::size_t size)
 {
+    if(this->IsCapturing())
+        MIOPEN_THROW(miopenStatusNotImplemented, "Memory transfers can not be captured");
     MIOPEN_HANDLE_LOCK
     this->Finish();
     auto status =
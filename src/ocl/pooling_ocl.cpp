@@ -111,19 +111,15 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
     construct_params.setPoolingDescr(
         pooling_method, GetIndexType(), lens[0], lens[1], pads[0], pads[1], strides[0], strides[1]);
 
-    std::string network_config =
-        std::to_string(pooling_method) + std::to_string(static_cast<int>(save_index)) +
-        std::to_string(xDesc.GetType()) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(nIn) + std::to_string(nOut) + std::to_string(nInStride) +
-        std::to_string(nOutStride) + std::to_string(cIn) + std::to_string(cOut) +
-        std::to_string(cInStride) + std::to_string(cOutStride) + std::to_string(hIn) +
-        std::to_string(hOut) + std::to_string(hInStride) + std::to_string(hOutStride) +
-        std::to_string(lens[0]) + std::to_string(lens[1]) + std::to_string(strides[0]) +
-        std::to_string(strides[1]) + std::to_string(pads[0]) + std::to_string(pads[1]) +
-        std::to_string(GetIndexType());
+    auto network_config = NetworkConfig{} << pooling_method << save_index << xDesc.GetType()
+                                          << nInStride << nOutStride << nIn << nOut << nInStride
+                                          << nOutStride << cIn << cOut << cInStride << cOutStride
+                                          << hIn << hOut << hInStride << hOutStride << lens[0]
+                                          << lens[1] << strides[0] << strides[1] << pads[0]
+                                          << pads[1] << GetIndexType();
 
     std::string algo_name = "miopenPooling2dForward";
-    // printf("Pooling forward network_config: %s\n", network_config.c_str());
+    // printf("Pooling forward network_config: %s\n", network_config.ToString().c_str());
     auto&& kernels = handle.GetKernels(algo_name, network_config);
     if(!kernels.empty())
     {
@@ -262,16 +258,13 @@ miopenStatus_t PoolingDescriptor::Backward(Handle& handle,
     construct_params.setPoolingDescr(
         pooling_method, GetIndexType(), lens[0], lens[1], pads[0], pads[1], strides[0], strides[1]);
 
-    std::string network_config =
-        std::to_string(pooling_method) + std::to_string(xDesc.GetType()) +
-        std::to_string(nInStride) + std::to_string(nOutStride) + std::to_string(nIn) +
-        std::to_string(nOut) + std::to_string(nInStride) + std::to_string(nOutStride) +
-        std::to_string(cIn) + std::to_string(cOut) + std::to_string(cInStride) +
-        std::to_string(cOutStride) + std::to_string(hIn) + std::to_string(hOut) +
-        std::to_string(hInStride) + std::to_string(hOutStride) + std::to_string(lens[0]) +
-        std::to_string(lens[1]) + std::to_string(strides[0]) + std::to_string(strides[1]) +
-        std::to_string(pads[0]) + std::to_string(pads[1]) + std::to_string(GetIndexType());
-    // printf("Pooling backward network_config: %s\n", network_config.c_str());
+    auto network_config = NetworkConfig{} << pooling_method << xDesc.GetType() << nInStride
+                                          << nOutStride << nIn << nOut << nInStride << nOutStride
+                                          << cIn << cOut << cInStride << cOutStride << hIn << hOut
+                                          << hInStride << hOutStride << lens[0] << lens[1]
+                                          << strides[0] << strides[1] << pads[0] << pads[1]
+                                          << GetIndexType();
+    // printf("Pooling backward network_config: %s\n", network_config.ToString().c_str());
     std::string algo_name = "miopenPooling2dBackward";
 
     auto&& kernels = handle.GetKernels(algo_name, network_config);
@@ -117,17 +117,11 @@ miopenStatus_t SoftmaxForward(Handle& handle,
         const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
 
         std::string algo_name = "SoftmaxForwardOneBatch";
-        std::string network_config =
-            "sfmfwd-n" + std::to_string(num_batch) + "half" +
-            std::to_string(static_cast<int>(usefp16)) + "float" +
-            std::to_string(static_cast<int>(usefp32)) + "g" + std::to_string(vgd[0]) + "l" +
-            std::to_string(vld[0]) + "dim" + std::to_string(spatial_dim) + "grid" +
-            std::to_string(grid_size) + "wg" + std::to_string(workgroups) + "v" +
-            std::to_string(vector_size) + "xpk" +
-            std::to_string(static_cast<int>(xDesc.IsPacked())) + "ypk" +
-            std::to_string(static_cast<int>(yDesc.IsPacked())) + "a" + std::to_string(alpha_fp) +
-            "b" + std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
-            "mode" + std::to_string(static_cast<int>(mode));
+        auto network_config = NetworkConfig{"sfmfwd"} << num_batch << usefp16 << usefp32 << vgd[0]
+                                                      << vld[0] << spatial_dim << grid_size
+                                                      << workgroups << vector_size
+                                                      << xDesc.IsPacked() << yDesc.IsPacked()
+                                                      << alpha_fp << beta_fp << algorithm << mode;
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
@@ -219,18 +213,12 @@ miopenStatus_t SoftmaxForward(Handle& handle,
             MIOPEN_THROW(miopenStatusBadParm, "Exceed local memory capacity");
 
         std::string algo_name = "SoftmaxForwardMultiBatch";
-        std::string network_config =
-            "sfmfwd-n" + std::to_string(num_batch) + "half" +
-            std::to_string(static_cast<int>(usefp16)) + "float" +
-            std::to_string(static_cast<int>(usefp32)) + "g" + std::to_string(vgd[0]) + "l" +
-            std::to_string(vld[0]) + "dim" + std::to_string(spatial_dim) + "grid" +
-            std::to_string(grid_size) + "wg" + std::to_string(workgroups) + "v" +
-            std::to_string(vector_size) + "ubatch" + std::to_string(u_batch_size) + "batch" +
-            std::to_string(batch_size) + "xpk" +
-            std::to_string(static_cast<int>(xDesc.IsPacked())) + "ypk" +
-            std::to_string(static_cast<int>(yDesc.IsPacked())) + "a" + std::to_string(alpha_fp) +
-            "b" + std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
-            "mode" + std::to_string(static_cast<int>(mode));
+        auto network_config = NetworkConfig{"sfmfwd"} << num_batch << usefp16 << usefp32 << vgd[0]
+                                                      << vld[0] << spatial_dim << grid_size
+                                                      << workgroups << vector_size << u_batch_size
+                                                      << batch_size << xDesc.IsPacked()
+                                                      << yDesc.IsPacked() << alpha_fp << beta_fp
+                                                      << algorithm << mode;
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
@@ -395,18 +383,12 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
         const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
 
         std::string algo_name = "SoftmaxBackwardOneBatch";
-        std::string network_config =
-            "sfmbwd-n" + std::to_string(num_batch) + "half" +
-            std::to_string(static_cast<int>(usefp16)) + "float" +
-            std::to_string(static_cast<int>(usefp32)) + "g" + std::to_string(vgd[0]) + "l" +
-            std::to_string(vld[0]) + "dim" + std::to_string(spatial_dim) + "grid" +
-            std::to_string(grid_size) + "wg" + std::to_string(workgroups) + "v" +
-            std::to_string(vector_size) + "ypk" +
-            std::to_string(static_cast<int>(yDesc.IsPacked())) + "dypk" +
-            std::to_string(static_cast<int>(dyDesc.IsPacked())) + "dxpk" +
-            std::to_string(static_cast<int>(dxDesc.IsPacked())) + "a" + std::to_string(alpha_fp) +
-            "b" + std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
-            "mode" + std::to_string(static_cast<int>(mode));
+        auto network_config = NetworkConfig{"sfmbwd"} << num_batch << usefp16 << usefp32 << vgd[0]
+                                                      << vld[0] << spatial_dim << grid_size
+                                                      << workgroups << vector_size
+                                                      << yDesc.IsPacked() << dyDesc.IsPacked()
+                                                      << dxDesc.IsPacked() << alpha_fp << beta_fp
+                                                      << algorithm << mode;
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
@@ -503,19 +485,12 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
             MIOPEN_THROW(miopenStatusBadParm, "Exceed local memory capacity");
 
         std::string algo_name = "SoftmaxBackwardMultiBatch";
-        std::string network_config =
-            "sfmbwd-n" + std::to_string(num_batch) + "half" +
-            std::to_string(static_cast<int>(usefp16)) + "float" +
-            std::to_string(static_cast<int>(usefp32)) + "g" + std::to_string(vgd[0]) + "l" +
-            std::to_string(vld[0]) + "dim" + std::to_string(spatial_dim) + "grid" +
-            std::to_string(grid_size) + "wg" + std::to_string(workgroups) + "v" +
-            std::to_string(vector_size) + "ubatch" + std::to_string(u_batch_size) + "batch" +
-            std::to_string(batch_size) + "ypk" +
-            std::to_string(static_cast<int>(yDesc.IsPacked())) + "dypk" +
-            std::to_string(static_cast<int>(dyDesc.IsPacked())) + "dxpk" +
-            std::to_string(static_cast<int>(dxDesc.IsPacked())) + "a" + std::to_string(alpha_fp) +
-            "b" + std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
-            "mode" + std::to_string(static_cast<int>(mode));
+        auto network_config = NetworkConfig{"sfmbwd"} << num_batch << usefp16 << usefp32 << vgd[0]
+                                                      << vld[0] << spatial_dim << grid_size
+                                                      << workgroups << vector_size << u_batch_size
+                                                      << batch_size << yDesc.IsPacked()
+                                                      << dyDesc.IsPacked() << dxDesc.IsPacked()
+                                                      << alpha_fp << beta_fp << algorithm << mode;
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
@@ -47,8 +47,8 @@ TensorDescriptor GetFlattenedTensorDescriptor(const TensorDescriptor& desc)
         return {desc.GetType(), {desc.GetElementSize()}, {1}};
 
     // start flattening tensor
-    std::vector<std::size_t> flat_lengths;
-    std::vector<std::size_t> flat_strides;
+    TensorDims flat_lengths;
+    TensorDims flat_strides;
 
     auto non1_length_strides = boost::combine(desc.GetLengths(), desc.GetStrides()) |
                                boost::adaptors::filtered(f_length_is_not_1_t());
@@ -85,8 +85,8 @@ TensorDescriptor GetFlattenedTensorDescriptor(const TensorDescriptor& desc)
 
 // Free Tensor Functions
 static void CreateBitmapAndGrid(unsigned int& bitmap,
-                                std::vector<std::size_t>& a_lens,
-                                std::vector<std::size_t>& c_lens,
+                                const TensorDims& a_lens,
+                                const TensorDims& c_lens,
                                 int& num_wg,
                                 int& work,
                                 int d)
@@ -117,28 +117,33 @@ static bool IsBitmapLeadingOnes(unsigned int& bitmap, int n_size, int first_not_
     return leading_ones;
 }
 
-void OpTensor3d(Handle& handle,
-                miopenTensorOp_t tensorOp,
-                const void* alpha0,
-                const TensorDescriptor& aTensorDesc,
-                ConstData_t ATensor,
-                const void* alpha1,
-                const TensorDescriptor& bTensorDesc,
-                ConstData_t BTensor,
-                const void* beta,
-                const TensorDescriptor& cTensorDesc,
-                Data_t CTensor,
-                const size_t Aoffset,
-                const size_t Boffset,
-                const size_t Coffset)
+static Kernel GetOpTensorKernel(Handle& handle,
+                                const std::string& algorithm,
+                                const NetworkConfig& network_config)
 {
-    auto alens = aTensorDesc.GetLengths();
-    auto blens = bTensorDesc.GetLengths();
-    auto clens = cTensorDesc.GetLengths();
+    const auto& kernels = handle.GetKernelsImpl(algorithm, network_config);
+    if(kernels.empty())
+        MIOPEN_THROW("OpTensor kernel was not built: " + algorithm + " " +
+                     network_config.ToString());
+    return kernels.front();
+}
+
+static OpTensorLaunch OpTensor3d(Handle& handle,
+                                 miopenTensorOp_t tensorOp,
+                                 float alpha0,
+                                 const TensorDescriptor& aTensorDesc,
+                                 float alpha1,
+                                 const TensorDescriptor& bTensorDesc,
+                                 float beta,
+                                 const TensorDescriptor& cTensorDesc)
+{
+    const auto& alens = aTensorDesc.GetLengths();
+    const auto& blens = bTensorDesc.GetLengths();
+    const auto& clens = cTensorDesc.GetLengths();
 
-    auto astrides = aTensorDesc.GetStrides();
-    auto bstrides = bTensorDesc.GetStrides();
-    auto cstrides = cTensorDesc.GetStrides();
+    const auto& astrides = aTensorDesc.GetStrides();
+    const auto& bstrides = bTensorDesc.GetStrides();
+    const auto& cstrides = cTensorDesc.GetStrides();
 
     auto bsize = blens.size();
 
@@ -172,117 +177,97 @@ void OpTensor3d(Handle& handle,
 
     size_t local_threads = 256;
 
-    std::string network_config{};
-
-    network_config = std::to_string(bTensorDesc.GetType()) + std::to_string(aTensorDesc.GetType()) +
-                     std::to_string(tensorOp);
+    auto network_config = NetworkConfig{} << bTensorDesc.GetType() << aTensorDesc.GetType()
+                                          << tensorOp;
 
+    OpTensorLaunch launch;
+    std::string algorithm;
     visit_float(bTensorDesc.GetType(), [&](auto as_float) {
 
-        auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
-        auto miopen_alpha1 = as_float(*(static_cast<const float*>(alpha1)));
-        auto miopen_beta   = as_float(*(static_cast<const float*>(beta)));
+        auto miopen_alpha0 = as_float(alpha0);
+        auto miopen_alpha1 = as_float(alpha1);
+        auto miopen_beta   = as_float(beta);
 
         if(clens[0] == 1 && blens[0] == 1 && alens[0] == 1 &&
            (blens[1] == clens[1] || blens[1] == 1) && blens[2] == clens[2])
         {
 
-            network_config += std::to_string(clens[2]) + std::to_string(clens[1]) +
-                              std::to_string(float_equal(miopen_beta, 0.0)) +
-                              std::to_string(static_cast<int>(blens[1] == 1)) +
-                              std::to_string(max_num_wg);
-
-            auto&& kernels = handle.GetKernels("Op2dTensorLite", network_config);
+            network_config << clens[2] << clens[1] << float_equal(miopen_beta, 0.0)
+                           << (blens[1] == 1) << max_num_wg;
 
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
-
-                kernel(ATensor,
+            algorithm = "Op2dTensorLite";
+            launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                kernel(args.A,
                        int(astrides[1]), // a_cstride,
-                       BTensor,
+                       args.B,
                        int(bstrides[1]), // b_cstride,
-                       CTensor,
+                       args.C,
                        int(cstrides[1]), // c_cstride,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
+                       as_float(args.alpha0),
+                       as_float(args.alpha1),
+                       as_float(args.beta),
+                       args.Aoffset,
+                       args.Boffset,
+                       args.Coffset,
                        int(clens[1]));
-
-                return;
-            }
+            };
         }
         else if(blens[0] == 1 && clens[0] == 1 && clens[1] == 1 && blens[2] == clens[2])
         {
-            network_config += std::to_string(clens[2]) + "x" + std::to_string(clens[1]) + "x" +
-                              std::to_string(float_equal(miopen_alpha0, 0.0)) + "x" +
-                              std::to_string(float_equal(miopen_alpha1, 0.0)) + "x" +
-                              std::to_string(float_equal(miopen_beta, 0.0)) + "x" +
-                              std::to_string(max_num_wg);
+            network_config << clens[2] << clens[1] << float_equal(miopen_alpha0, 0.0)
+                           << float_equal(miopen_alpha1, 0.0) << float_equal(miopen_beta, 0.0)
+                           << max_num_wg;
 
-            auto&& kernels = handle.GetKernels("Op2dTensorSquash", network_config);
-
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
-
-                kernel(ATensor,
-                       BTensor,
+            algorithm = "Op2dTensorSquash";
+            launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                kernel(args.A,
+                       args.B,
                        int(blens[1]),    // b_c,
                        int(bstrides[1]), // b_cstride,
-                       CTensor,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset));
-
-                return;
-            }
+                       args.C,
+                       as_float(args.alpha0),
+                       as_float(args.alpha1),
+                       as_float(args.beta),
+                       args.Aoffset,
+                       args.Boffset,
+                       args.Coffset);
+            };
         }
         else
         {
 
-            network_config +=
-                std::to_string(max_num_wg) + std::to_string(local_threads) + std::to_string(num_wg);
-
-            auto&& kernels = handle.GetKernels("Op3dTensorGeneric", network_config);
+            network_config << max_num_wg << local_threads << num_wg;
 
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
-
-                kernel(ATensor,
+            algorithm = "Op3dTensorGeneric";
+            launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                kernel(args.A,
                        int(astrides[0]), // a_nstride,
                        int(astrides[1]), // a_cstride,
-                       BTensor,
+                       args.B,
                        int(blens[1]),    // b_c,
                        int(blens[2]),    // b_h,
                        int(bstrides[0]), // b_nstride,
                        int(bstrides[1]), // b_cstride,
-                       CTensor,
+                       args.C,
                        int(clens[1]),    // c_c,
                        int(clens[2]),    // c_h,
                        int(cstrides[0]), // c_nstride,
                        int(cstrides[1]), // c_cstride,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
+                       as_float(args.alpha0),
+                       as_float(args.alpha1),
+                       as_float(args.beta),
                        bitmap,
                        work_per_wg,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
+                       args.Aoffset,
+                       args.Boffset,
+                       args.Coffset,
                        int(num_wg_orig));
-
-                return;
-            }
+            };
         }
 
+        if(handle.HasKernel(algorithm, network_config))
+            return;
+
         std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType());
 
         parms += GetDataTypeKernelParams(aTensorDesc.GetType());
@@ -331,20 +316,7 @@ void OpTensor3d(Handle& handle,
             const std::vector<size_t> vgd1{MAP_RD, static_cast<size_t>(num_wg), 1};
 
             handle.AddKernel(
-                "Op2dTensorLite", network_config, program_name, "Op2dTensorLite", vld, vgd1, parms)(
-                ATensor,
-                int(astrides[1]), // a_cstride,
-                BTensor,
-                int(bstrides[1]), // b_cstride,
-                CTensor,
-                int(cstrides[1]), // c_cstride,
-                miopen_alpha0,
-                miopen_alpha1,
-                miopen_beta,
-                long(Aoffset),
-                long(Boffset),
-                long(Coffset),
-                int(clens[1]));
+                "Op2dTensorLite", network_config, program_name, "Op2dTensorLite", vld, vgd1, parms);
         }
         else if(blens[0] == 1 && clens[0] == 1 && clens[1] == 1 && blens[2] == clens[2])
         {
@@ -385,17 +357,7 @@ void OpTensor3d(Handle& handle,
                              "Op2dTensorSquash",
                              vld,
                              vgd1,
-                             parms)(ATensor,
-                                    BTensor,
-                                    int(blens[1]),    // b_c,
-                                    int(bstrides[1]), // b_cstride,
-                                    CTensor,
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset));
+                             parms);
         }
         else
         {
@@ -413,55 +375,33 @@ void OpTensor3d(Handle& handle,
                              "Op3dTensorGeneric",
                              vld,
                              vgd,
-                             parms)(ATensor,
-                                    int(astrides[0]), // a_nstride,
-                                    int(astrides[1]), // a_cstride,
-                                    BTensor,
-                                    int(blens[1]),    // b_c,
-                                    int(blens[2]),    // b_h,
-                                    int(bstrides[0]), // b_nstride,
-                                    int(bstrides[1]), // b_cstride,
-                                    CTensor,
-                                    int(clens[1]),    // c_c,
-                                    int(clens[2]),    // c_h,
-                                    int(cstrides[0]), // c_nstride,
-                                    int(cstrides[1]), // c_cstride,
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
+                             parms);
         }
     });
+
+    if(!launch.run)
+        return launch;
+    launch.kernel = GetOpTensorKernel(handle, algorithm, network_config);
+    return launch;
 }
 
-void OpTensor4d(Handle& handle,
-                miopenTensorOp_t tensorOp,
-                const void* alpha0,
-                const TensorDescriptor& aTensorDesc,
-                ConstData_t ATensor,
-                const void* alpha1,
-                const TensorDescriptor& bTensorDesc,
-                ConstData_t BTensor,
-                const void* beta,
-                const TensorDescriptor& cTensorDesc,
-                Data_t CTensor,
-                const size_t Aoffset,
-                const size_t Boffset,
-                const size_t Coffset)
+static OpTensorLaunch OpTensor4d(Handle& handle,
+                                 miopenTensorOp_t tensorOp,
+                                 float /*alpha0*/,
+                                 const TensorDescriptor& aTensorDesc,
+                                 float /*alpha1*/,
+                                 const TensorDescriptor& bTensorDesc,
+                                 float beta,
+                                 const TensorDescriptor& cTensorDesc)
 {
-    auto blens = bTensorDesc.GetLengths();
-    auto clens = cTensorDesc.GetLengths();
-    auto dims  = clens.size();
+    const auto& blens = bTensorDesc.GetLengths();
+    const auto& clens = cTensorDesc.GetLengths();
+    auto dims         = clens.size();
 
-    auto astrides = aTensorDesc.GetStrides();
-    auto bstrides = bTensorDesc.GetStrides();
-    auto bsize    = blens.size();
-    auto cstrides = cTensorDesc.GetStrides();
+    const auto& astrides = aTensorDesc.GetStrides();
+    const auto& bstrides = bTensorDesc.GetStrides();
+    auto bsize           = blens.size();
+    const auto& cstrides = cTensorDesc.GetStrides();
 
     // first_not_one is incorrect if btensor size equal to 1
     auto first_not_one = std::find_if(blens.rbegin(), blens.rend(), [](int i) { return i != 1; });
@@ -519,9 +459,7 @@ void OpTensor4d(Handle& handle,
         local_threads = 64;
     }
 
-    std::string network_config{};
-
-    network_config += GetDataType(bTensorDesc.GetType()) + std::to_string(max_num_wg);
+    auto network_config = NetworkConfig{} << max_num_wg;
 
     std::string program_name = "MIOpenTensorKernels.cl";
 
@@ -550,203 +488,179 @@ void OpTensor4d(Handle& handle,
     printf("equal_tensor: %d\n", bTensorDesc.GetElementSize() == cTensorDesc.GetElementSize());
 #endif
 
-    network_config += std::to_string(bTensorDesc.GetType()) +
-                      std::to_string(aTensorDesc.GetType()) + std::to_string(tensorOp) +
-                      std::to_string(global_threads) + std::to_string(local_threads);
+    network_config << bTensorDesc.GetType() << aTensorDesc.GetType() << tensorOp << global_threads
+                   << local_threads;
 
+    OpTensorLaunch launch;
+    std::string algorithm;
     visit_float(bTensorDesc.GetType(), [&](auto as_float) {
 
-        auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
-        auto miopen_alpha1 = as_float(*(static_cast<const float*>(alpha1)));
-        auto miopen_beta   = as_float(*(static_cast<const float*>(beta)));
+        auto miopen_beta = as_float(beta);
 
         if(fwd_conv_bias != 0)
         {
-            network_config += std::to_string(incr_wg);
+            network_config << incr_wg;
 
             if(packed_tensor)
             {
-                auto&& kernels = handle.GetKernels("OpTensorFwdBias", network_config);
-
-                if(!kernels.empty())
-                {
-                    auto kernel = kernels.front();
-                    kernel(ATensor,
-                           BTensor,
+                algorithm = "OpTensorFwdBias";
+                launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                    kernel(args.A,
+                           args.B,
                            int(blens[1]),
-                           CTensor,
+                           args.C,
                            int(clens[0]),
                            int(cstrides[0]),
                            int(cstrides[1]),
                            work_per_wg,
-                           miopen_alpha0,
-                           miopen_alpha1,
-                           miopen_beta,
-                           long(Aoffset),
-                           long(Boffset),
-                           long(Coffset),
+                           as_float(args.alpha0),
+                           as_float(args.alpha1),
+                           as_float(args.beta),
+                           args.Aoffset,
+                           args.Boffset,
+                           args.Coffset,
                            int(num_wg_orig));
-
-                    return;
-                }
+                };
             }
             else
             {
 
-                auto&& kernels = handle.GetKernels("OpTensorFwdBiasGeneric", network_config);
-
-                if(!kernels.empty())
-                {
-                    auto kernel = kernels.front();
-                    kernel(ATensor,
+                algorithm = "OpTensorFwdBiasGeneric";
+                launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                    kernel(args.A,
                            int(astrides[0]),
                            int(astrides[1]),
                            int(astrides[2]),
-                           BTensor,
+                           args.B,
                            int(blens[1]),
                            int(bstrides[1]),
-                           CTensor,
+                           args.C,
                            int(clens[0]),
                            int(clens[3]),
                            int(cstrides[0]),
                            int(cstrides[1]),
                            int(cstrides[2]),
-                           miopen_alpha0,
-                           miopen_alpha1,
-                           miopen_beta,
+                           as_float(args.alpha0),
+                           as_float(args.alpha1),
+                           as_float(args.beta),
                            work_per_wg,
-                           long(Aoffset),
-                           long(Boffset),
-                           long(Coffset),
+                           args.Aoffset,
+                           args.Boffset,
+                           args.Coffset,
                            int(num_wg_orig));
-                    return;
-                }
+                };
             }
         }
         // precede leading_ones for bitmap = 1,1,1,1
         else if(packed_equal_tensor)
         {
-            network_config += std::to_string(bTensorDesc.GetElementSize()) +
-                              std::to_string(float_equal(miopen_beta, 0.0));
-            auto&& kernels = handle.GetKernels("Op4dTensorLite", network_config);
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
-                kernel(ATensor,
-                       BTensor,
-                       CTensor,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset));
-                return;
-            }
+            network_config << bTensorDesc.GetElementSize() << float_equal(miopen_beta, 0.0);
+            algorithm = "Op4dTensorLite";
+            launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                kernel(args.A,
+                       args.B,
+                       args.C,
+                       as_float(args.alpha0),
+                       as_float(args.alpha1),
+                       as_float(args.beta),
+                       args.Aoffset,
+                       args.Boffset,
+                       args.Coffset);
+            };
         }
         else if(leading_ones)
         {
-            network_config += std::to_string(d - 1);
+            network_config << (d - 1);
             if(packed_tensor)
             {
 
-                auto&& kernels = handle.GetKernels("OpTensorLeadingOnes", network_config);
-
-                if(!kernels.empty())
-                {
-                    auto kernel = kernels.front();
-                    kernel(ATensor,
-                           BTensor,
-                           CTensor,
+                algorithm = "OpTensorLeadingOnes";
+                launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                    kernel(args.A,
+                           args.B,
+                           args.C,
                            int(clens[1]),
                            int(clens[2]),
                            int(clens[3]),
                            int(cstrides[0]),
                            int(cstrides[1]),
                            work_per_wg,
-                           miopen_alpha0,
-                           miopen_alpha1,
-                           miopen_beta,
-                           long(Aoffset),
-                           long(Boffset),
-                           long(Coffset),
+                           as_float(args.alpha0),
+                           as_float(args.alpha1),
+                           as_float(args.beta),
+                           args.Aoffset,
+                           args.Boffset,
+                           args.Coffset,
                            int(num_wg_orig));
-
-                    return;
-                }
+                };
             }
             else
             {
-                auto&& kernels = handle.GetKernels("OpTensorLeadingOnesGeneric", network_config);
-
-                if(!kernels.empty())
-                {
-                    auto kernel = kernels.front();
-                    kernel(ATensor,
+                algorithm = "OpTensorLeadingOnesGeneric";
+                launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                    kernel(args.A,
                            int(astrides[0]),
                            int(astrides[1]),
                            int(astrides[2]),
-                           BTensor,
+                           args.B,
                            int(bstrides[0]),
                            int(bstrides[1]),
                            int(bstrides[2]),
-                           CTensor,
+                           args.C,
                            int(clens[1]),
                            int(clens[2]),
                            int(clens[3]),
                            int(cstrides[0]),
                            int(cstrides[1]),
                            int(cstrides[2]),
-                           miopen_alpha0,
-                           miopen_alpha1,
-                           miopen_beta,
+                           as_float(args.alpha0),
+                           as_float(args.alpha1),
+                           as_float(args.beta),
                            work_per_wg,
-                           long(Aoffset),
-                           long(Boffset),
-                           long(Coffset),
+                           args.Aoffset,
+                           args.Boffset,
+                           args.Coffset,
                            int(num_wg_orig));
-                    return;
-                }
+                };
             }
         }
         else
         {
-            auto&& kernels = handle.GetKernels("Op4dTensorGeneric", network_config);
-
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
-                kernel(ATensor,
+            algorithm = "Op4dTensorGeneric";
+            launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                kernel(args.A,
                        int(astrides[0]), // a_nstride,
                        int(astrides[1]), // a_cstride,
                        int(astrides[2]), // a_hstride,
-                       BTensor,
+                       args.B,
                        int(blens[1]),    // b_c,
                        int(blens[2]),    // b_h,
                        int(blens[3]),    // b_w,
                        int(bstrides[0]), // b_nstride,
                        int(bstrides[1]), // b_cstride,
                        int(bstrides[2]), // b_hstride,
-                       CTensor,
+                       args.C,
                        int(clens[1]),    // c_c,
                        int(clens[2]),    // c_h,
                        int(clens[3]),    // c_w,
                        int(cstrides[0]), // c_nstride,
                        int(cstrides[1]), // c_cstride,
                        int(cstrides[2]), // c_hstride,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
+                       as_float(args.alpha0),
+                       as_float(args.alpha1),
+                       as_float(args.beta),
                        bitmap,
                        work_per_wg,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
+                       args.Aoffset,
+                       args.Boffset,
+                       args.Coffset,
                        int(num_wg_orig));
-                return;
-            }
+            };
         }
 
+        if(handle.HasKernel(algorithm, network_config))
+            return;
+
         std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
                             " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
 
@@ -775,21 +689,7 @@ void OpTensor4d(Handle& handle,
                                  "OpTensorFwdBias",
                                  vld,
                                  vgd,
-                                 parms)(ATensor,
-                                        BTensor,
-                                        int(blens[1]),
-                                        CTensor,
-                                        int(clens[0]),
-                                        int(cstrides[0]),
-                                        int(cstrides[1]),
-                                        work_per_wg,
-                                        miopen_alpha0,
-                                        miopen_alpha1,
-                                        miopen_beta,
-                                        long(Aoffset),
-                                        long(Boffset),
-                                        long(Coffset),
-                                        int(num_wg_orig));
+                                 parms);
             }
             else
             {
@@ -800,27 +700,7 @@ void OpTensor4d(Handle& handle,
                                  "OpTensorFwdBiasGeneric",
                                  vld,
                                  vgd,
-                                 parms)(ATensor,
-                                        int(astrides[0]),
-                                        int(astrides[1]),
-                                        int(astrides[2]),
-                                        BTensor,
-                                        int(blens[1]),
-                                        int(bstrides[1]),
-                                        CTensor,
-                                        int(clens[0]),
-                                        int(clens[3]),
-                                        int(cstrides[0]),
-                                        int(cstrides[1]),
-                                        int(cstrides[2]),
-                                        miopen_alpha0,
-                                        miopen_alpha1,
-                                        miopen_beta,
-                                        work_per_wg,
-                                        long(Aoffset),
-                                        long(Boffset),
-                                        long(Coffset),
-                                        int(num_wg_orig));
+                                 parms);
             }
         }
         // precede leading_ones for bitmap = 1,1,1,1
@@ -848,16 +728,7 @@ void OpTensor4d(Handle& handle,
             const std::vector<size_t> vgd1{TENS_LEN / RD_BLCK, 1, 1};
 
             handle.AddKernel(
-                "Op4dTensorLite", network_config, program_name, "Op4dTensorLite", vld, vgd1, parms)(
-                ATensor,
-                BTensor,
-                CTensor,
-                miopen_alpha0,
-                miopen_alpha1,
-                miopen_beta,
-                long(Aoffset),
-                long(Boffset),
-                long(Coffset));
+                "Op4dTensorLite", network_config, program_name, "Op4dTensorLite", vld, vgd1, parms);
         }
         else if(leading_ones)
         {
@@ -871,22 +742,7 @@ void OpTensor4d(Handle& handle,
                                  "OpTensorLeadingOnes",
                                  vld,
                                  vgd,
-                                 parms)(ATensor,
-                                        BTensor,
-                                        CTensor,
-                                        int(clens[1]),
-                                        int(clens[2]),
-                                        int(clens[3]),
-                                        int(cstrides[0]),
-                                        int(cstrides[1]),
-                                        work_per_wg,
-                                        miopen_alpha0,
-                                        miopen_alpha1,
-                                        miopen_beta,
-                                        long(Aoffset),
-                                        long(Boffset),
-                                        long(Coffset),
-                                        int(num_wg_orig));
+                                 parms);
             }
             else
             {
@@ -899,29 +755,7 @@ void OpTensor4d(Handle& handle,
                                  "OpTensorLeadingOnesGeneric",
                                  vld,
                                  vgd,
-                                 parms)(ATensor,
-                                        int(astrides[0]),
-                                        int(astrides[1]),
-                                        int(astrides[2]),
-                                        BTensor,
-                                        int(bstrides[0]),
-                                        int(bstrides[1]),
-                                        int(bstrides[2]),
-                                        CTensor,
-                                        int(clens[1]),
-                                        int(clens[2]),
-                                        int(clens[3]),
-                                        int(cstrides[0]),
-                                        int(cstrides[1]),
-                                        int(cstrides[2]),
-                                        miopen_alpha0,
-                                        miopen_alpha1,
-                                        miopen_beta,
-                                        work_per_wg,
-                                        long(Aoffset),
-                                        long(Boffset),
-                                        long(Coffset),
-                                        int(num_wg_orig));
+                                 parms);
             }
         }
         else
@@ -934,59 +768,32 @@ void OpTensor4d(Handle& handle,
                              "Op4dTensorGeneric",
                              vld,
                              vgd,
-                             parms)(ATensor,
-                                    int(astrides[0]), // a_nstride,
-                                    int(astrides[1]), // a_cstride,
-                                    int(astrides[2]), // a_hstride,
-                                    BTensor,
-                                    int(blens[1]),    // b_c,
-                                    int(blens[2]),    // b_h,
-                                    int(blens[3]),    // b_w,
-                                    int(bstrides[0]), // b_nstride,
-                                    int(bstrides[1]), // b_cstride,
-                                    int(bstrides[2]), // b_hstride,
-                                    CTensor,
-                                    int(clens[1]),    // c_c,
-                                    int(clens[2]),    // c_h,
-                                    int(clens[3]),    // c_w,
-                                    int(cstrides[0]), // c_nstride,
-                                    int(cstrides[1]), // c_cstride,
-                                    int(cstrides[2]), // c_hstride,
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
+                             parms);
         }
     });
+
+    if(!launch.run)
+        return launch;
+    launch.kernel = GetOpTensorKernel(handle, algorithm, network_config);
+    return launch;
 }
 
-void OpTensorOther(Handle& handle,
-                   miopenTensorOp_t tensorOp,
-                   const void* alpha0,
-                   const TensorDescriptor& aTensorDesc,
-                   ConstData_t ATensor,
-                   const void* alpha1,
-                   const TensorDescriptor& bTensorDesc,
-                   ConstData_t BTensor,
-                   const void* beta,
-                   const TensorDescriptor& cTensorDesc,
-                   Data_t CTensor,
-                   const size_t Aoffset,
-                   const size_t Boffset,
-                   const size_t Coffset)
+static OpTensorLaunch OpTensorOther(Handle& handle,
+                                    miopenTensorOp_t tensorOp,
+                                    float /*alpha0*/,
+                                    const TensorDescriptor& aTensorDesc,
+                                    float /*alpha1*/,
+                                    const TensorDescriptor& bTensorDesc,
+                                    float /*beta*/,
+                                    const TensorDescriptor& cTensorDesc)
 {
-    auto blens = bTensorDesc.GetLengths();
-    auto clens = cTensorDesc.GetLengths();
+    const auto& blens = bTensorDesc.GetLengths();
+    const auto& clens = cTensorDesc.GetLengths();
 
-    auto astrides = aTensorDesc.GetStrides();
-    auto bstrides = bTensorDesc.GetStrides();
-    auto bsize    = blens.size();
-    auto cstrides = cTensorDesc.GetStrides();
+    const auto& astrides = aTensorDesc.GetStrides();
+    const auto& bstrides = bTensorDesc.GetStrides();
+    auto bsize           = blens.size();
+    const auto& cstrides = cTensorDesc.GetStrides();
 
     // first_not_one is incorrect if btensor size equal to 1
     auto first_not_one = std::find_if(blens.rbegin(), blens.rend(), [](int i) { return i != 1; });
@@ -1028,30 +835,23 @@ void OpTensorOther(Handle& handle,
 
     const std::vector<size_t> vgd{global_threads, 1, 1};
 
-    std::string network_config{};
-    network_config += std::to_string(bTensorDesc.GetType()) +
-                      std::to_string(aTensorDesc.GetType()) + std::to_string(tensorOp) +
-                      std::to_string(global_threads) + std::to_string(local_threads);
+    auto network_config = NetworkConfig{} << bTensorDesc.GetType() << aTensorDesc.GetType()
+                                          << tensorOp << global_threads << local_threads;
 
+    OpTensorLaunch launch;
+    std::string algorithm;
     visit_float(bTensorDesc.GetType(), [&](auto as_float) {
 
-        auto miopen_alpha0 = as_float(*(static_cast<const float*>(alpha0)));
-        auto miopen_alpha1 = as_float(*(static_cast<const float*>(alpha1)));
-        auto miopen_beta   = as_float(*(static_cast<const float*>(beta)));
-
         if(bsize == 5)
         {
-            auto&& kernels = handle.GetKernels("Op5dTensorGeneric", network_config);
-
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
-                kernel(ATensor,
+            algorithm = "Op5dTensorGeneric";
+            launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                kernel(args.A,
                        int(astrides[0]),
                        int(astrides[1]),
                        int(astrides[2]),
                        int(astrides[3]),
-                       BTensor,
+                       args.B,
                        int(blens[1]),    // b_c,
                        int(blens[2]),    // b_d,
                        int(blens[3]),    // b_h,
@@ -1060,7 +860,7 @@ void OpTensorOther(Handle& handle,
                        int(bstrides[1]), // b_cstride,
                        int(bstrides[2]), // b_dstride,
                        int(bstrides[3]), // b_hstride,
-                       CTensor,
+                       args.C,
                        int(clens[1]),    // c_c,
                        int(clens[2]),    // c_d,
                        int(clens[3]),    // c_h,
@@ -1069,71 +869,64 @@ void OpTensorOther(Handle& handle,
                        int(cstrides[1]), // c_cstride,
                        int(cstrides[2]), // c_dstride,
                        int(cstrides[3]), // c_hstride,
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
+                       as_float(args.alpha0),
+                       as_float(args.alpha1),
+                       as_float(args.beta),
                        bitmap,
                        work_per_wg,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
+                       args.Aoffset,
+                       args.Boffset,
+                       args.Coffset,
                        int(num_wg_orig));
-                return;
-            }
+            };
         }
         else if(bsize == 2)
         {
-            auto&& kernels = handle.GetKernels("Op2dTensorGeneric", network_config);
-
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
-                kernel(ATensor,
+            algorithm = "Op2dTensorGeneric";
+            launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                kernel(args.A,
                        int(astrides[0]),
-                       BTensor,
+                       args.B,
                        int(blens[1]),
                        int(bstrides[0]),
-                       CTensor,
+                       args.C,
                        int(clens[1]),
                        int(cstrides[0]),
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
+                       as_float(args.alpha0),
+                       as_float(args.alpha1),
+                       as_float(args.beta),
                        bitmap,
                        work_per_wg,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
+                       args.Aoffset,
+                       args.Boffset,
+                       args.Coffset,
                        int(num_wg_orig));
-                return;
-            }
+            };
         }
         else if(bsize == 1)
         {
-            auto&& kernels = handle.GetKernels("Op1dTensorGeneric", network_config);
-
-            if(!kernels.empty())
-            {
-
-                auto kernel = kernels.front();
-                kernel(ATensor,
-                       BTensor,
+            algorithm = "Op1dTensorGeneric";
+            launch.run = [=](const KernelInvoke& kernel, const OpTensorArgs& args) {
+                kernel(args.A,
+                       args.B,
                        int(blens[0]),
-                       CTensor,
+                       args.C,
                        int(clens[0]),
-                       miopen_alpha0,
-                       miopen_alpha1,
-                       miopen_beta,
+                       as_float(args.alpha0),
+                       as_float(args.alpha1),
+                       as_float(args.beta),
                        bitmap,
                        work_per_wg,
-                       long(Aoffset),
-                       long(Boffset),
-                       long(Coffset),
+                       args.Aoffset,
+                       args.Boffset,
+                       args.Coffset,
                        int(num_wg_orig));
-                return;
-            }
+            };
         }
 
+        if(handle.HasKernel(algorithm, network_config))
+            return;
+
         std::string parms = " -DMIOPEN_TYPE=" + GetDataType(bTensorDesc.GetType()) +
                             " -DMAX_NUM_WG=" + std::to_string(max_num_wg);
 
@@ -1158,38 +951,7 @@ void OpTensorOther(Handle& handle,
                              "Op5dTensorGeneric",
                              vld,
                              vgd,
-                             parms)(ATensor,
-                                    int(astrides[0]),
-                                    int(astrides[1]),
-                                    int(astrides[2]),
-                                    int(astrides[3]),
-                                    BTensor,
-                                    int(blens[1]),    // b_c,
-                                    int(blens[2]),    // b_d,
-                                    int(blens[3]),    // b_h,
-                                    int(blens[4]),    // b_w,
-                                    int(bstrides[0]), // b_nstride,
-                                    int(bstrides[1]), // b_cstride,
-                                    int(bstrides[2]), // b_dstride,
-                                    int(bstrides[3]), // b_hstride,
-                                    CTensor,
-                                    int(clens[1]),    // c_c,
-                                    int(clens[2]),    // c_d,
-                                    int(clens[3]),    // c_h,
-                                    int(clens[4]),    // c_w,
-                                    int(cstrides[0]), // c_nstride,
-                                    int(cstrides[1]), // c_cstride,
-                                    int(cstrides[2]), // c_dstride,
-                                    int(cstrides[3]), // c_hstride,
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
+                             parms);
         }
         else if(bsize == 2)
         {
@@ -1201,23 +963,7 @@ void OpTensorOther(Handle& handle,
                              "Op2dTensorGeneric",
                              vld,
                              vgd,
-                             parms)(ATensor,
-                                    int(astrides[0]),
-                                    BTensor,
-                                    int(blens[1]),
-                                    int(bstrides[0]),
-                                    CTensor,
-                                    int(clens[1]),
-                                    int(cstrides[0]),
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
+                             parms);
         }
         else if(bsize == 1)
         {
@@ -1229,23 +975,58 @@ void OpTensorOther(Handle& handle,
                              "Op1dTensorGeneric",
                              vld,
                              vgd,
-                             parms)(ATensor,
-                                    BTensor,
-                                    int(blens[0]),
-                                    CTensor,
-                                    int(clens[0]),
-                                    miopen_alpha0,
-                                    miopen_alpha1,
-                                    miopen_beta,
-                                    bitmap,
-                                    work_per_wg,
-                                    long(Aoffset),
-                                    long(Boffset),
-                                    long(Coffset),
-                                    int(num_wg_orig));
+                             parms);
         }
 
     });
+
+    if(!launch.run)
+        return launch;
+    launch.kernel = GetOpTensorKernel(handle, algorithm, network_config);
+    return launch;
+}
+
+OpTensorKey::OpTensorKey(miopenTensorOp_t op_,
+                         const TensorDescriptor& a_,
+                         const TensorDescriptor& b_,
+                         const TensorDescriptor& c_,
+                         unsigned zero_scalars_)
+    : op(op_), a(a_), b(b_), c(c_), zero_scalars(zero_scalars_)
+{
+    hash = 14695981039346656037ULL;
+    for(std::size_t v : {static_cast<std::size_t>(op), a.GetHash(), b.GetHash(), c.GetHash()})
+        hash = (hash ^ v) * 1099511628211ULL;
+    hash = (hash ^ zero_scalars) * 1099511628211ULL;
+}
+
+constexpr std::size_t OpTensorLaunchCache::Capacity;
+
+OpTensorLaunchCache::OpTensorLaunchCache(OpTensorLaunchCache&& other) noexcept
+{
+    std::lock_guard<std::mutex> lock(other.mutex);
+    launches = std::move(other.launches);
+}
+
+std::shared_ptr<const OpTensorLaunch> OpTensorLaunchCache::Find(const OpTensorKey& key) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = launches.find(key);
+    return it == launches.end() ? nullptr : it->second;
+}
+
+void OpTensorLaunchCache::Insert(const OpTensorKey& key, OpTensorLaunch launch)
+{
+    auto memoized = std::make_shared<const OpTensorLaunch>(std::move(launch));
+    std::lock_guard<std::mutex> lock(mutex);
+    if(launches.size() >= Capacity && launches.count(key) == 0)
+        launches.erase(launches.begin());
+    launches[key] = std::move(memoized);
+}
+
+std::size_t OpTensorLaunchCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return launches.size();
 }
 
 void OpTensor(Handle& handle,
@@ -1268,6 +1049,31 @@ void OpTensor(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm);
     }
 
+    const OpTensorArgs args = {ATensor,
+                               BTensor,
+                               CTensor,
+                               *(static_cast<const float*>(alpha0)),
+                               *(static_cast<const float*>(alpha1)),
+                               *(static_cast<const float*>(beta)),
+                               static_cast<long>(Aoffset),
+                               static_cast<long>(Boffset),
+                               static_cast<long>(Coffset)};
+
+    // The kernels are specialized on which scalars are zero after conversion to the tensor type
+    unsigned zero_scalars = 0;
+    visit_float(bTensorDesc.GetType(), [&](auto as_float) {
+        zero_scalars = (float_equal(as_float(args.alpha0), 0.0) ? 1u : 0u) |
+                       (float_equal(as_float(args.alpha1), 0.0) ? 2u : 0u) |
+                       (float_equal(as_float(args.beta), 0.0) ? 4u : 0u);
+    });
+
+    const OpTensorKey key{tensorOp, aTensorDesc, bTensorDesc, cTensorDesc, zero_scalars};
+    if(const auto memoized = handle.op_tensor_launches.Find(key))
+    {
+        memoized->run(handle.Run(memoized->kernel), args);
+        return;
+    }
+
     // if(aTensorDesc != cTensorDesc)
     if(aTensorDesc.GetElementSize() != cTensorDesc.GetElementSize())
     {
@@ -1279,7 +1085,7 @@ void OpTensor(Handle& handle,
         MIOPEN_THROW("Datatypes for B and C tensors do not match !");
     }
 
-    auto blens = bTensorDesc.GetLengths();
+    const auto& blens = bTensorDesc.GetLengths();
 #if(MIO_TENSOROCL_DEBUG == 1)
     printf("blen:[");
     for(auto len : blens)
@@ -1288,7 +1094,7 @@ void OpTensor(Handle& handle,
     }
     printf("]\n");
 #endif
-    auto clens = cTensorDesc.GetLengths();
+    const auto& clens = cTensorDesc.GetLengths();
 
     if(clens.size() > 5)
     {
@@ -1315,58 +1121,48 @@ void OpTensor(Handle& handle,
         }
     }
 
+    OpTensorLaunch launch;
     auto bsize = blens.size();
     if(bsize == 3)
     {
-        OpTensor3d(handle,
-                   tensorOp,
-                   alpha0,
-                   aTensorDesc,
-                   ATensor,
-                   alpha1,
-                   bTensorDesc,
-                   BTensor,
-                   beta,
-                   cTensorDesc,
-                   CTensor,
-                   Aoffset,
-                   Boffset,
-                   Coffset);
+        launch = OpTensor3d(handle,
+                            tensorOp,
+                            args.alpha0,
+                            aTensorDesc,
+                            args.alpha1,
+                            bTensorDesc,
+                            args.beta,
+                            cTensorDesc);
     }
     else if(bsize == 4)
     {
-        OpTensor4d(handle,
-                   tensorOp,
-                   alpha0,
-                   aTensorDesc,
-                   ATensor,
-                   alpha1,
-                   bTensorDesc,
-                   BTensor,
-                   beta,
-                   cTensorDesc,
-                   CTensor,
-                   Aoffset,
-                   Boffset,
-                   Coffset);
+        launch = OpTensor4d(handle,
+                            tensorOp,
+                            args.alpha0,
+                            aTensorDesc,
+                            args.alpha1,
+                            bTensorDesc,
+                            args.beta,
+                            cTensorDesc);
     }
     else
     {
-        OpTensorOther(handle,
-                      tensorOp,
-                      alpha0,
-                      aTensorDesc,
-                      ATensor,
-                      alpha1,
-                      bTensorDesc,
-                      BTensor,
-                      beta,
-                      cTensorDesc,
-                      CTensor,
-                      Aoffset,
-                      Boffset,
-                      Coffset);
+        launch = OpTensorOther(handle,
+                               tensorOp,
+                               args.alpha0,
+                               aTensorDesc,
+                               args.alpha1,
+                               bTensorDesc,
+                               args.beta,
+                               cTensorDesc);
     }
+
+    // Shapes no kernel handles are a no-op and are not remembered
+    if(!launch.run)
+        return;
+
+    launch.run(handle.Run(launch.kernel), args);
+    handle.op_tensor_launches.Insert(key, std::move(launch));
 }
 
 struct two_exp_ceiling_t
@@ -1388,7 +1184,7 @@ struct two_exp_ceiling_t
     }
 };
 
-static std::vector<std::size_t> get_worker_sizes(const std::vector<std::size_t>& data_sizes)
+static std::vector<std::size_t> get_worker_sizes(const TensorDims& data_sizes)
 {
     const std::size_t dim = data_sizes.size();
 
@@ -1443,10 +1239,11 @@ void SetTensor(
 
     const miopenDataType_t dataType = yDesc_flat.GetType();
 
-    std::string network_config = "set " + std::to_string(dataType);
+    NetworkConfig network_config{"set"};
+    network_config << dataType;
     for(auto& len : yDesc_flat.GetLengths())
     {
-        network_config += " " + std::to_string(len);
+        network_config << len;
     }
 
     auto&& kernels = handle.GetKernels(kernel_name, network_config);
@@ -1604,12 +1401,13 @@ void ScaleTensor(
 
     std::string kernel_name = "SubTensorOpWithScalar" + std::to_string(yDim_flat) + "d";
 
-    const std::vector<std::size_t>& lens = yDesc_flat.GetLengths();
+    const auto& lens = yDesc_flat.GetLengths();
 
-    std::string network_config = "scale " + std::to_string(yDesc_flat.GetType());
+    NetworkConfig network_config{"scale"};
+    network_config << yDesc_flat.GetType();
     for(auto& len : lens)
     {
-        network_config += " " + std::to_string(len);
+        network_config << len;
     }
 
     auto&& kernels = handle.GetKernels(kernel_name, network_config);
@@ -1784,12 +1582,13 @@ void CopyTensor(Handle& handle,
     {
         std::string kernel_name = "SubTensorOpWithSubTensor" + std::to_string(srcDim_flat) + "d";
 
-        const std::vector<std::size_t>& lens = srcDesc_flat.GetLengths();
+        const auto& lens = srcDesc_flat.GetLengths();
 
-        std::string network_config = "copy " + std::to_string(srcDesc_flat.GetType());
+        NetworkConfig network_config{"copy"};
+        network_config << srcDesc_flat.GetType();
         for(auto& len : lens)
         {
-            network_config += " " + std::to_string(len);
+            network_config << len;
         }
 
         auto&& kernels = handle.GetKernels(kernel_name, network_config);
@@ -1988,12 +1787,13 @@ void CastTensor(Handle& handle,
     {
         std::string kernel_name = "SubTensorOpWithCastTensor" + std::to_string(srcDim_flat) + "d";
 
-        const std::vector<std::size_t>& lens = srcDesc_flat.GetLengths();
+        const auto& lens = srcDesc_flat.GetLengths();
 
-        std::string network_config = "cast " + std::to_string(dstDesc_flat.GetType());
+        NetworkConfig network_config{"cast"};
+        network_config << dstDesc_flat.GetType();
         for(auto& len : lens)
         {
-            network_config += " " + std::to_string(len);
+            network_config << len;
         }
 
         auto&& kernels = handle.GetKernels(kernel_name, network_config);
@@ -2307,12 +2107,13 @@ void TransformTensor(Handle& handle,
 
         std::string kernel_name = "SubTensorOpWithTransform" + std::to_string(yDim_flat) + "d";
 
-        const std::vector<std::size_t>& lens = yDesc_flat.GetLengths();
+        const auto& lens = yDesc_flat.GetLengths();
 
-        std::string network_config = "transform " + std::to_string(yDesc_flat.GetType());
+        NetworkConfig network_config{"transform"};
+        network_config << yDesc_flat.GetType();
         for(auto& len : lens)
         {
-            network_config += "x" + std::to_string(len);
+            network_config << len;
         }
 
         auto&& kernels = handle.GetKernels(kernel_name, network_config);
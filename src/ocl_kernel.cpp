@@ -26,6 +26,7 @@
 #include <miopen/oclkernel.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/trace.hpp>
 
 namespace miopen {
 
@@ -49,6 +50,7 @@ static std::string DimToFormattedString(const size_t* dims, size_t count)
 
 void OCLKernelInvoke::run() const
 {
+    MIOPEN_TRACE_SCOPE(Launch, trace::Intern(GetName()));
 #ifndef NDEBUG
     MIOPEN_LOG_I2("kernel_name = " << GetName() << ", work_dim = " << work_dim
                                    << ", global_work_offset = "
@@ -87,6 +89,35 @@ void OCLKernelInvoke::run() const
     }
 }
 
+void OCLKernelInvoke::Record(const OCLCapturedArgs& args) const
+{
+    auto invoke    = *this;
+    invoke.capture = nullptr;
+    auto layout    = args.layout;
+
+    capture->Record(
+        [invoke, layout](void* data, std::size_t) {
+            for(std::size_t idx = 0; idx < layout.size(); idx++)
+            {
+                const auto offset = layout[idx].first;
+                const auto size   = layout[idx].second;
+                const auto value =
+                    offset == OCLCapturedArgs::npos ? nullptr : static_cast<char*>(data) + offset;
+                cl_int status = clSetKernelArg(invoke.kernel.get(), idx, size, value);
+                if(status != CL_SUCCESS)
+                {
+                    MIOPEN_THROW("Error setting argument #" + std::to_string(idx) +
+                                 " to kernel (size = " + std::to_string(size) + "): " +
+                                 OpenCLErrorMessage(status));
+                }
+            }
+            invoke.run();
+        },
+        args.data.data(),
+        args.data.size(),
+        args.pointer_offsets);
+}
+
 std::string OCLKernelInvoke::GetName() const
 {
     std::array<char, 200> buffer{};
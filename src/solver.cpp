@@ -57,190 +57,238 @@ std::ostream& operator<<(std::ostream& os, const ConvSolution& s)
     return os;
 }
 
-struct IdRegistryData
+namespace {
+
+using SolverInstanceGetter = const AnySolver& (*)();
+
+template <class TSolver>
+const AnySolver& SolverInstance()
 {
-    std::unordered_map<uint64_t, std::string> value_to_str;
-    std::unordered_map<std::string, uint64_t> str_to_value;
-    std::unordered_map<uint64_t, AnySolver> value_to_solver;
-    std::unordered_map<uint64_t, miopenConvAlgorithm_t> value_to_algo;
+    static const AnySolver instance = TSolver{};
+    return instance;
+}
+
+struct IdRegistryEntry
+{
+    const char* str;
+    miopenConvAlgorithm_t algo;
+    SolverInstanceGetter solver;
 };
 
-struct SolverRegistrar
+constexpr IdRegistryEntry Entry(const char* str, miopenConvAlgorithm_t algo)
+{
+    return {str, algo, nullptr};
+}
+
+template <class TSolver>
+constexpr IdRegistryEntry Entry(const char* str, miopenConvAlgorithm_t algo)
 {
-    SolverRegistrar(IdRegistryData& registry);
+    return {str, algo, &SolverInstance<TSolver>};
+}
+
+constexpr IdRegistryEntry RemovedEntry() { return {nullptr, miopenConvolutionAlgoDirect, nullptr}; }
+
+// Id value of a solver is its position in this table plus one, 0 is reserved for invalid value.
+// When solver gets removed its entry should be replaced with RemovedEntry() to keep backwards
+// compatibility. New solvers should only be added to the end of list unless it is intended to
+// reuse an id of a removed solver.
+//
+// Names must match SolverDbId() of the corresponding solver, this is checked by test/solver_id.cpp.
+// clang-format off
+constexpr IdRegistryEntry id_registry[] = {
+    Entry<ConvAsm3x3U>("ConvAsm3x3U", miopenConvolutionAlgoDirect),
+    Entry<ConvAsm1x1U>("ConvAsm1x1U", miopenConvolutionAlgoDirect),
+    Entry<ConvAsm1x1UV2>("ConvAsm1x1UV2", miopenConvolutionAlgoDirect),
+    Entry<ConvBiasActivAsm1x1U>("ConvBiasActivAsm1x1U", miopenConvolutionAlgoDirect),
+    Entry<ConvAsm5x10u2v2f1>("ConvAsm5x10u2v2f1", miopenConvolutionAlgoDirect),
+    Entry<ConvAsm5x10u2v2b1>("ConvAsm5x10u2v2b1", miopenConvolutionAlgoDirect),
+    Entry<ConvAsm7x7c3h224w224k64u2v2p3q3f1>("ConvAsm7x7c3h224w224k64u2v2p3q3f1", miopenConvolutionAlgoDirect),
+    Entry<ConvOclDirectFwd11x11>("ConvOclDirectFwd11x11", miopenConvolutionAlgoDirect),
+    Entry<ConvOclDirectFwdGen>("ConvOclDirectFwdGen", miopenConvolutionAlgoDirect),
+    Entry<ConvOclDirectFwd3x3>("ConvOclDirectFwd3x3", miopenConvolutionAlgoDirect),
+    Entry<ConvOclDirectFwd>("ConvOclDirectFwd", miopenConvolutionAlgoDirect),
+    Entry<ConvOclDirectFwdFused>("ConvOclDirectFwdFused", miopenConvolutionAlgoDirect),
+    Entry<ConvOclDirectFwd1x1>("ConvOclDirectFwd1x1", miopenConvolutionAlgoDirect),
+    Entry<ConvBinWinograd3x3U>("ConvBinWinograd3x3U", miopenConvolutionAlgoWinograd),
+    Entry<ConvBinWinogradRxS>("ConvBinWinogradRxS", miopenConvolutionAlgoWinograd),
+    Entry<ConvAsmBwdWrW3x3>("ConvAsmBwdWrW3x3", miopenConvolutionAlgoDirect),
+    Entry<ConvAsmBwdWrW1x1>("ConvAsmBwdWrW1x1", miopenConvolutionAlgoDirect),
+    Entry<ConvOclBwdWrW2<1>>("ConvOclBwdWrW2<1>", miopenConvolutionAlgoDirect),
+    Entry<ConvOclBwdWrW2<2>>("ConvOclBwdWrW2<2>", miopenConvolutionAlgoDirect),
+    Entry<ConvOclBwdWrW2<4>>("ConvOclBwdWrW2<4>", miopenConvolutionAlgoDirect),
+    Entry<ConvOclBwdWrW2<8>>("ConvOclBwdWrW2<8>", miopenConvolutionAlgoDirect),
+    Entry<ConvOclBwdWrW2<16>>("ConvOclBwdWrW2<16>", miopenConvolutionAlgoDirect),
+    Entry<ConvOclBwdWrW2NonTunable>("ConvOclBwdWrW2NonTunable", miopenConvolutionAlgoDirect),
+    Entry<ConvOclBwdWrW53>("ConvOclBwdWrW53", miopenConvolutionAlgoDirect),
+    Entry<ConvOclBwdWrW1x1>("ConvOclBwdWrW1x1", miopenConvolutionAlgoDirect),
+    Entry<ConvHipImplicitGemmV4R1Fwd>("ConvHipImplicitGemmV4R1Fwd", miopenConvolutionAlgoImplicitGEMM),
+    Entry<ConvHipImplicitGemmV4Fwd>("ConvHipImplicitGemmV4Fwd", miopenConvolutionAlgoImplicitGEMM),
+    Entry<ConvHipImplicitGemmV4_1x1>("ConvHipImplicitGemmV4_1x1", miopenConvolutionAlgoImplicitGEMM),
+    Entry<ConvHipImplicitGemmV4R4FwdXdlops>("ConvHipImplicitGemmV4R4FwdXdlops", miopenConvolutionAlgoImplicitGEMM),
+    Entry<ConvHipImplicitGemmV4R4Xdlops_1x1>("ConvHipImplicitGemmV4R4Xdlops_1x1", miopenConvolutionAlgoImplicitGEMM),
+    Entry<ConvHipImplicitGemmV4R1WrW>("ConvHipImplicitGemmV4R1WrW", miopenConvolutionAlgoImplicitGEMM),
+    Entry<ConvHipImplicitGemmV4WrW>("ConvHipImplicitGemmV4WrW", miopenConvolutionAlgoImplicitGEMM),
+
+    // Several ids w/o solver for immediate mode
+    Entry("gemm", miopenConvolutionAlgoGEMM),
+    Entry("fft", miopenConvolutionAlgoFFT),
+    Entry<ConvWinograd3x3MultipassWrW<3, 4>>("ConvWinograd3x3MultipassWrW<3-4>", miopenConvolutionAlgoWinograd),
+#if MIOPEN_USE_SCGEMM
+    Entry<ConvSCGemmFGemm>("ConvSCGemmFGemm", miopenConvolutionAlgoStaticCompiledGEMM),
+#else
+    RemovedEntry(), // Id for ConvSCGemmFGemm.
+#endif
+    Entry<ConvBinWinogradRxSf3x2>("ConvBinWinogradRxSf3x2", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<3, 5>>("ConvWinograd3x3MultipassWrW<3-5>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<3, 6>>("ConvWinograd3x3MultipassWrW<3-6>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<3, 2>>("ConvWinograd3x3MultipassWrW<3-2>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<3, 3>>("ConvWinograd3x3MultipassWrW<3-3>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<7, 2>>("ConvWinograd3x3MultipassWrW<7-2>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<7, 3>>("ConvWinograd3x3MultipassWrW<7-3>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<7, 2, 1, 1>>("ConvWinograd3x3MultipassWrW<7-2-1-1>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<7, 3, 1, 1>>("ConvWinograd3x3MultipassWrW<7-3-1-1>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<1, 1, 7, 2>>("ConvWinograd3x3MultipassWrW<1-1-7-2>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<1, 1, 7, 3>>("ConvWinograd3x3MultipassWrW<1-1-7-3>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<5, 3>>("ConvWinograd3x3MultipassWrW<5-3>", miopenConvolutionAlgoWinograd),
+    Entry<ConvWinograd3x3MultipassWrW<5, 4>>("ConvWinograd3x3MultipassWrW<5-4>", miopenConvolutionAlgoWinograd),
 };
+// clang-format on
 
-static auto& IdRegistry()
+constexpr std::size_t id_registry_size = sizeof(id_registry) / sizeof(id_registry[0]);
+
+constexpr bool StrEqual(const char* lhs, const char* rhs)
 {
-    static auto data            = IdRegistryData{};
-    static const auto registrar = SolverRegistrar{data};
-    (void)registrar; // clang-tidy
-    return data;
+    while(*lhs != '\0' && *lhs == *rhs)
+    {
+        ++lhs;
+        ++rhs;
+    }
+    return *lhs == *rhs;
 }
 
-Id::Id(uint64_t value_) : value(value_)
+constexpr bool HasDuplicateNames()
 {
-    is_valid = (IdRegistry().value_to_str.find(value) != IdRegistry().value_to_str.end());
+    for(std::size_t i = 0; i < id_registry_size; ++i)
+    {
+        if(id_registry[i].str == nullptr)
+            continue;
+        for(std::size_t j = i + 1; j < id_registry_size; ++j)
+            if(id_registry[j].str != nullptr && StrEqual(id_registry[i].str, id_registry[j].str))
+                return true;
+    }
+    return false;
 }
 
-Id::Id(const std::string& str) : Id(str.c_str()) {}
+static_assert(!HasDuplicateNames(), "Registered duplicate solver ids");
+
+// Name to id lookup is done via a perfect hash which is built at compile time: a seed for FNV-1a
+// is chosen so that every registered name lands in a distinct slot of the table.
+constexpr std::size_t name_table_size = 1024;
+constexpr uint64_t max_name_seed      = 256;
 
-Id::Id(const char* str)
+static_assert(id_registry_size < 256, "Name table slots are 8-bit");
+
+constexpr std::size_t NameSlot(const char* str, uint64_t seed)
 {
-    const auto it = IdRegistry().str_to_value.find(str);
-    is_valid      = (it != IdRegistry().str_to_value.end());
-    value         = is_valid ? it->second : invalid_value;
+    uint64_t hash = 14695981039346656037ULL ^ seed;
+    for(; *str != '\0'; ++str)
+    {
+        hash ^= static_cast<unsigned char>(*str);
+        hash *= 1099511628211ULL;
+    }
+    return hash % name_table_size;
 }
 
-std::string Id::ToString() const
+constexpr bool IsPerfectNameSeed(uint64_t seed)
 {
-    if(!IsValid())
-        return "INVALID_SOLVER_ID_" + std::to_string(value);
-    return IdRegistry().value_to_str[value];
+    bool used[name_table_size] = {};
+    for(std::size_t i = 0; i < id_registry_size; ++i)
+    {
+        if(id_registry[i].str == nullptr)
+            continue;
+        const auto slot = NameSlot(id_registry[i].str, seed);
+        if(used[slot])
+            return false;
+        used[slot] = true;
+    }
+    return true;
 }
 
-AnySolver Id::GetSolver() const
+constexpr uint64_t FindPerfectNameSeed()
 {
-    const auto it = IdRegistry().value_to_solver.find(value);
-    return it != IdRegistry().value_to_solver.end() ? it->second : AnySolver{};
+    for(uint64_t seed = 0; seed < max_name_seed; ++seed)
+        if(IsPerfectNameSeed(seed))
+            return seed;
+    return max_name_seed;
 }
 
-std::string Id::GetAlgo(miopenConvDirection_t dir) const
+constexpr uint64_t name_seed = FindPerfectNameSeed();
+static_assert(name_seed < max_name_seed, "Unable to build perfect hash of solver names");
+
+struct NameTable
 {
-    const auto it = IdRegistry().value_to_algo.find(value);
-    if(it == IdRegistry().value_to_algo.end())
-        MIOPEN_THROW(miopenStatusInternalError);
+    // 0 stands for an empty slot, otherwise id value of the solver.
+    uint8_t values[name_table_size];
+};
 
-    return ConvolutionAlgoToDirectionalString(it->second, dir);
+constexpr NameTable MakeNameTable()
+{
+    NameTable table{};
+    for(std::size_t i = 0; i < id_registry_size; ++i)
+        if(id_registry[i].str != nullptr)
+            table.values[NameSlot(id_registry[i].str, name_seed)] = static_cast<uint8_t>(i + 1);
+    return table;
 }
 
-inline bool Register(IdRegistryData& registry,
-                     uint64_t value,
-                     const std::string& str,
-                     miopenConvAlgorithm_t algo)
+constexpr NameTable name_table = MakeNameTable();
+
+constexpr uint64_t FindValue(const char* str)
 {
-    if(value == Id::invalid_value)
-    {
-        MIOPEN_LOG_E(Id::invalid_value << " is special id value for invalid solver (" << str
-                                       << ")");
-        return false;
-    }
+    const uint64_t value = name_table.values[NameSlot(str, name_seed)];
+    if(value == Id::invalid_value || !StrEqual(id_registry[value - 1].str, str))
+        return Id::invalid_value;
+    return value;
+}
 
-    if(registry.value_to_str.find(value) != registry.value_to_str.end())
-    {
-        MIOPEN_LOG_E("Registered duplicate ids: [" << value << "]" << str << " and ["
-                                                   << registry.value_to_str.find(value)->first
-                                                   << "]"
-                                                   << registry.value_to_str.find(value)->second);
-        return false;
-    }
+static_assert(FindValue("gemm") != Id::invalid_value && FindValue("fft") != Id::invalid_value,
+              "Immediate mode ids are not registered");
 
-    if(registry.str_to_value.find(str) != registry.str_to_value.end())
-    {
-        MIOPEN_LOG_E("Registered duplicate ids: [" << value << "]" << str << " and ["
-                                                   << registry.str_to_value.find(str)->second
-                                                   << "]"
-                                                   << registry.str_to_value.find(str)->first);
-        return false;
-    }
+constexpr const IdRegistryEntry* FindEntry(uint64_t value)
+{
+    if(value == Id::invalid_value || value > id_registry_size)
+        return nullptr;
+    const auto& entry = id_registry[value - 1];
+    return entry.str != nullptr ? &entry : nullptr;
+}
 
-    registry.value_to_str.emplace(value, str);
-    registry.str_to_value.emplace(str, value);
-    registry.value_to_algo.emplace(value, algo);
-    return true;
+} // namespace
+
+Id::Id(uint64_t value_) : value(value_), is_valid(FindEntry(value_) != nullptr) {}
+
+Id::Id(const std::string& str) : Id(str.c_str()) {}
+
+Id::Id(const char* str) : value(FindValue(str)), is_valid(value != invalid_value) {}
+
+std::string Id::ToString() const
+{
+    if(!IsValid())
+        return "INVALID_SOLVER_ID_" + std::to_string(value);
+    return FindEntry(value)->str;
 }
 
-template <class TSolver>
-inline void
-RegisterWithSolver(IdRegistryData& registry, uint64_t value, TSolver, miopenConvAlgorithm_t algo)
-{
-    if(Register(registry, value, SolverDbId(TSolver{}), algo))
-        registry.value_to_solver.emplace(value, TSolver{});
-}
-
-inline SolverRegistrar::SolverRegistrar(IdRegistryData& registry)
-{
-    // When solver gets removed its registration line should be replaced with ++id to keep
-    // backwards compatibility. New solvers should only be added to the end of list unless it is
-    // intended to reuse an id of a removed solver.
-
-    uint64_t id = 0; // 0 is reserved for invalid value.
-    RegisterWithSolver(registry, ++id, ConvAsm3x3U{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsm1x1U{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsm1x1UV2{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvBiasActivAsm1x1U{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsm5x10u2v2f1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsm5x10u2v2b1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(
-        registry, ++id, ConvAsm7x7c3h224w224k64u2v2p3q3f1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwd11x11{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwdGen{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwd3x3{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwd{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwdFused{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclDirectFwd1x1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvBinWinograd3x3U{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(registry, ++id, ConvBinWinogradRxS{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(registry, ++id, ConvAsmBwdWrW3x3{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvAsmBwdWrW1x1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<1>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<2>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<4>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<8>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2<16>{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW2NonTunable{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW53{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(registry, ++id, ConvOclBwdWrW1x1{}, miopenConvolutionAlgoDirect);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4R1Fwd{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4Fwd{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4_1x1{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4R4FwdXdlops{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4R4Xdlops_1x1{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4R1WrW{}, miopenConvolutionAlgoImplicitGEMM);
-    RegisterWithSolver(
-        registry, ++id, ConvHipImplicitGemmV4WrW{}, miopenConvolutionAlgoImplicitGEMM);
+AnySolver Id::GetSolver() const
+{
+    const auto entry = FindEntry(value);
+    return entry != nullptr && entry->solver != nullptr ? entry->solver() : AnySolver{};
+}
 
-    // Several ids w/o solver for immediate mode
-    Register(registry, ++id, "gemm", miopenConvolutionAlgoGEMM);
-    Register(registry, ++id, "fft", miopenConvolutionAlgoFFT);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 4>{}, miopenConvolutionAlgoWinograd);
-#if MIOPEN_USE_SCGEMM
-    RegisterWithSolver(registry, ++id, ConvSCGemmFGemm{}, miopenConvolutionAlgoStaticCompiledGEMM);
-#else
-    ++id; // Id for ConvSCGemmFGemm.
-#endif
-    RegisterWithSolver(registry, ++id, ConvBinWinogradRxSf3x2{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 5>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 6>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 2>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<3, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<7, 2>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<7, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<7, 2, 1, 1>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<7, 3, 1, 1>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<1, 1, 7, 2>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<1, 1, 7, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<5, 3>{}, miopenConvolutionAlgoWinograd);
-    RegisterWithSolver(
-        registry, ++id, ConvWinograd3x3MultipassWrW<5, 4>{}, miopenConvolutionAlgoWinograd);
+std::string Id::GetAlgo(miopenConvDirection_t dir) const
+{
+    const auto entry = FindEntry(value);
+    if(entry == nullptr)
+        MIOPEN_THROW(miopenStatusInternalError);
+
+    return ConvolutionAlgoToDirectionalString(entry->algo, dir);
 }
 
 } // namespace solver
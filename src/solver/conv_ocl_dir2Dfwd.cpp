@@ -458,7 +458,8 @@ inline ConvSolution BaseGetSolution(const ConvolutionContext& params,
 }
 
 ConvSolution ConvOclDirectFwd::GetSolution(const ConvolutionContext& params,
-                                           const LegacyPerformanceConfig& searched_params) const
+                                           const LegacyPerformanceConfig& searched_params,
+                                           bool) const
 {
     ConvSolution result = BaseGetSolution(params, searched_params);
 
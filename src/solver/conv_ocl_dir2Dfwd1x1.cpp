@@ -59,7 +59,8 @@ bool ConvOclDirectFwd1x1::IsApplicable(const ConvolutionContext& params) const
 }
 
 ConvSolution ConvOclDirectFwd1x1::GetSolution(const ConvolutionContext& params,
-                                              const LegacyPerformanceConfig& searched_params) const
+                                              const LegacyPerformanceConfig& searched_params,
+                                              bool) const
 {
     ConvSolution result;
     searched_params.CopyTo(result);
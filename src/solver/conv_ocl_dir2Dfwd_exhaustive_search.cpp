@@ -26,8 +26,7 @@
 
 #define MIOPEN
 
-#include <miopen/allocator.hpp>
-#include <miopen/db_path.hpp>
+#include <miopen/generic_search.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/legacy_exhaustive_search.hpp>
 #include <miopen/mlo_utils.hpp>
@@ -36,6 +35,10 @@
 
 #include <half.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+
 #ifdef max
 #undef max
 #endif
@@ -125,94 +128,233 @@ ConvOclDirectFwdLegacyExhaustiveSearch::GetPerformanceConfig(const ConvolutionCo
     return result;
 }
 
-/*
-* Measure the current configuration performance.
-*/
-template <typename Tgpu, class... Solvers>
-static int MeasurePerfConfig(Handle& handle,
-                             ConstData_t bot_ocl_buf,
-                             Data_t top_ocl_buf,
-                             ConstData_t wei_ocl_buf,
-                             ConstData_t bias_ocl_buf,
-                             double& processing_time,
-                             const ConvolutionContext& params,
-                             const LegacyPerformanceConfig& result)
-{
-    ConvSolution kernel_search_result{miopenStatusNotInitialized};
 
-    miopen::each_args(
-        [&](auto s) {
-            if(!kernel_search_result.Succeeded()) // once
-            {
-                if(s.IsApplicable(params))
-                {
-                    if(s.IsValidPerformanceConfig(params, result))
-                    {
-                        kernel_search_result = s.GetSolution(params, result);
-                    }
-                }
-            }
-        },
-        Solvers{}...);
+namespace {
+
+// Values of the "general" part of the search space (ConvOclDirectFwd).
+const std::initializer_list<int> in_tile_values      = {8, 16, 32, 64};
+const std::initializer_list<int> out_pix_tile_values = {1, 2, 4};
+const std::initializer_list<int> n_out_tiles_values  = {1, 2, 4, 8};
+const std::initializer_list<int> n_in_tiles_values   = {1, 2, 4};
+const std::initializer_list<int> n_stacks_values     = {1, 2};
+
+// Values of the "1x1" part of the search space (ConvOclDirectFwd1x1).
+// Both kernel versions are covered, IsValid() selects the relevant ones.
+const std::initializer_list<int> grp_tile0_1x1_values    = {64, 128, 256};
+const std::initializer_list<int> n_out_tiles_1x1_values  = {4, 8, 16, 32, 64};
+const std::initializer_list<int> out_pix_tile0_1x1_value = {0, 1, 2, 4};
+const std::initializer_list<int> n_in_tiles_1x1_values   = {4, 8, 64, 128, 256, 2048};
+const std::initializer_list<int> version_1x1_values      = {0, 1};
 
-    if(!kernel_search_result.Succeeded())
+bool IsIn(const int v, const std::initializer_list<int>& values)
+{
+    return std::find(values.begin(), values.end(), v) != values.end();
+}
+
+/// Sets v to the next value from the list and returns true.
+/// Wraps around to the first value and returns false when the end is reached.
+bool Next(int& v, const std::initializer_list<int>& values)
+{
+    auto it = std::find(values.begin(), values.end(), v);
+    if(it != values.end() && ++it != values.end())
     {
-        return 1;
+        v = *it;
+        return true;
     }
-#if !MIOPEN_ALLOC_BUFFERS
-    if(params.bias && bias_ocl_buf == nullptr)
+    v = *values.begin();
+    return false;
+}
+
+bool Is1x1(const ConvolutionContext& params)
+{
+    // Group conv: None 1x1 version yet, fallback to universal kernel.
+    return params.kernel_size_w == 1 && params.kernel_size_h == 1 && params.group_counts == 1;
+}
+
+bool Is1x1Version1(const ConvolutionContext& params)
+{
+    return params.in_data_type == miopenFloat && params.direction.IsForward() &&
+           params.n_inputs % 16 == 0 && params.n_outputs % 16 == 0;
+}
+
+} // namespace
+
+LegacyPerformanceConfig::LegacyPerformanceConfig(bool)
+    : grp_tile1(8),
+      grp_tile0(8),
+      in_tile1(8),
+      in_tile0(8),
+      out_pix_tile1(1),
+      out_pix_tile0(1),
+      n_out_pix_tiles(1),
+      n_in_data_tiles(1),
+      n_stacks(1)
+{
+}
+
+bool LegacyPerformanceConfig::SetNextValue()
+{
+    if(in_tile0 != 1)
     {
-        MIOPEN_LOG_WE("Legacy search: Bias buffer required");
-        return 2;
+        do
+        {
+            if(Next(n_stacks, n_stacks_values))
+                break;
+            if(Next(n_in_data_tiles, n_in_tiles_values))
+                break;
+            if(Next(n_out_pix_tiles, n_out_tiles_values))
+                break;
+            if(Next(out_pix_tile0, out_pix_tile_values))
+                break;
+            if(Next(out_pix_tile1, out_pix_tile_values))
+                break;
+            if(Next(in_tile0, in_tile_values))
+                break;
+            if(Next(in_tile1, in_tile_values))
+                break;
+            // The general part is over, switch to the 1x1 one.
+            in_tile1        = 1;
+            in_tile0        = 1;
+            grp_tile1       = 1;
+            grp_tile0       = *grp_tile0_1x1_values.begin();
+            out_pix_tile1   = *version_1x1_values.begin();
+            out_pix_tile0   = *out_pix_tile0_1x1_value.begin();
+            n_out_pix_tiles = *n_out_tiles_1x1_values.begin();
+            n_in_data_tiles = *n_in_tiles_1x1_values.begin();
+            n_stacks        = 0;
+            return true;
+        } while(false);
+        grp_tile0 = in_tile0 / out_pix_tile0;
+        grp_tile1 = in_tile1 / out_pix_tile1;
+        return true;
     }
-#endif
 
-    MIOPEN_LOG_I2("Trying " << result);
-    const auto kernel_params     = kernel_search_result.construction_params[0];
-    std::string compiler_options = params.general_compile_options + kernel_params.comp_options;
+    if(Next(n_in_data_tiles, n_in_tiles_1x1_values))
+        return true;
+    if(Next(out_pix_tile0, out_pix_tile0_1x1_value))
+        return true;
+    if(Next(n_out_pix_tiles, n_out_tiles_1x1_values))
+        return true;
+    if(Next(grp_tile0, grp_tile0_1x1_values))
+        return true;
+    if(Next(out_pix_tile1, version_1x1_values))
+        return true;
+    return false;
+}
 
-    try
+bool LegacyPerformanceConfig::IsValid(const ConvolutionContext& params) const
+{
+    if(Is1x1(params))
     {
-        Tgpu padding_value = static_cast<Tgpu>(0);
-        processing_time    = std::numeric_limits<double>::max();
+        if(!(in_tile1 == 1 && in_tile0 == 1 && grp_tile1 == 1 && n_stacks == 0))
+            return false;
 
-        auto k = handle.AddKernel("",
-                                  "",
-                                  kernel_params.kernel_file,
-                                  kernel_params.kernel_name,
-                                  kernel_params.l_wk,
-                                  kernel_params.g_wk,
-                                  compiler_options);
+        if(Is1x1Version1(params))
+        {
+            return out_pix_tile1 == 1 && grp_tile0 == 64 && IsIn(n_out_pix_tiles, {16, 32, 64}) &&
+                   IsIn(out_pix_tile0, {0, 1, 4}) && IsIn(n_in_data_tiles, {64, 128, 256, 2048});
+        }
 
-        if(params.bias)
+        if(!(out_pix_tile1 == 0 && IsIn(grp_tile0, grp_tile0_1x1_values)))
+            return false;
+
+        const int n_out_max =
+            (params.n_outputs % 64 == 0) ? 64 : (params.n_outputs % 32 == 0) ? 32 : 16;
+        if(!(IsIn(n_out_pix_tiles, {4, 8, 16, 32, 64}) && n_out_pix_tiles <= n_out_max))
+            return false;
+
+        int out_pix_tile0_max = 4;
+        if(params.kernel_stride_w == 1)
         {
-            k(bot_ocl_buf, wei_ocl_buf, bias_ocl_buf, top_ocl_buf, padding_value);
+            const int i_sz    = params.in_width * params.in_height;
+            out_pix_tile0_max = (i_sz & 1) != 0 ? 1 : (i_sz & 0x3) != 0 ? 2 : 4;
+        }
+        else if(params.direction.IsForward())
+        {
+            out_pix_tile0_max = (params.out_width & 1) != 0 ? 1 : 2;
         }
         else
         {
-            k(bot_ocl_buf, wei_ocl_buf, top_ocl_buf, padding_value);
+            out_pix_tile0_max =
+                (((params.out_width & 1) != 0) || ((params.in_width & 1) != 0)) ? 1 : 2;
         }
-        processing_time = handle.GetKernelTime();
-    }
-    catch(miopen::Exception& ex)
-    {
-        MIOPEN_LOG_WE("Status: " << ex.status << ", Message: \"" << ex.what() << '\"');
-        return -1;
+        if(!(IsIn(out_pix_tile0, {1, 2, 4}) && out_pix_tile0 <= out_pix_tile0_max))
+            return false;
+        if((n_out_pix_tiles == 32 && out_pix_tile0 >= 4) ||
+           (n_out_pix_tiles == 64 && out_pix_tile0 >= 2))
+            return false;
+
+        return n_in_data_tiles == 4 || (n_in_data_tiles == 8 && params.n_inputs % 8 == 0);
     }
 
-    MIOPEN_LOG_I2("\t\t\t\t" << processing_time);
-    return 0;
+    if(!IsIn(in_tile1, in_tile_values) || !IsIn(in_tile0, in_tile_values))
+        return false;
+    if(params.out_height >= 16 && !IsIn(in_tile1, {16, 32}))
+        return false;
+    if(params.out_width >= 16 && !IsIn(in_tile0, {16, 32}))
+        return false;
+    if(params.out_height * 2 <= in_tile1 && in_tile1 > 8)
+        return false;
+    if(params.out_width * 2 <= in_tile0 && in_tile0 > 8)
+        return false;
+    if(params.out_height > 16 && params.out_width > 16 &&
+       ((in_tile1 == 8 && in_tile0 == 8) || (grp_tile0 == 8 && grp_tile1 == 8)))
+        return false;
+    if(params.out_width > 32 && in_tile1 > in_tile0)
+        return false;
+
+    if(!IsIn(out_pix_tile1, out_pix_tile_values) || !IsIn(out_pix_tile0, out_pix_tile_values))
+        return false;
+    if(out_pix_tile1 > in_tile1 || grp_tile1 != in_tile1 / out_pix_tile1 || grp_tile1 < 8)
+        return false;
+    if(out_pix_tile0 > in_tile0 || grp_tile0 != in_tile0 / out_pix_tile0 || grp_tile0 < 8)
+        return false;
+
+    if(!IsIn(n_out_pix_tiles, n_out_tiles_values) || params.n_outputs < n_out_pix_tiles)
+        return false;
+    if(!IsIn(n_in_data_tiles, n_in_tiles_values) || params.n_inputs < n_in_data_tiles)
+        return false;
+    if(!IsIn(n_stacks, n_stacks_values) || n_stacks > params.batch_sz)
+        return false;
+    if(out_pix_tile1 * out_pix_tile0 * n_out_pix_tiles * n_stacks >= 128)
+        return false;
+
+    return ConvOclDirectFwd{}.IsValidPerformanceConfig(params, *this);
 }
 
-LegacyPerformanceConfig
-ConvOclDirectFwdLegacyExhaustiveSearch::Search(const ConvolutionContext& params) const
+bool LegacyPerformanceConfig::operator==(const LegacyPerformanceConfig& other) const
+{
+    // clang-format off
+    return grp_tile1 == other.grp_tile1
+        && grp_tile0 == other.grp_tile0
+        && in_tile1 == other.in_tile1
+        && in_tile0 == other.in_tile0
+        && out_pix_tile1 == other.out_pix_tile1
+        && out_pix_tile0 == other.out_pix_tile0
+        && n_out_pix_tiles == other.n_out_pix_tiles
+        && n_in_data_tiles == other.n_in_data_tiles
+        && n_stacks == other.n_stacks;
+    // clang-format on
+}
+
+int ConvOclDirectFwdLegacyExhaustiveSearch::RunAndMeasureSolution(miopen::Handle& profile_h,
+                                                                  ConstData_t bot_buf,
+                                                                  Data_t top_buf,
+                                                                  ConstData_t wei_buf,
+                                                                  ConstData_t bias_buf,
+                                                                  const ConvolutionContext& params,
+                                                                  const ConvSolution& solution,
+                                                                  float& elapsed_time) const
 {
     if(params.IsFp16())
-        return SearchImpl<half_float::half>(params);
+        return RunAndMeasureSolutionImpl<half_float::half>(
+            profile_h, bot_buf, top_buf, wei_buf, bias_buf, params, solution, elapsed_time);
     else if(params.IsFp32())
-        return SearchImpl<float>(params);
+        return RunAndMeasureSolutionImpl<float>(
+            profile_h, bot_buf, top_buf, wei_buf, bias_buf, params, solution, elapsed_time);
     else if(params.IsBfp16())
-        return SearchImpl<bfloat16>(params);
+        return RunAndMeasureSolutionImpl<bfloat16>(
+            profile_h, bot_buf, top_buf, wei_buf, bias_buf, params, solution, elapsed_time);
     else
     {
         MIOPEN_THROW("Unsupported float_size");
@@ -220,500 +362,65 @@ ConvOclDirectFwdLegacyExhaustiveSearch::Search(const ConvolutionContext& params)
 }
 
 template <typename Tgpu>
-LegacyPerformanceConfig
-ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& params) const
+int ConvOclDirectFwdLegacyExhaustiveSearch::RunAndMeasureSolutionImpl(
+    miopen::Handle& profile_h,
+    ConstData_t bot_buf,
+    Data_t top_buf,
+    ConstData_t wei_buf,
+    ConstData_t bias_buf,
+    const ConvolutionContext& params,
+    const ConvSolution& solution,
+    float& elapsed_time) const
 {
-    LegacyPerformanceConfig result;
-    bool is_passed = false;
-
-    double processing_time = std::numeric_limits<double>::max();
-
-    LegacyPerformanceConfig candidate;
-    candidate.grp_tile0       = 16;
-    candidate.grp_tile1       = 16;
-    candidate.in_tile0        = 16;
-    candidate.in_tile1        = 16;
-    candidate.out_pix_tile0   = 1;
-    candidate.out_pix_tile1   = 1;
-    candidate.n_out_pix_tiles = 2;
-    candidate.n_in_data_tiles = 3;
-    candidate.n_stacks        = 1;
-
-#if MIOPEN_ALLOC_BUFFERS
-    miopen::Handle profile_h;
-
-    // allocate input/output buffers
-    size_t bot_sz = params.bot_sz / sizeof(Tgpu);
-    std::vector<Tgpu> bot_sys_buf(bot_sz);
-    for(size_t i = 0; i < bot_sz; i++)
-    {
-        bot_sys_buf[i] = static_cast<Tgpu>(rand() * (1.0 / RAND_MAX));
-    }
-    auto bot_ocl_buf = profile_h.Write(bot_sys_buf);
-    auto bot_ocl_ptr = bot_ocl_buf.get();
-
-    size_t top_sz = params.top_sz / sizeof(Tgpu);
-    std::vector<Tgpu> top_sys_buf(top_sz);
-    auto top_ocl_buf = profile_h.Write(top_sys_buf);
-    auto top_ocl_ptr = top_ocl_buf.get();
-
-    size_t weights_sz = params.weights_sz / sizeof(Tgpu);
-    std::vector<Tgpu> wei_sys_buf(weights_sz);
-    for(size_t i = 0; i < weights_sz; i++)
-    {
-        wei_sys_buf[i] = static_cast<Tgpu>((rand() * (1.0 / RAND_MAX) - 0.5) * 0.001);
-    }
-    auto wei_ocl_buf = profile_h.Write(wei_sys_buf);
-    auto wei_ocl_ptr = wei_ocl_buf.get();
-
-    std::vector<Tgpu> bias_sys_buf;
-    miopen::Allocator::ManageDataPtr bias_ocl_buf = nullptr;
-    if(params.bias != 0)
-    {
-        size_t bias_sz = params.bias_sz / sizeof(Tgpu);
-        bias_sys_buf   = std::vector<Tgpu>(bias_sz);
-        for(size_t i = 0; i < bias_sz; i++)
-        {
-            bias_sys_buf[i] = static_cast<Tgpu>(rand() * (1.0 / RAND_MAX));
-        }
+    if(!solution.Succeeded())
+        return 1;
+    assert(!params.bias || bias_buf != nullptr);
 
-        bias_ocl_buf = profile_h.Write(bias_sys_buf);
-    }
-    auto bias_ocl_ptr = bias_ocl_buf.get();
-#else
-    auto& profile_h = params.GetStream();
-    auto bot_ocl_ptr =
-        params.direction.IsForward() ? params.GetBufs().io.fwd.x : params.GetBufs().io.bwd.dy;
-    auto top_ocl_ptr =
-        params.direction.IsForward() ? params.GetBufs().io.fwd.y : params.GetBufs().io.bwd.dx;
-    auto wei_ocl_ptr =
-        params.direction.IsForward() ? params.GetBufs().io.fwd.w : params.GetBufs().io.bwd.w;
-    auto bias_ocl_ptr = params.GetBufs().bias;
+    const KernelInfo k_info = solution.construction_params[0];
+#ifdef NDEBUG
+    try
 #endif
-    AutoEnableProfiling enableProfiling{profile_h};
-
-    // search loop here
-    int grp_tl_ln[4]       = {8, 16, 32};
-    int tile_sz1[4]        = {8, 16, 32, 64};
-    int tile_sz0[4]        = {8, 16, 32, 64};
-    int out_pix_tile_sz[3] = {1, 2, 4};
-    int n_out_tiles_rg[5]  = {1, 2, 4, 8};
-    int n_in_tiles_rg[3]   = {1, 2, 4};
-    int n_in_stacks_sz[2]  = {1, 2};
-    int in_tiles[4]        = {64, 128, 256, 2048};
-
-    double min_proc_time = std::numeric_limits<double>::max();
-
-    size_t run_counter = 0, failed_counter = 0;
-
-    int out_pix_tl_cnt = 3; // out_pix_tile_sz[1];
-    int n_out_tls      = 4;
-    int n_in_tls       = 3;
-    int stack_cnt      = std::min(params.batch_sz, 2);
-    int n_tile0_sz     = 4;
-    int n_tile1_sz     = 4;
-
-    if(params.out_width >= 16)
     {
-        tile_sz0[0] = 16;
-        tile_sz0[1] = 32;
-        n_tile0_sz  = 2;
+        elapsed_time = std::numeric_limits<float>::max();
+        // KernelInfo::comp_options already include ConvolutionContext::general_compile_options.
+        auto kernel = profile_h.AddKernel("",
+                                          "",
+                                          k_info.kernel_file,
+                                          k_info.kernel_name,
+                                          k_info.l_wk,
+                                          k_info.g_wk,
+                                          k_info.comp_options);
+        const auto padding_value = static_cast<Tgpu>(0);
+        if(params.bias)
+            kernel(bot_buf, wei_buf, bias_buf, top_buf, padding_value);
+        else
+            kernel(bot_buf, wei_buf, top_buf, padding_value);
+        elapsed_time = profile_h.GetKernelTime();
     }
-
-    if(params.out_height >= 16)
+#ifdef NDEBUG
+    catch(miopen::Exception& ex)
     {
-        tile_sz1[0] = 16;
-        tile_sz1[1] = 32;
-        n_tile1_sz  = 2;
+        MIOPEN_LOG_WE(ex.what());
+        return -1;
     }
+#endif
+    return 0;
+}
 
-    int n_tiles_cnt = n_tile0_sz * n_tile1_sz;
-
-    size_t report_inteval = 25;
-
-    long long runs_left = 0, total_runs = 0;
-
-    if(params.kernel_size_w == 1 && params.kernel_size_h == 1 &&
-       params.group_counts == 1) // Group conv: None 1x1 version yet, fallback to universal kernel.
+LegacyPerformanceConfig
+ConvOclDirectFwdLegacyExhaustiveSearch::Search(const ConvolutionContext& params) const
+{
+    if(Is1x1(params))
     {
-        MIOPEN_LOG_W("Searching the best solution in the 4 dim space. Please, be patient...");
-        int n_grp_tiles0 = 3;
-        result.grp_tile1 = 1;
-        result.in_tile1  = 1;
-        result.in_tile0  = 1;
-        report_inteval   = 5;
-
-        // Add 1x1_stride : no padding support yet
-        if(params.in_data_type == miopenFloat && params.direction.IsForward() &&
-           params.n_inputs % 16 == 0 && params.n_outputs % 16 == 0)
-        {
-
-            // uint N_LCL_IN_MAPS = result.n_in_data_tiles;
-            n_in_tiles_rg[0] = 0;
-            n_in_tiles_rg[1] = 3;
-            n_in_tls         = 4;
-
-            //					int N_LCL_OUT_MAPS = result.n_out_pix_tiles;
-            n_out_tiles_rg[0] = 4;
-            n_out_tiles_rg[1] = 6;
-            // 0 or 1
-            out_pix_tl_cnt = 3;
-            //					uint CHEAT_SHADER_COMPILER =
-            // result.out_pix_tile0;
-            out_pix_tile_sz[0] = 0;
-            out_pix_tile_sz[1] = 1;
-            n_out_tls          = (n_out_tiles_rg[1] - n_out_tiles_rg[0] + 1);
-            n_grp_tiles0       = 1;
-            grp_tl_ln[0]       = 64;
-
-            runs_left  = out_pix_tl_cnt * n_out_tls * n_in_tls * (n_grp_tiles0 + 1);
-            total_runs = runs_left;
-
-            result.out_pix_tile1 = 1;
-        }
+        if(params.direction.IsForward())
+            return GenericSearchFwd(ConvOclDirectFwd1x1{}, params);
         else
-        {
-            int i_sz = params.in_width * params.in_height;
-            if(params.kernel_stride_w == 1)
-            {
-                out_pix_tl_cnt = (i_sz & 1) != 0 ? 1 : (i_sz & 0x3) != 0 ? 2 : 3;
-            }
-            else
-            {
-                if(params.direction.IsForward())
-                {
-                    out_pix_tl_cnt = (params.out_width & 1) != 0 ? 1 : 2;
-                }
-                else
-                {
-                    out_pix_tl_cnt =
-                        (((params.out_width & 1) != 0) || ((params.in_width & 1) != 0)) ? 1 : 2;
-                }
-            }
-            out_pix_tile_sz[0] = 1;
-            out_pix_tile_sz[1] = 2;
-            out_pix_tile_sz[2] = 4;
-
-            n_out_tiles_rg[0] = 2;
-            n_out_tiles_rg[1] =
-                (params.n_outputs % 64 == 0) ? 6 : (params.n_outputs % 32 == 0) ? 5 : 4;
-
-            n_in_tiles_rg[0] = 2;
-            n_in_tiles_rg[1] = (params.n_inputs % 8 == 0) ? 3 : 2;
-
-            grp_tl_ln[0]     = 64;
-            grp_tl_ln[1]     = 128;
-            grp_tl_ln[2]     = 256;
-            n_grp_tiles0     = 3;
-            int n_grp_tiles1 = 1;
-
-            int n_grp_tiles = n_grp_tiles1 * n_grp_tiles0;
-            n_out_tls       = (n_out_tiles_rg[1] - n_out_tiles_rg[0] + 1);
-            n_in_tls        = 2;
-            runs_left       = n_grp_tiles * out_pix_tl_cnt * n_out_tls * n_in_tls;
-            total_runs      = runs_left;
-
-            result.out_pix_tile1 = 0;
-        }
-
-        int version = result.out_pix_tile1;
-
-        for(int g0 = 0; g0 < n_grp_tiles0; ++g0)
-        {
-            result.grp_tile0 = grp_tl_ln[g0];
-
-            // out pix 0
-            for(int o_t = n_out_tiles_rg[0]; o_t <= n_out_tiles_rg[1]; ++o_t)
-            {
-                result.n_out_pix_tiles = (1 << o_t);
-                for(int l = 0; l < out_pix_tl_cnt; ++l)
-                {
-                    result.out_pix_tile0 = out_pix_tile_sz[l];
-                    if(version == 0 &&
-                       ((result.n_out_pix_tiles == 32 && result.out_pix_tile0 >= 4) ||
-                        (result.n_out_pix_tiles == 64 && result.out_pix_tile0 >= 2)))
-                    {
-                        continue;
-                    }
-
-                    for(int i_t = n_in_tiles_rg[0]; i_t <= n_in_tiles_rg[1]; ++i_t)
-                    {
-                        if(version == 1)
-                        {
-                            result.n_in_data_tiles = in_tiles[i_t];
-                        }
-                        else
-                        {
-                            result.n_in_data_tiles = (1 << i_t);
-                        }
-
-                        const auto ret =
-                            MeasurePerfConfig<Tgpu, ConvOclDirectFwd1x1>(profile_h,
-                                                                         bot_ocl_ptr,
-                                                                         top_ocl_ptr,
-                                                                         wei_ocl_ptr,
-                                                                         bias_ocl_ptr,
-                                                                         processing_time,
-                                                                         params,
-                                                                         result);
-                        --runs_left;
-                        if(ret != 0)
-                        {
-                            ++failed_counter;
-                            continue;
-                        }
-
-                        is_passed = true;
-                        MIOPEN_LOG_T("##(n_current, n_failed, n_runs_total): " << run_counter
-                                                                               << " / "
-                                                                               << failed_counter
-                                                                               << " / "
-                                                                               << total_runs
-                                                                               << " elapsed_time: "
-                                                                               << processing_time
-                                                                               << " best_time: "
-                                                                               << processing_time
-                                                                               << ", "
-                                                                               << result);
-
-                        if(processing_time < min_proc_time)
-                        {
-                            MIOPEN_LOG_I('#' << run_counter << ' ' << processing_time << " < "
-                                             << min_proc_time
-                                             << ' '
-                                             << result);
-                            min_proc_time = processing_time;
-                            candidate     = result;
-                        }
-
-                        if(run_counter % report_inteval == 0)
-                        {
-                            MIOPEN_LOG_W("Runs left: " << runs_left << ", "
-                                                       << "min time so far: "
-                                                       << min_proc_time
-                                                       << ", "
-                                                       << "curr time: "
-                                                       << processing_time
-                                                       << ' '
-                                                       << result);
-                        }
-                        run_counter++;
-                    }
-                }
-            }
-        }
+            return GenericSearchBwd(ConvOclDirectFwd1x1{}, params);
     }
+    if(params.direction.IsForward())
+        return GenericSearchFwd(ConvOclDirectFwd{}, params);
     else
-    {
-        MIOPEN_LOG_W("Searching the best solution in the 9 dim space. Please, be patient...");
-        runs_left = /*n_grp_tiles * */ n_tiles_cnt * out_pix_tl_cnt * out_pix_tl_cnt * n_out_tls *
-                    n_in_tls * stack_cnt;
-        total_runs = runs_left;
-
-        // tile1
-        for(int j = 0; j < n_tile1_sz; ++j)
-        {
-            int tile_sz[3]  = {8, 16, 32};
-            result.in_tile1 = tile_sz1[j];
-            if(params.out_height * 2 <= result.in_tile1 && result.in_tile1 > tile_sz[0])
-            {
-                --runs_left;
-                continue;
-            }
-
-            // tile 0
-            for(int i = 0; i < n_tile0_sz; ++i)
-            {
-                result.in_tile0 = tile_sz0[i];
-                if((params.out_width * 2 <= result.in_tile0 && result.in_tile0 > tile_sz[0]))
-                {
-                    --runs_left;
-                    continue;
-                }
-                if(params.out_height > 16 && params.out_width > 16 &&
-                   ((result.in_tile1 == 8 && result.in_tile0 == 8) ||
-                    (result.grp_tile0 == 8 && result.grp_tile1 == 8)))
-                {
-                    --runs_left;
-                    continue;
-                }
-                if(params.out_width > 32 && result.in_tile1 > result.in_tile0)
-                {
-                    --runs_left;
-                    continue;
-                }
-                // out pix 1
-
-                for(int k = 0; k < out_pix_tl_cnt; ++k)
-                {
-                    result.out_pix_tile1 = out_pix_tile_sz[k];
-                    result.grp_tile1     = result.in_tile1 / result.out_pix_tile1;
-                    if(result.out_pix_tile1 > result.in_tile1 || result.grp_tile1 < 8)
-                    {
-                        --runs_left;
-                        continue;
-                    }
-                    // out pix 0
-
-                    for(int l = 0; l < out_pix_tl_cnt; ++l)
-                    {
-                        result.out_pix_tile0 = out_pix_tile_sz[l];
-                        result.grp_tile0     = result.in_tile0 / result.out_pix_tile0;
-
-                        if(result.out_pix_tile0 > result.in_tile0 || result.grp_tile0 < 8)
-                        {
-                            --runs_left;
-                            continue;
-                        }
-
-                        for(int o_t = 0; o_t < n_out_tls; ++o_t)
-                        {
-                            result.n_out_pix_tiles = n_out_tiles_rg[o_t];
-                            if(params.n_outputs < result.n_out_pix_tiles)
-                            {
-                                --runs_left;
-                                continue;
-                            }
-
-                            for(int i_t = 0; i_t < n_in_tls; ++i_t)
-                            {
-                                result.n_in_data_tiles = n_in_tiles_rg[i_t];
-                                if(params.n_inputs < result.n_in_data_tiles)
-                                {
-                                    --runs_left;
-                                    continue;
-                                }
-
-                                for(int s = 0; s < stack_cnt; ++s)
-                                {
-
-                                    result.n_stacks = n_in_stacks_sz[s];
-                                    if(result.n_stacks > params.batch_sz)
-                                    {
-                                        --runs_left;
-                                        continue;
-                                    }
-
-                                    if(result.out_pix_tile1 * result.out_pix_tile0 *
-                                           result.n_out_pix_tiles * result.n_stacks >=
-                                       128)
-                                    {
-                                        --runs_left;
-                                        continue;
-                                    }
-
-                                    const auto ret =
-                                        MeasurePerfConfig<Tgpu, ConvOclDirectFwd>(profile_h,
-                                                                                  bot_ocl_ptr,
-                                                                                  top_ocl_ptr,
-                                                                                  wei_ocl_ptr,
-                                                                                  bias_ocl_ptr,
-                                                                                  processing_time,
-                                                                                  params,
-                                                                                  result);
-
-                                    --runs_left;
-                                    if(ret != 0)
-                                    {
-                                        ++failed_counter;
-                                        continue;
-                                    }
-
-                                    is_passed = true;
-                                    MIOPEN_LOG_T("##(n_current, n_failed, n_runs_total): "
-                                                 << run_counter
-                                                 << " / "
-                                                 << failed_counter
-                                                 << " / "
-                                                 << total_runs
-                                                 << " elapsed_time: "
-                                                 << processing_time
-                                                 << " best_time: "
-                                                 << processing_time
-                                                 << ", "
-                                                 << result);
-
-                                    if(processing_time < min_proc_time)
-                                    {
-                                        MIOPEN_LOG_I('#' << run_counter << ' ' << processing_time
-                                                         << " < "
-                                                         << min_proc_time
-                                                         << ' '
-                                                         << result);
-                                        min_proc_time = processing_time;
-                                        candidate     = result;
-                                    }
-
-                                    if(run_counter % report_inteval == 0)
-                                    {
-                                        MIOPEN_LOG_W("Runs left: " << runs_left << ", "
-                                                                   << "min time so far: "
-                                                                   << min_proc_time
-                                                                   << ", "
-                                                                   << "curr time: "
-                                                                   << processing_time
-                                                                   << ' '
-                                                                   << result);
-                                    }
-                                    run_counter++;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-    // Compare search results vs. default performance config.
-    {
-        int ret                   = -1;
-        double default_time       = std::numeric_limits<double>::max();
-        const auto default_config = GetPerformanceConfig(params);
-        if(params.kernel_size_w == 1 && params.kernel_size_h == 1 &&
-           params.group_counts ==
-               1) // Group conv: None 1x1 version yet, fallback to universal kernel.
-        {
-            ret = MeasurePerfConfig<Tgpu, ConvOclDirectFwd1x1>(profile_h,
-                                                               bot_ocl_ptr,
-                                                               top_ocl_ptr,
-                                                               wei_ocl_ptr,
-                                                               bias_ocl_ptr,
-                                                               default_time,
-                                                               params,
-                                                               default_config);
-        }
-        else
-        {
-            ret = MeasurePerfConfig<Tgpu, ConvOclDirectFwd>(profile_h,
-                                                            bot_ocl_ptr,
-                                                            top_ocl_ptr,
-                                                            wei_ocl_ptr,
-                                                            bias_ocl_ptr,
-                                                            default_time,
-                                                            params,
-                                                            default_config);
-        }
-        if(ret == 0)
-        {
-            is_passed = true;
-            MIOPEN_LOG_W("Default run, min time so far: " << min_proc_time << ", default time: "
-                                                          << default_time
-                                                          << ' '
-                                                          << default_config);
-            if(min_proc_time > default_time)
-            {
-                MIOPEN_LOG_W("* * * Default time < min time, using default config * * *");
-                min_proc_time = default_time;
-                candidate     = default_config;
-            }
-        }
-        MIOPEN_LOG_W("...Score: " << (default_time / min_proc_time));
-    }
-    result = candidate;
-
-    if(!is_passed)
-        MIOPEN_THROW("Search failed for ConvOclDirectFwdLegacyExhaustiveSearch");
-    return result;
+        return GenericSearchBwd(ConvOclDirectFwd{}, params);
 }
 
 } // namespace solver
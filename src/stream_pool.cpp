@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/stream_pool.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/make_unique.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace miopen {
+
+StreamPool::StreamPool(Backend backend_, std::size_t size) : backend(std::move(backend_))
+{
+    streams.reserve(size);
+    try
+    {
+        for(std::size_t i = 0; i < size; ++i)
+            streams.push_back(backend.create());
+    }
+    catch(...)
+    {
+        for(auto stream : streams)
+            backend.destroy(stream);
+        throw;
+    }
+}
+
+StreamPool::~StreamPool()
+{
+    for(auto stream : streams)
+        backend.destroy(stream);
+}
+
+void StreamPool::Fork(Stream main_, std::size_t branches_)
+{
+    if(forked)
+        MIOPEN_THROW(miopenStatusInternalError, "Stream pool is already forked");
+    forked   = true;
+    main     = main_;
+    active   = main_;
+    branches = std::min(std::max<std::size_t>(branches_, 1), streams.size() + 1);
+    for(std::size_t i = 1; i < branches; ++i)
+        backend.wait(GetBranch(i), main);
+}
+
+void StreamPool::Select(std::size_t index)
+{
+    if(!forked)
+        MIOPEN_THROW(miopenStatusInternalError, "Stream pool is not forked");
+    Activate(GetBranch(index % branches));
+}
+
+void StreamPool::Join()
+{
+    if(!forked)
+        MIOPEN_THROW(miopenStatusInternalError, "Stream pool is not forked");
+    forked = false;
+    Activate(main);
+    for(std::size_t i = 1; i < branches; ++i)
+        backend.wait(main, GetBranch(i));
+}
+
+std::vector<StreamPool::Stream> StreamPool::GetForked() const
+{
+    std::vector<Stream> result;
+    if(forked)
+    {
+        for(std::size_t i = 0; i < branches; ++i)
+            result.push_back(GetBranch(i));
+    }
+    return result;
+}
+
+StreamPool::Stream StreamPool::GetBranch(std::size_t index) const
+{
+    return index == 0 ? main : streams[index - 1];
+}
+
+void StreamPool::Activate(Stream stream)
+{
+    if(stream == active)
+        return;
+    active = stream;
+    if(backend.activate)
+        backend.activate(stream);
+}
+
+void Handle::SetStreamPoolSize(std::size_t size)
+{
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        MIOPEN_THROW(miopenStatusInternalError, "Stream pool can not be resized while forked");
+    stream_pool.reset();
+    if(size > 0)
+        stream_pool = std::make_unique<StreamPool>(GetStreamPoolBackend(), size);
+    MIOPEN_LOG_I2("Stream pool size: " << size);
+}
+
+std::size_t Handle::GetStreamPoolSize() const
+{
+    return stream_pool == nullptr ? 0 : stream_pool->GetSize();
+}
+
+void Handle::Fork(std::size_t branches)
+{
+    // Waits between streams are not recorded, so a replay has to keep the launches in order.
+    if(stream_pool == nullptr || this->IsCapturing())
+        return;
+    stream_pool->Fork(this->GetStream(), branches);
+}
+
+void Handle::SelectBranch(std::size_t index)
+{
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        stream_pool->Select(index);
+}
+
+void Handle::Join()
+{
+    if(stream_pool != nullptr && stream_pool->IsForked())
+        stream_pool->Join();
+}
+
+} // namespace miopen
@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <miopen/errors.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/tensor.hpp>
@@ -33,7 +34,7 @@
 
 namespace miopen {
 
-TensorDescriptor::TensorDescriptor() : packed(true) {}
+TensorDescriptor::TensorDescriptor() : packed(true) { this->UpdateCache(); }
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t, std::initializer_list<std::size_t> plens)
     : lens(plens), packed(true), type(t)
@@ -46,7 +47,7 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
                                    std::initializer_list<std::size_t> pstrides)
     : lens(plens), strides(pstrides), type(t)
 {
-    packed = (this->GetElementSize() == this->GetElementSpace());
+    this->UpdateCache();
 }
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t, const int* plens, int size)
@@ -66,30 +67,50 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
         MIOPEN_THROW("Invalid length. Length must be greater than 0.");
     if(!std::all_of(pstrides, pstrides + size, [](int x) { return x >= 0; }))
         MIOPEN_THROW("Invalid strides. Strides must be greater than 0.");
-    packed = (this->GetElementSize() == this->GetElementSpace());
+    this->UpdateCache();
 }
 
 TensorDescriptor::TensorDescriptor(miopenDataType_t t,
                                    std::vector<std::size_t> lens_in,
                                    std::vector<std::size_t> strides_in)
-    : lens(std::move(lens_in)), strides(std::move(strides_in)), type(t)
+    : lens(lens_in.begin(), lens_in.end()), strides(strides_in.begin(), strides_in.end()), type(t)
 {
-    packed = (this->GetElementSize() == this->GetElementSpace());
+    this->UpdateCache();
 }
 
 void TensorDescriptor::CalculateStrides()
 {
     strides.clear();
     strides.resize(lens.size(), 0);
-    if(strides.empty())
-        return;
-    strides.back() = 1;
-    std::partial_sum(
-        lens.rbegin(), lens.rend() - 1, strides.rbegin() + 1, std::multiplies<std::size_t>());
+    if(!strides.empty())
+    {
+        strides.back() = 1;
+        std::partial_sum(
+            lens.rbegin(), lens.rend() - 1, strides.rbegin() + 1, std::multiplies<std::size_t>());
+    }
+    this->UpdateCache();
 }
 
-const std::vector<std::size_t>& TensorDescriptor::GetLengths() const { return lens; }
-const std::vector<std::size_t>& TensorDescriptor::GetStrides() const { return strides; }
+void TensorDescriptor::UpdateCache()
+{
+    element_size = std::accumulate(
+        lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    packed = (element_size == this->GetElementSpace());
+
+    // FNV-1a over the type and the dimensions
+    std::uint64_t h   = 14695981039346656037ULL;
+    const auto append = [&](std::uint64_t x) { h = (h ^ x) * 1099511628211ULL; };
+    append(type);
+    append(lens.size());
+    for(const auto l : lens)
+        append(l);
+    for(const auto s : strides)
+        append(s);
+    hash = h;
+}
+
+const TensorDims& TensorDescriptor::GetLengths() const { return lens; }
+const TensorDims& TensorDescriptor::GetStrides() const { return strides; }
 int TensorDescriptor::GetSize() const
 {
     assert(lens.size() == strides.size());
@@ -98,8 +119,7 @@ int TensorDescriptor::GetSize() const
 std::size_t TensorDescriptor::GetElementSize() const
 {
     assert(lens.size() == strides.size());
-    return std::accumulate(
-        lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    return element_size;
 }
 miopenDataType_t TensorDescriptor::GetType() const { return this->type; }
 
@@ -111,15 +131,13 @@ std::size_t TensorDescriptor::GetIndex(std::initializer_list<int> l) const
 
 std::size_t TensorDescriptor::GetElementSpace() const
 {
-    std::vector<std::size_t> maxIndices(lens.size());
-    std::transform(lens.begin(),
-                   lens.end(),
-                   std::vector<std::size_t>(lens.size(), 1).begin(),
-                   maxIndices.begin(),
-                   std::minus<std::size_t>());
     return std::inner_product(
-               maxIndices.begin(), maxIndices.end(), strides.begin(), std::size_t{0}) +
-           1;
+        lens.begin(),
+        lens.end(),
+        strides.begin(),
+        std::size_t{1},
+        std::plus<std::size_t>(),
+        [](std::size_t len, std::size_t stride) { return (len - 1) * stride; });
 }
 
 std::size_t TensorDescriptor::GetNumBytes() const
@@ -139,10 +157,13 @@ std::size_t TensorDescriptor::GetNumBytes() const
 
 bool TensorDescriptor::IsPacked() const { return this->packed; }
 
+std::size_t TensorDescriptor::GetHash() const { return this->hash; }
+
 bool TensorDescriptor::operator==(const TensorDescriptor& rhs) const
 {
     assert(this->lens.size() == rhs.strides.size());
-    return this->type == rhs.type && this->lens == rhs.lens && this->strides == rhs.strides;
+    return this->hash == rhs.hash && this->type == rhs.type && this->lens == rhs.lens &&
+           this->strides == rhs.strides;
 }
 
 bool TensorDescriptor::operator!=(const TensorDescriptor& rhs) const { return !(*this == rhs); }
@@ -26,6 +26,7 @@
 
 #include <miopen/tmp_dir.hpp>
 #include <miopen/env.hpp>
+#include <miopen/exec_utils.hpp>
 #include <boost/filesystem.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/logger.hpp>
@@ -34,20 +35,6 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SAVE_TEMP_DIR)
 
 namespace miopen {
 
-void SystemCmd(std::string cmd)
-{
-#ifndef NDEBUG
-    MIOPEN_LOG_I(cmd);
-#endif
-// We shouldn't call system commands
-#ifdef MIOPEN_USE_CLANG_TIDY
-    (void)cmd;
-#else
-    if(std::system(cmd.c_str()) != 0)
-        MIOPEN_THROW("Can't execute " + cmd);
-#endif
-}
-
 TmpDir::TmpDir(std::string prefix)
     : path(boost::filesystem::temp_directory_path() /
            boost::filesystem::unique_path("miopen-" + prefix + "-%%%%-%%%%-%%%%-%%%%"))
@@ -57,9 +44,13 @@ TmpDir::TmpDir(std::string prefix)
 
 void TmpDir::Execute(std::string exe, std::string args)
 {
-    std::string cd  = "cd " + this->path.string() + "; ";
-    std::string cmd = cd + exe + " " + args; // + " > /dev/null";
-    SystemCmd(cmd);
+#ifndef NDEBUG
+    MIOPEN_LOG_I(exe << " " << args);
+#endif
+    exec::Options options;
+    options.working_dir = this->path.string();
+    if(exec::Run(exe, exec::SplitCommandLine(args), options) != 0)
+        MIOPEN_THROW("Can't execute " + exe + " " + args);
 }
 
 TmpDir::~TmpDir()
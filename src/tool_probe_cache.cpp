@@ -0,0 +1,192 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tool_probe_cache.hpp>
+#include <miopen/binary_cache.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+
+/// One line of the file: resolved tool path, probe name, tool size, tool mtime and
+/// the result, separated by tabs.
+struct ProbeRecord
+{
+    std::string tool;
+    std::string probe;
+    std::string size;
+    std::string mtime;
+    std::string result;
+
+    bool IsFor(const ProbeRecord& other) const
+    {
+        return tool == other.tool && probe == other.probe;
+    }
+    bool IsUpToDate(const ProbeRecord& other) const
+    {
+        return IsFor(other) && size == other.size && mtime == other.mtime;
+    }
+};
+
+std::vector<ProbeRecord> ReadRecords(const boost::filesystem::path& file)
+{
+    std::vector<ProbeRecord> records;
+    std::ifstream in(file.string());
+    std::string line;
+    while(std::getline(in, line))
+    {
+        std::istringstream ss(line);
+        ProbeRecord record;
+        if(std::getline(ss, record.tool, '\t') && std::getline(ss, record.probe, '\t') &&
+           std::getline(ss, record.size, '\t') && std::getline(ss, record.mtime, '\t') &&
+           std::getline(ss, record.result))
+            records.push_back(record);
+        else
+            MIOPEN_LOG_W("Ignoring malformed line in " << file.string() << ": " << line);
+    }
+    return records;
+}
+
+void WriteRecords(const boost::filesystem::path& file, const std::vector<ProbeRecord>& records)
+{
+    // Readers do not take the lock for writing, so never show them a partial file.
+    const auto tmp = file.string() + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        for(const auto& r : records)
+            out << r.tool << '\t' << r.probe << '\t' << r.size << '\t' << r.mtime << '\t'
+                << r.result << '\n';
+        if(!out)
+            MIOPEN_THROW("Can't write " + tmp);
+    }
+    boost::filesystem::rename(tmp, file);
+}
+
+std::string RunProbe(const std::string& probe_name, const std::function<std::string()>& probe)
+{
+    try
+    {
+        return probe();
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Probe " << probe_name << " has failed: " << ex.what());
+        return {};
+    }
+}
+
+} // namespace
+
+std::string GetCachedToolProbe(const std::string& tool_path,
+                               const std::string& probe_name,
+                               const std::function<std::string()>& probe)
+{
+    if(IsCacheDisabled())
+        return RunProbe(probe_name, probe);
+    return GetCachedToolProbe(GetCachePath(), tool_path, probe_name, probe);
+}
+
+std::string GetCachedToolProbe(const boost::filesystem::path& directory,
+                               const std::string& tool_path,
+                               const std::string& probe_name,
+                               const std::function<std::string()>& probe)
+{
+    if(tool_path.empty())
+        return RunProbe(probe_name, probe);
+
+    // A tool is often a link into the current installation, which changes on updates
+    // without affecting the link itself.
+    boost::system::error_code ec;
+    const auto resolved = boost::filesystem::canonical(tool_path, ec);
+    if(ec)
+        return RunProbe(probe_name, probe);
+    const auto size = boost::filesystem::file_size(resolved, ec);
+    if(ec)
+        return RunProbe(probe_name, probe);
+    const auto mtime = boost::filesystem::last_write_time(resolved, ec);
+    if(ec)
+        return RunProbe(probe_name, probe);
+
+    const ProbeRecord key{
+        resolved.string(), probe_name, std::to_string(size), std::to_string(mtime), {}};
+    const auto file = directory / "tool_probes.txt";
+
+    try
+    {
+        const std::shared_lock<LockFile> lock(LockFile::Get(LockFilePath(file).c_str()));
+        for(const auto& record : ReadRecords(file))
+        {
+            if(record.IsUpToDate(key))
+            {
+                MIOPEN_LOG_I2("Cached " << probe_name << " of " << tool_path << ": "
+                                        << record.result);
+                return record.result;
+            }
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to read " << file.string() << ": " << ex.what());
+    }
+
+    auto updated   = key;
+    updated.result = RunProbe(probe_name, probe);
+    if(updated.result.empty() || updated.result.find_first_of("\t\n") != std::string::npos)
+        return updated.result;
+
+    try
+    {
+        const std::unique_lock<LockFile> lock(LockFile::Get(LockFilePath(file).c_str()));
+        // Also forget about the tools which are gone.
+        auto records = ReadRecords(file);
+        records.erase(std::remove_if(records.begin(),
+                                     records.end(),
+                                     [&](const ProbeRecord& r) {
+                                         return r.IsFor(key) ||
+                                                !boost::filesystem::exists(r.tool, ec);
+                                     }),
+                      records.end());
+        records.push_back(updated);
+        WriteRecords(file, records);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to write " << file.string() << ": " << ex.what());
+    }
+    return updated.result;
+}
+
+} // namespace miopen
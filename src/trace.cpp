@@ -0,0 +1,353 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/trace.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace miopen {
+namespace trace {
+
+/// Enables tracing, the trace is written to this file at exit.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_FILE)
+
+/// Number of most recent events each thread keeps, rounded up to a power of two.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_BUFFER_EVENTS)
+
+namespace detail {
+
+std::atomic<bool> enabled{false};
+
+} // namespace detail
+
+namespace {
+
+const std::size_t default_buffer_events = std::size_t{1} << 16;
+
+std::uint64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// Event storage the exporter can read while the thread overwrites it. The index is a
+/// sequence lock: it is the number of the event plus one once it is complete and zero while
+/// it is written, so a reader which sees the same index before and after copying the fields
+/// got that event.
+struct Slot
+{
+    std::atomic<std::uint64_t> index{0};
+    std::atomic<std::uint64_t> time{0};
+    std::atomic<std::uint64_t> arg{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<Category> category{Category::Api};
+    std::atomic<Phase> phase{Phase::Instant};
+};
+
+/// Ring of the most recent events of one thread. Only that thread writes it, the head is
+/// the number of events it has recorded.
+struct Buffer
+{
+    Buffer(std::size_t capacity, std::size_t thread_)
+        : events(capacity), mask(capacity - 1), thread(thread_)
+    {
+    }
+
+    std::vector<Slot> events;
+    std::size_t mask;
+    std::size_t thread;
+    std::atomic<std::uint64_t> head{0};
+    /// Events below it were dropped by Clear.
+    std::atomic<std::uint64_t> tail{0};
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    std::unordered_set<std::string> names;
+    const std::uint64_t start = Now();
+};
+
+Registry& GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+std::size_t GetBufferCapacity()
+{
+    const auto requested = Value(MIOPEN_TRACE_BUFFER_EVENTS{});
+    const auto events    = requested == 0 ? default_buffer_events : requested;
+    std::size_t capacity = 1;
+    while(capacity < events)
+        capacity <<= 1;
+    return capacity;
+}
+
+Buffer& GetBuffer()
+{
+    // The registry keeps the buffer alive after the thread exits.
+    thread_local const std::shared_ptr<Buffer> buffer = [] {
+        auto& registry = GetRegistry();
+        const std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.buffers.push_back(
+            std::make_shared<Buffer>(GetBufferCapacity(), registry.buffers.size() + 1));
+        return registry.buffers.back();
+    }();
+    return *buffer;
+}
+
+int GetProcessId()
+{
+#ifdef __linux__
+    return ::getpid();
+#else
+    return 0; // Not implemented.
+#endif
+}
+
+const char* GetCategoryName(Category category)
+{
+    switch(category)
+    {
+    case Category::Api: return "api";
+    case Category::Db: return "db";
+    case Category::SolverApplicable: return "solver.applicable";
+    case Category::SolverSolution: return "solver.solution";
+    case Category::Compile: return "compile";
+    case Category::KernelCache: return "kernel_cache";
+    case Category::Launch: return "launch";
+    }
+    return "unknown";
+}
+
+const char* GetPhaseName(Phase phase)
+{
+    switch(phase)
+    {
+    case Phase::Begin: return "B";
+    case Phase::End: return "E";
+    case Phase::Instant: return "i";
+    }
+    return "i";
+}
+
+void WriteString(std::ostream& os, const char* str)
+{
+    os << '"';
+    for(; *str != '\0'; ++str)
+    {
+        const auto c = *str;
+        if(c == '"' || c == '\\')
+            os << '\\' << c;
+        else if(static_cast<unsigned char>(c) < 0x20)
+            os << ' ';
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+/// Chrome expects microseconds, the nanoseconds are kept as decimals.
+void WriteMicroseconds(std::ostream& os, std::uint64_t ns)
+{
+    const auto fill = os.fill('0');
+    os << ns / 1000 << '.' << std::setw(3) << ns % 1000;
+    os.fill(fill);
+}
+
+/// Events of one thread that are still valid, ends whose begin was overwritten are dropped
+/// so that viewers nest the remaining scopes correctly.
+std::vector<Event> ReadEvents(const Buffer& buffer)
+{
+    const auto capacity = static_cast<std::uint64_t>(buffer.events.size());
+    const auto head     = buffer.head.load(std::memory_order_acquire);
+    const auto oldest   = head > capacity ? head - capacity : 0;
+    const auto first    = std::max(buffer.tail.load(std::memory_order_relaxed), oldest);
+
+    std::vector<Event> events;
+    events.reserve(head - first);
+    for(auto i = first; i < head; ++i)
+    {
+        const auto& slot = buffer.events[i & buffer.mask];
+        if(slot.index.load(std::memory_order_acquire) == i + 1)
+        {
+            const Event event{slot.time.load(std::memory_order_relaxed),
+                              slot.arg.load(std::memory_order_relaxed),
+                              slot.name.load(std::memory_order_relaxed),
+                              slot.category.load(std::memory_order_relaxed),
+                              slot.phase.load(std::memory_order_relaxed)};
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(slot.index.load(std::memory_order_relaxed) == i + 1)
+            {
+                events.push_back(event);
+                continue;
+            }
+        }
+        // The thread has overwritten it meanwhile, and so all the older events.
+        events.clear();
+    }
+
+    std::vector<Event> result;
+    result.reserve(events.size());
+    std::size_t depth = 0;
+    for(const auto& event : events)
+    {
+        if(event.phase == Phase::Begin)
+            ++depth;
+        else if(event.phase == Phase::End)
+        {
+            if(depth == 0)
+                continue;
+            --depth;
+        }
+        result.push_back(event);
+    }
+    return result;
+}
+
+struct ExitExporter
+{
+    ExitExporter()
+    {
+        // Constructing the registry first keeps it alive until the trace is written.
+        GetRegistry();
+        if(GetStringEnv(MIOPEN_TRACE_FILE{}) != nullptr)
+            Enable();
+    }
+
+    ~ExitExporter()
+    {
+        const auto path = GetStringEnv(MIOPEN_TRACE_FILE{});
+        if(path == nullptr)
+            return;
+        std::ofstream file(path);
+        if(!file)
+        {
+            MIOPEN_LOG_E("Failed to write trace to " << path);
+            return;
+        }
+        Export(file);
+    }
+};
+
+const ExitExporter exit_exporter;
+
+} // namespace
+
+void Enable(bool enable) { detail::enabled.store(enable, std::memory_order_relaxed); }
+
+void Record(Category category, Phase phase, const char* name, std::uint64_t arg)
+{
+    auto& buffer    = GetBuffer();
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    auto& slot      = buffer.events[head & buffer.mask];
+    slot.index.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.time.store(Now(), std::memory_order_relaxed);
+    slot.arg.store(arg, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.phase.store(phase, std::memory_order_relaxed);
+    slot.index.store(head + 1, std::memory_order_release);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+const char* Intern(const std::string& name)
+{
+    thread_local std::unordered_map<std::string, const char*> cache;
+    const auto cached = cache.find(name);
+    if(cached != cache.end())
+        return cached->second;
+
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    const auto interned = registry.names.insert(name).first->c_str();
+    cache.emplace(name, interned);
+    return interned;
+}
+
+void Export(std::ostream& os)
+{
+    auto& registry = GetRegistry();
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    {
+        const std::lock_guard<std::mutex> lock(registry.mutex);
+        buffers = registry.buffers;
+    }
+
+    const auto pid = GetProcessId();
+    auto first     = true;
+    os << "{\"traceEvents\":[";
+    for(const auto& buffer : buffers)
+    {
+        for(const auto& event : ReadEvents(*buffer))
+        {
+            const auto time = event.time > registry.start ? event.time - registry.start : 0;
+            os << (first ? "\n" : ",\n") << "{\"name\":";
+            WriteString(os, event.name);
+            os << ",\"cat\":\"" << GetCategoryName(event.category) << "\",\"ph\":\""
+               << GetPhaseName(event.phase) << "\",\"ts\":";
+            WriteMicroseconds(os, time);
+            os << ",\"pid\":" << pid << ",\"tid\":" << buffer->thread;
+            if(event.phase == Phase::Instant)
+                os << ",\"s\":\"t\"";
+            if(event.phase != Phase::Begin)
+                os << ",\"args\":{\"arg\":" << event.arg << '}';
+            os << '}';
+            first = false;
+        }
+    }
+    os << "\n]}\n";
+}
+
+void Clear()
+{
+    auto& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    for(const auto& buffer : registry.buffers)
+        buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+} // namespace trace
+} // namespace miopen
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/workspace_arena.hpp>
+
+#include <algorithm>
+
+namespace miopen {
+
+void Handle::EnableWorkspaceArena(bool enable)
+{
+    workspace_arena.enabled = enable;
+    if(!enable)
+    {
+        workspace_arena.buffer   = nullptr;
+        workspace_arena.capacity = 0;
+    }
+}
+
+bool Handle::IsWorkspaceArenaEnabled() const { return workspace_arena.enabled; }
+
+void Handle::ReserveWorkspace(std::size_t size)
+{
+    if(!workspace_arena.enabled)
+        MIOPEN_THROW(miopenStatusNotInitialized, "Workspace arena is not enabled");
+    if(size <= workspace_arena.capacity)
+        return;
+
+    MIOPEN_LOG_I2("Growing workspace arena from " << workspace_arena.capacity << " to " << size
+                                                  << " bytes");
+    // Free the old buffer first so that both never exist at the same time.
+    workspace_arena.buffer   = nullptr;
+    workspace_arena.capacity = 0;
+    workspace_arena.buffer   = this->Create(size);
+    workspace_arena.capacity = size;
+}
+
+std::size_t Handle::GetWorkspacePeak() const { return workspace_arena.peak; }
+
+Data_t Handle::GetWorkspace(std::size_t size)
+{
+    workspace_arena.peak = std::max(workspace_arena.peak, size);
+    if(size == 0)
+        return nullptr;
+    this->ReserveWorkspace(size);
+    return workspace_arena.buffer.get();
+}
+
+} // namespace miopen
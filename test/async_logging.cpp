@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/logger.hpp>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "test.hpp"
+
+/// Collects std::cerr, writes can be held back to fill the queue of the asynchronous sink.
+struct CapturedLog : std::stringbuf
+{
+    std::streambuf* previous = std::cerr.rdbuf(this);
+    std::mutex mutex;
+    std::condition_variable released;
+    bool blocked = false;
+
+    CapturedLog(const CapturedLog&) = delete;
+    CapturedLog& operator=(const CapturedLog&) = delete;
+    CapturedLog() = default;
+    ~CapturedLog() override { std::cerr.rdbuf(previous); }
+
+    void Block()
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        blocked = true;
+    }
+
+    void Release()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            blocked = false;
+        }
+        released.notify_all();
+    }
+
+    std::string Read()
+    {
+        miopen::LoggingFlush();
+        return str();
+    }
+
+    protected:
+    void WaitUntilReleased()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&] { return !blocked; });
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        WaitUntilReleased();
+        return std::stringbuf::xsputn(s, n);
+    }
+
+    int_type overflow(int_type c) override
+    {
+        WaitUntilReleased();
+        return std::stringbuf::overflow(c);
+    }
+};
+
+std::size_t count(const std::string& str, const std::string& what)
+{
+    std::size_t n = 0;
+    for(auto pos = str.find(what); pos != std::string::npos; pos = str.find(what, pos + 1))
+        ++n;
+    return n;
+}
+
+void logged_function(int first, const std::string& second)
+{
+    MIOPEN_LOG_FUNCTION(first, second);
+}
+
+void check_function_record()
+{
+    miopen::SetLoggingAsync(false);
+    CapturedLog log;
+    logged_function(7, "value");
+    const auto text  = log.Read();
+    const auto begin = text.find("logged_function");
+    EXPECT(begin != std::string::npos);
+    EXPECT(text.find("{\n", begin) < text.find("\tfirst = 7\n", begin));
+    EXPECT(text.find("\tfirst = 7\n", begin) < text.find("\tsecond = value\n", begin));
+    EXPECT(text.find("\tsecond = value\n", begin) < text.find("}\n", begin));
+}
+
+void check_order()
+{
+    const std::size_t threads = 4;
+    const std::size_t records = 200;
+    miopen::SetLoggingAsync(true);
+    EXPECT(miopen::IsLoggingAsync());
+    CapturedLog log;
+    std::vector<std::thread> workers;
+    for(std::size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([=] {
+            for(std::size_t i = 0; i < records; ++i)
+                MIOPEN_LOG_NQI("record " << t << ' ' << i);
+        });
+    }
+    for(auto& worker : workers)
+        worker.join();
+    const auto text = log.Read();
+    miopen::SetLoggingAsync(false);
+
+    // Nothing is dropped while the writer keeps up, which it does not have to.
+    const auto dropped = miopen::LoggingDroppedRecords();
+    EXPECT(count(text, "record ") + dropped == threads * records);
+    for(std::size_t t = 0; t < threads; ++t)
+    {
+        std::size_t last = 0;
+        for(std::size_t i = 0; i < records; ++i)
+        {
+            const auto pos =
+                text.find("record " + std::to_string(t) + ' ' + std::to_string(i) + '\n');
+            if(pos == std::string::npos)
+                continue;
+            EXPECT(pos >= last);
+            last = pos;
+        }
+    }
+}
+
+void check_drops()
+{
+    miopen::SetLoggingAsync(true);
+    const auto dropped_before = miopen::LoggingDroppedRecords();
+    CapturedLog log;
+    log.Block();
+    // The queue holds 16 records, the writer can take at most as many before it blocks.
+    for(auto i = 0; i < 100; ++i)
+        MIOPEN_LOG_NQI("blocked " << i);
+    const auto dropped = miopen::LoggingDroppedRecords() - dropped_before;
+    EXPECT(dropped >= 100 - 2 * 16);
+    log.Release();
+    const auto text = log.Read();
+    miopen::SetLoggingAsync(false);
+
+    EXPECT(count(text, "blocked ") == 100 - dropped);
+    EXPECT(count(text, "blocked 0\n") == 1);
+    EXPECT(count(text, " log records dropped") == 1);
+}
+
+int main()
+{
+    // Read once, by the first record.
+    setenv("MIOPEN_ENABLE_LOGGING", "1", 1);
+    setenv("MIOPEN_LOG_LEVEL", "5", 1);
+    setenv("MIOPEN_LOG_ASYNC_RECORDS", "16", 1);
+    check_function_record();
+    check_order();
+    check_drops();
+}
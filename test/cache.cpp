@@ -25,7 +25,21 @@
  *******************************************************************************/
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/binary_cache_pack.hpp>
+#include <miopen/lock_file.hpp>
 #include <miopen/md5.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/tool_probe_cache.hpp>
+#include <boost/filesystem.hpp>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 #include "test.hpp"
 
 void check_cache_file()
@@ -41,8 +55,236 @@ void check_cache_str()
     CHECK(p.filename().string() == name + ".o");
 }
 
+void check_cache_canonical_options()
+{
+    // Spellings of the same options share one cache entry.
+    CHECK(miopen::GetCacheFile("gfx", "base", "-DB=2 -O3 -DA=1", false) ==
+          miopen::GetCacheFile("gfx", "base", " -O3  -D A=1 -DB=2", false));
+    CHECK(miopen::GetCacheFile("gfx", "base", "-DB=2 -DA=1", false) !=
+          miopen::GetCacheFile("gfx", "base", "-DB=1 -DA=2", false));
+    if(miopen::IsCacheDisabled())
+        return;
+
+    const miopen::TmpDir dir{"cache_canonical"};
+    const auto binary_path = dir.path / "binary.o";
+    std::ofstream(binary_path.string()) << "binary";
+    miopen::SaveBinary(binary_path, "gfx", "canonical", "-DB=2 -O3 -DA=1");
+    if(miopen::IsCachePackEnabled())
+    {
+        const auto found = miopen::LoadPackedBinary("gfx", "canonical", " -O3  -D A=1 -DB=2");
+        CHECK(std::string(found.data, found.size) == "binary");
+    }
+    else
+    {
+        CHECK(!miopen::LoadBinary("gfx", "canonical", " -O3  -D A=1 -DB=2").empty());
+    }
+}
+
+static std::string PackKey(int i) { return "gfx:-DKEY=" + std::to_string(i) + ":base.cl"; }
+
+static std::string PackBinary(int i) { return std::string(i % 300 + 1, static_cast<char>(i)); }
+
+static bool IsPacked(miopen::BinaryCachePack& pack, int i)
+{
+    const auto found = pack.Find(PackKey(i));
+    return std::string(found.data, found.size) == PackBinary(i);
+}
+
+void check_cache_pack()
+{
+    const miopen::TmpDir dir{"cache_pack"};
+    const auto pack_path = dir.path / "kernels.pack";
+    const int n          = 3000; // Enough to grow the index twice.
+
+    {
+        miopen::BinaryCachePack pack{dir.path};
+        CHECK(pack.Find(PackKey(0)).empty());
+        for(int i = 0; i < n; ++i)
+        {
+            const auto binary = PackBinary(i);
+            pack.Store(PackKey(i), binary.data(), binary.size());
+        }
+        for(int i = 0; i < n; ++i)
+            EXPECT(IsPacked(pack, i));
+        CHECK(pack.Find("gfx:-DKEY=0:other.cl").empty());
+    }
+
+    // Simulate a process which has been killed while appending a record.
+    const auto committed_size = boost::filesystem::file_size(pack_path);
+    (void)(std::ofstream{pack_path.string(), std::ios::app} << "garbage");
+    {
+        miopen::BinaryCachePack pack{dir.path};
+        for(int i = 0; i < n; ++i)
+            EXPECT(IsPacked(pack, i));
+        const auto binary = PackBinary(n);
+        pack.Store(PackKey(n), binary.data(), binary.size());
+        EXPECT(IsPacked(pack, n));
+        EXPECT(boost::filesystem::file_size(pack_path) > committed_size);
+    }
+
+    // Lost index is rebuilt from the pack file by the next Store().
+    boost::filesystem::remove(dir.path / "kernels.idx");
+    {
+        miopen::BinaryCachePack pack{dir.path};
+        CHECK(pack.Find(PackKey(0)).empty());
+        const auto binary = PackBinary(n + 1);
+        pack.Store(PackKey(n + 1), binary.data(), binary.size());
+        for(int i = 0; i <= n + 1; ++i)
+            EXPECT(IsPacked(pack, i));
+    }
+
+    // Lookups need no write access, and found binaries outlive the pack.
+    boost::filesystem::permissions(pack_path, boost::filesystem::owner_read);
+    boost::filesystem::permissions(dir.path / "kernels.idx", boost::filesystem::owner_read);
+    miopen::PackedBinary found;
+    {
+        miopen::BinaryCachePack pack{dir.path};
+        found = pack.Find(PackKey(n));
+    }
+    EXPECT(std::string(found.data, found.size) == PackBinary(n));
+
+    std::remove(miopen::LockFilePath(dir.path / "kernels.idx").c_str());
+}
+
+void check_cache_eviction()
+{
+    const miopen::TmpDir dir{"cache_eviction"};
+    const auto now = std::time(nullptr);
+    const int n    = 10;
+    std::vector<boost::filesystem::path> files;
+    for(int i = 0; i < n; ++i)
+    {
+        const auto subdir = dir.path / std::to_string(i % 3);
+        boost::filesystem::create_directories(subdir);
+        files.push_back(subdir / ("kernel" + std::to_string(i) + ".o"));
+        (void)(std::ofstream{files.back().string()} << std::string(1024, 'x'));
+        boost::filesystem::last_write_time(files.back(), now - 1000 + i * 10);
+    }
+    (void)(std::ofstream{(dir.path / "not_a_binary").string()} << std::string(4096, 'x'));
+
+    EXPECT(miopen::EvictFromCache(dir.path, n * 1024) == 0);
+    // 10% below the limit is freed, so 6 least recently used binaries go away.
+    EXPECT(miopen::EvictFromCache(dir.path, 5 * 1024) == 6);
+    for(int i = 0; i < n; ++i)
+        EXPECT(boost::filesystem::exists(files[i]) == (i >= 6));
+    EXPECT(boost::filesystem::exists(dir.path / "not_a_binary"));
+
+    // Recently used binaries are retained.
+    boost::filesystem::last_write_time(files[7], now);
+    EXPECT(miopen::EvictFromCache(dir.path, 0) == 3);
+    EXPECT(boost::filesystem::exists(files[7]));
+    // Emptied directories are removed.
+    EXPECT(!boost::filesystem::exists(files[6].parent_path()));
+}
+
+void check_in_flight_compilation()
+{
+    if(miopen::IsCacheDisabled())
+        return;
+
+    // The flag plays the role of the binary cache: only the first thread should find it empty.
+    std::atomic<bool> in_cache{false};
+    std::atomic<int> compiled{0};
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&] {
+            const miopen::InFlightCompilation compilation{"gfx900", "in_flight", "-O3"};
+            if(in_cache)
+                return;
+            ++compiled;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            in_cache = true;
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+    CHECK(compiled == 1);
+
+    // Failure of the owner is rethrown by the waiting threads instead of compiling again.
+    compiled = 0;
+    std::atomic<int> n_failed{0};
+    threads.clear();
+    for(int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&] {
+            try
+            {
+                miopen::InFlightCompilation compilation{"gfx900", "in_flight_failure", "-O3"};
+                ++compiled;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                compilation.SetFailed(std::make_exception_ptr(std::runtime_error("failed")));
+            }
+            catch(const std::runtime_error&)
+            {
+                ++n_failed;
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+    CHECK(compiled == 1);
+    CHECK(n_failed == 3);
+}
+
+void check_tool_probe_cache()
+{
+    const miopen::TmpDir dir{"tool_probe_cache"};
+    const auto tool = (dir.path / "tool").string();
+    std::ofstream(tool) << "version 1";
+
+    auto runs        = 0;
+    const auto probe = [&] {
+        ++runs;
+        return "result " + std::to_string(runs);
+    };
+    const auto cached = [&](const std::string& path,
+                            const std::string& name,
+                            const std::function<std::string()>& p) {
+        return miopen::GetCachedToolProbe(dir.path, path, name, p);
+    };
+    CHECK(cached(tool, "probe", probe) == "result 1");
+    CHECK(cached(tool, "probe", probe) == "result 1");
+    CHECK(runs == 1);
+    CHECK(cached(tool, "other probe", probe) == "result 2");
+
+    // A changed tool has to be probed again.
+    std::ofstream(tool) << "version 1.1";
+    CHECK(cached(tool, "probe", probe) == "result 3");
+    CHECK(cached(tool, "probe", probe) == "result 3");
+    CHECK(cached(tool, "other probe", probe) == "result 4");
+    CHECK(runs == 4);
+
+    // Tools are identified by the resolved path, not by the link to them.
+    const auto link = (dir.path / "link").string();
+    boost::filesystem::create_symlink(tool, link);
+    CHECK(cached(link, "probe", probe) == "result 3");
+    const auto other_tool = (dir.path / "other_tool").string();
+    std::ofstream(other_tool) << "version 1.1";
+    boost::filesystem::last_write_time(other_tool, boost::filesystem::last_write_time(tool));
+    boost::filesystem::remove(link);
+    boost::filesystem::create_symlink(other_tool, link);
+    CHECK(cached(link, "probe", probe) == "result 5");
+
+    // Failures are not cached.
+    const auto failing = [&]() -> std::string {
+        ++runs;
+        throw std::runtime_error("failed");
+    };
+    CHECK(cached(tool, "failing probe", failing).empty());
+    CHECK(cached(tool, "failing probe", [] { return std::string{}; }).empty());
+    CHECK(cached(tool, "failing probe", probe) == "result 7");
+    CHECK(cached(tool, "failing probe", probe) == "result 7");
+    CHECK(runs == 7);
+}
+
 int main()
 {
     check_cache_file();
     check_cache_str();
+    check_cache_canonical_options();
+    check_cache_pack();
+    check_cache_eviction();
+    check_in_flight_compilation();
+    check_tool_probe_cache();
 }
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/metrics.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+#include "test.hpp"
+
+#if MIOPEN_BACKEND_MOCK
+
+/// A problem FFT is applicable to, which is the solver with a workspace on the mock device.
+struct FftProblem
+{
+    miopen::TensorDescriptor x{miopenFloat, {16, 16, 28, 28}};
+    miopen::TensorDescriptor w{miopenFloat, {16, 16, 5, 5}};
+    miopen::ConvolutionDescriptor conv{{2, 2}, {1, 1}, {1, 1}};
+    miopen::TensorDescriptor y = conv.GetForwardOutputTensor(x, w);
+
+    miopen::Allocator::ManageDataPtr x_buf;
+    miopen::Allocator::ManageDataPtr w_buf;
+    miopen::Allocator::ManageDataPtr y_buf;
+
+    explicit FftProblem(miopen::Handle& h)
+        : x_buf(h.Create(x.GetElementSpace() * sizeof(float))),
+          w_buf(h.Create(w.GetElementSpace() * sizeof(float))),
+          y_buf(h.Create(y.GetElementSpace() * sizeof(float)))
+    {
+        // Immediate mode runs the solutions recorded by Find.
+        const auto size = conv.ForwardGetWorkSpaceSize(h, w, x, y);
+        auto workspace  = h.Create(size);
+        miopenConvAlgoPerf_t perf[4];
+        int count = 0;
+        conv.FindConvFwdAlgorithm(h,
+                                  x,
+                                  x_buf.get(),
+                                  w,
+                                  w_buf.get(),
+                                  y,
+                                  y_buf.get(),
+                                  4,
+                                  &count,
+                                  perf,
+                                  workspace.get(),
+                                  size,
+                                  false);
+    }
+
+    void RunImmediate(miopen::Handle& h) const
+    {
+        conv.ConvolutionForwardImmediate(h,
+                                         w,
+                                         w_buf.get(),
+                                         x,
+                                         x_buf.get(),
+                                         y,
+                                         y_buf.get(),
+                                         nullptr,
+                                         0,
+                                         miopen::solver::Id::fft());
+    }
+};
+
+void check_workspace_arena()
+{
+    miopen::Handle h;
+    const FftProblem problem{h};
+    const auto required = problem.conv.GetForwardSolutionWorkspaceSize(
+        h, problem.w, problem.x, problem.y, miopen::solver::Id::fft());
+    CHECK(required > 0);
+
+    h.EnableWorkspaceArena();
+    problem.RunImmediate(h);
+    EXPECT(h.workspace_arena.capacity == required);
+    EXPECT(h.workspace_arena.solution_sizes.size() == 1);
+    const auto buffer    = h.workspace_arena.buffer.get();
+    const auto allocated = miopen::MockAllocatedBytes();
+
+    // The second call finds the size it needs and reuses the arena.
+    problem.RunImmediate(h);
+    EXPECT(h.workspace_arena.buffer.get() == buffer);
+    EXPECT(h.workspace_arena.capacity == required);
+    EXPECT(h.workspace_arena.solution_sizes.size() == 1);
+    EXPECT(miopen::MockAllocatedBytes() == allocated);
+}
+
+void check_solver_counting()
+{
+    miopen::Handle h;
+    const FftProblem problem{h};
+    auto& counter     = miopen::metrics::GetSolverCounter(miopen::solver::Id::fft().ToString());
+    const auto before = counter.load();
+    h.EnableWorkspaceArena();
+
+    // Every call selects the solver, whether or not its kernels are in the cache.
+    problem.RunImmediate(h);
+    problem.RunImmediate(h);
+    EXPECT(counter.load() == before + 2);
+}
+
+int main()
+{
+    check_workspace_arena();
+    check_solver_counting();
+}
+
+#else
+
+int main() {}
+
+#endif
@@ -235,10 +235,10 @@ void InitKernelStateEmulator(std::vector<prngStates>& states,
 }
 
 template <typename T>
-inline void ExpandTensorDim(std::vector<T> x_len,
-                            std::vector<T> x_str,
-                            std::vector<T> y_len,
-                            std::vector<T> y_str,
+inline void ExpandTensorDim(const miopen::TensorDims& x_len,
+                            const miopen::TensorDims& x_str,
+                            const miopen::TensorDims& y_len,
+                            const miopen::TensorDims& y_str,
                             std::vector<T>& in_len,
                             std::vector<T>& in_str,
                             std::vector<T>& out_len,
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/exec_utils.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+#ifdef __linux__
+
+void check_split_command_line()
+{
+    using miopen::exec::SplitCommandLine;
+    EXPECT(SplitCommandLine("").empty());
+    EXPECT(SplitCommandLine("  -a   b\t-c ") == std::vector<std::string>({"-a", "b", "-c"}));
+    EXPECT(SplitCommandLine("-DX=\"a b\" 'c \"d\"' e\\ f") ==
+           std::vector<std::string>({"-DX=a b", "c \"d\"", "e f"}));
+    EXPECT(SplitCommandLine("\"\" x") == std::vector<std::string>({"", "x"}));
+    EXPECT(throws([] { SplitCommandLine("'unmatched"); }));
+}
+
+void check_run()
+{
+    std::ostringstream out;
+    EXPECT(miopen::exec::Run("echo", {"a  b", "$HOME"}, nullptr, &out) == 0);
+    EXPECT(out.str() == "a  b $HOME\n");
+
+    // The child does not read its input, this must not kill us with SIGPIPE.
+    const std::string big(1 << 20, 'x');
+    std::istringstream in(big);
+    EXPECT(miopen::exec::Run("/bin/sh", {"-c", "exit 3"}, &in, nullptr) == 3);
+
+    // Large input and output must not deadlock.
+    miopen::exec::Options options;
+    std::istringstream big_in(big);
+    std::ostringstream err;
+    out.str("");
+    options.in  = &big_in;
+    options.out = &out;
+    options.err = &err;
+    EXPECT(miopen::exec::Run("/bin/sh", {"-c", "cat; echo oops >&2"}, options) == 0);
+    EXPECT(out.str() == big);
+    EXPECT(err.str() == "oops\n");
+}
+
+void check_run_options()
+{
+    const miopen::TmpDir dir{"exec_utils"};
+    std::ostringstream out;
+    miopen::exec::Options options;
+    options.working_dir = dir.path.string();
+    options.env         = {"MIOPEN_EXEC_TEST=a b"};
+    options.out         = &out;
+    EXPECT(miopen::exec::Run("/bin/sh", {"-c", "pwd -P; echo $MIOPEN_EXEC_TEST"}, options) == 0);
+    EXPECT(out.str() == boost::filesystem::canonical(dir.path).string() + "\na b\n");
+
+    options          = {};
+    options.timeout  = std::chrono::milliseconds(100);
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT(throws([&] { miopen::exec::Run("sleep", {"10"}, options); }));
+    EXPECT(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+
+    options.timeout = std::chrono::seconds(10);
+    EXPECT(miopen::exec::Run("true", {}, options) == 0);
+    EXPECT(throws([] { miopen::exec::Run("/nonexistent/tool", {}, nullptr, nullptr); }));
+}
+
+int main()
+{
+    check_split_command_line();
+    check_run();
+    check_run_options();
+}
+
+#else
+
+int main() {}
+
+#endif // __linux__
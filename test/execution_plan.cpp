@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/execution_plan.hpp>
+#include <miopen/config.h>
+#include <miopen/handle.hpp>
+#if MIOPEN_BACKEND_HIP
+#include <miopen/hipoc_kernel.hpp>
+#endif
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+struct Launches
+{
+    std::vector<std::vector<char>> args;
+
+    miopen::ExecutionPlan::Launcher Launcher()
+    {
+        return [this](void* a, std::size_t size) {
+            const auto bytes = static_cast<const char*>(a);
+            args.emplace_back(bytes, bytes + size);
+        };
+    }
+};
+
+struct Args
+{
+    const void* in;
+    std::int32_t n;
+    void* out;
+};
+
+const void* PointerAt(const std::vector<char>& args, std::size_t offset)
+{
+    const void* result = nullptr;
+    std::memcpy(&result, &args[offset], sizeof(result));
+    return result;
+}
+
+void check_replay()
+{
+    int a = 0, b = 0, c = 0, d = 0;
+    Launches launches;
+    miopen::ExecutionPlan plan;
+
+    const auto first  = Args{&a, 7, &b};
+    const auto second = Args{&b, 8, &c};
+    const std::vector<std::size_t> offsets{offsetof(Args, in), offsetof(Args, out)};
+    plan.Record(launches.Launcher(), &first, sizeof(first), offsets);
+    plan.Record(launches.Launcher(), &second, sizeof(second), offsets);
+    EXPECT(plan.GetLaunchCount() == 2);
+    EXPECT(plan.GetBuffers() == std::vector<const void*>({&a, &b, &c}));
+
+    plan.Replay();
+    EXPECT(launches.args.size() == 2);
+    EXPECT(std::memcmp(launches.args[0].data(), &first, sizeof(first)) == 0);
+    EXPECT(std::memcmp(launches.args[1].data(), &second, sizeof(second)) == 0);
+
+    // Every use of a buffer is re-bound, other arguments stay as captured.
+    launches.args.clear();
+    plan.Replay({{&b, &d}});
+    EXPECT(PointerAt(launches.args[0], offsetof(Args, in)) == &a);
+    EXPECT(PointerAt(launches.args[0], offsetof(Args, out)) == &d);
+    EXPECT(PointerAt(launches.args[1], offsetof(Args, in)) == &d);
+    EXPECT(PointerAt(launches.args[1], offsetof(Args, out)) == &c);
+    std::int32_t n = 0;
+    std::memcpy(&n, &launches.args[1][offsetof(Args, n)], sizeof(n));
+    EXPECT(n == 8);
+
+    // Bindings are relative to the captured pointers, not to the previous replay.
+    launches.args.clear();
+    plan.Replay({});
+    EXPECT(std::memcmp(launches.args[0].data(), &first, sizeof(first)) == 0);
+}
+
+#if MIOPEN_BACKEND_HIP
+void check_pointer_offsets()
+{
+    int a = 0, b = 0;
+    const miopen::KernelArgs<int*, char, const int*, float> args{&a, 'x', &b, 1.0f};
+    const auto offsets = miopen::KernelArgsPointerOffsets<int*, char, const int*, float>();
+    EXPECT(offsets.size() == 2);
+    const auto bytes = reinterpret_cast<const char*>(&args);
+    const std::vector<char> packed(bytes, bytes + sizeof(args));
+    EXPECT(PointerAt(packed, offsets[0]) == &a);
+    EXPECT(PointerAt(packed, offsets[1]) == &b);
+}
+#endif
+
+#if MIOPEN_BACKEND_MOCK
+const std::string copy_kernel =
+    "__kernel void copy(__global const int* in, int n, __global int* out) {}\n";
+
+void check_handle_capture()
+{
+    miopen::Handle h;
+    auto in    = h.Create<int>(16);
+    auto out   = h.Create<int>(16);
+    auto other = h.Create<int>(16);
+    auto& log  = h.GetMockLaunches();
+    log.keep   = true;
+    h.AddKernel(
+        "NoAlgo", "capture", "copy.cl", "copy", {16, 1, 1}, {16, 1, 1}, "", 0, false, copy_kernel);
+
+    h.BeginCapture();
+    EXPECT(h.IsCapturing());
+    h.GetKernel("NoAlgo", "capture")(in.get(), 16, out.get());
+    // Buffers created now would be freed while the plan still uses them.
+    EXPECT(throws([&] { h.Create(64); }));
+    EXPECT(throws([&] { h.Write(std::vector<int>(16, 1)); }));
+    auto plan = h.EndCapture();
+    EXPECT(!h.IsCapturing());
+    EXPECT(h.Create(64) != nullptr);
+
+    EXPECT(plan.GetLaunchCount() == 1);
+    EXPECT(plan.GetBuffers() == std::vector<const void*>({in.get(), out.get()}));
+    log.Clear();
+    plan.Replay({{out.get(), other.get()}});
+    EXPECT(log.launches.size() == 1);
+    EXPECT(log.launches.front().name == "copy");
+    EXPECT(PointerAt(log.launches.front().args, offsetof(Args, in)) == in.get());
+    EXPECT(PointerAt(log.launches.front().args, offsetof(Args, out)) == other.get());
+}
+#endif
+
+int main()
+{
+    check_replay();
+#if MIOPEN_BACKEND_HIP
+    check_pointer_offsets();
+#endif
+#if MIOPEN_BACKEND_MOCK
+    check_handle_capture();
+#endif
+}
@@ -166,6 +166,38 @@ void test_arch_name()
         known_arch.begin(), known_arch.end(), [&](std::string arch) { return arch == this_arch; }));
 }
 
+void test_workspace_arena()
+{
+    miopen::Handle h{};
+    EXPECT(!h.IsWorkspaceArenaEnabled());
+    EXPECT(throws([&] { h.ReserveWorkspace(1024); }));
+
+    h.EnableWorkspaceArena();
+    h.ReserveWorkspace(4096);
+    EXPECT(h.GetWorkspacePeak() == 0);
+
+    // Requests that fit reuse the same buffer.
+    const auto first = h.GetWorkspace(1024);
+    EXPECT(first != nullptr);
+    EXPECT(h.GetWorkspace(4096) == first);
+    EXPECT(h.GetWorkspace(0) == nullptr);
+    EXPECT(h.GetWorkspacePeak() == 4096);
+
+    // The arena grows to the new peak and holds data like any other buffer.
+    const auto n = 4096;
+    std::vector<int> data_in(n, 3);
+    auto grown = h.GetWorkspace(n * sizeof(int));
+    EXPECT(grown != nullptr);
+    EXPECT(h.GetWorkspacePeak() == n * sizeof(int));
+    h.Copy(h.Write(data_in).get(), grown, n * sizeof(int));
+    std::vector<int> data_out(n);
+    h.ReadTo(data_out.data(), h.workspace_arena.buffer, n * sizeof(int));
+    EXPECT(data_out == data_in);
+
+    h.EnableWorkspaceArena(false);
+    EXPECT(h.workspace_arena.buffer == nullptr);
+}
+
 int main()
 {
     auto&& h = get_handle();
@@ -181,6 +213,7 @@ int main()
     test_multithreads(miopenOpenCLKernelType);
     test_errors(miopenOpenCLKernelType);
     test_arch_name();
+    test_workspace_arena();
 // Warnings currently dont work in opencl
 #if !MIOPEN_BACKEND_OPENCL
     test_warnings(miopenOpenCLKernelType);
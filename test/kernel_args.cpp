@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel_args.hpp>
+#include <miopen/op_kernel_args.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "test.hpp"
+
+using Conv1x1U = miopen::KernelSignature<int,
+                                         int,
+                                         int,
+                                         int,
+                                         int,
+                                         int,
+                                         int,
+                                         int,
+                                         const void*,
+                                         const void*,
+                                         void*,
+                                         int*>;
+static_assert(Conv1x1U::count == 12, "");
+static_assert(Conv1x1U::Offset(7) == 28, "");
+static_assert(Conv1x1U::Offset(8) == 32, "");
+static_assert(Conv1x1U::Offset(11) == 56, "");
+static_assert(Conv1x1U::Size() == 64, "");
+static_assert(Conv1x1U::Alignment() == 8, "");
+
+using Mixed = miopen::KernelSignature<char, int*, short, float, char, double>;
+static_assert(Mixed::Offset(1) == 8, "");
+static_assert(Mixed::Offset(2) == 16, "");
+static_assert(Mixed::Offset(3) == 20, "");
+static_assert(Mixed::Offset(4) == 24, "");
+static_assert(Mixed::Offset(5) == 32, "");
+static_assert(Mixed::Size() == 40, "");
+static_assert(Mixed::IsPointer(1) && !Mixed::IsPointer(0), "");
+
+template <class T>
+T At(const void* args, std::size_t offset)
+{
+    T result;
+    std::memcpy(&result, static_cast<const char*>(args) + offset, sizeof(result));
+    return result;
+}
+
+void check_pack()
+{
+    int a = 0;
+    const miopen::KernelArgs<char, int*, short, float, char, double> args{
+        'x', &a, 3, 0.5f, 'y', 0.25};
+    EXPECT(At<char>(&args, Mixed::Offset(0)) == 'x');
+    EXPECT(At<int*>(&args, Mixed::Offset(1)) == &a);
+    EXPECT(At<short>(&args, Mixed::Offset(2)) == 3);
+    EXPECT(At<float>(&args, Mixed::Offset(3)) == 0.5f);
+    EXPECT(At<char>(&args, Mixed::Offset(4)) == 'y');
+    EXPECT(At<double>(&args, Mixed::Offset(5)) == 0.25);
+
+    // Padding is zeroed and the hidden arguments follow right after the arguments.
+    EXPECT(At<char>(&args, 1) == 0);
+    EXPECT(At<std::uint16_t>(&args, 18) == 0);
+    EXPECT(reinterpret_cast<const char*>(&args.hidden) - reinterpret_cast<const char*>(&args) ==
+           40);
+    EXPECT(sizeof(args) == 40 + sizeof(args.hidden));
+}
+
+void check_pointer_offsets()
+{
+    const auto offsets = miopen::KernelArgsPointerOffsets<char, int*, short, const float*>();
+    EXPECT(offsets == std::vector<std::size_t>({8, 24}));
+
+    int a   = 0;
+    float b = 0;
+    const std::vector<OpKernelArg> any_args{'x', &a, short{3}, &b};
+    EXPECT(OpKernelArgsPointerOffsets(any_args) == offsets);
+}
+
+int main()
+{
+    check_pack();
+    check_pointer_offsets();
+}
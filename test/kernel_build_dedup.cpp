@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Checks that build options which differ only in the order and spelling of defines
+/// share one program, and reports how many of the programs required by all applicable
+/// solutions for a suite of convolution problems are deduplicated that way.
+/// Nothing is compiled or run on the GPU.
+
+#include "test.hpp"
+#include "../tools/conv_problem_parser.hpp"
+#include <miopen/config.h>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+using tools::ConvProblemConfig;
+
+static bool IsDefine(const std::string& token)
+{
+    return (StartsWith(token, "-D") && token.size() > 2) ||
+           (StartsWith(token, "-Wa,-defsym,") && token.size() > 12);
+}
+
+/// Reverses the order of the defines and leaves other options in place. Returns an empty
+/// string if the order of the defines matters, that is, some are given more than once.
+static std::string ReverseDefines(const std::string& options)
+{
+    std::istringstream ss(options);
+    std::vector<std::string> tokens;
+    std::vector<std::size_t> defines;
+    std::set<std::string> names;
+    std::string token;
+    while(ss >> token)
+    {
+        if(IsDefine(token))
+        {
+            if(!names.insert(token.substr(0, token.find('='))).second)
+                return "";
+            defines.push_back(tokens.size());
+        }
+        tokens.push_back(token);
+    }
+    for(std::size_t i = 0, j = defines.size(); i + 1 < j; ++i, --j)
+        std::swap(tokens[defines[i]], tokens[defines[j - 1]]);
+    return JoinStrings(tokens, " ");
+}
+
+void CheckEquivalences()
+{
+    const auto same = [](const std::string& lhs, const std::string& rhs) {
+        return CanonicalBuildOptions(lhs) == CanonicalBuildOptions(rhs);
+    };
+
+    EXPECT(same("-DB=1 -DA=2", "-DA=2 -DB=1"));
+    EXPECT(same("-D A=2 -DB=1", "-DB=1  -DA=2"));
+    EXPECT(same("-DMLO_FILTER_SIZE0=3 -DMLO_GRP_SZ=256 -DMLO_FILTER_SIZE1=3",
+                "-DMLO_GRP_SZ=256 -DMLO_FILTER_SIZE1=3 -DMLO_FILTER_SIZE0=3"));
+    EXPECT(same("-Wa,-defsym,B=1 -mcpu=gfx900 -Wa,-defsym,A=0",
+                "-mcpu=gfx900 -Wa,-defsym,A=0 -Wa,-defsym,B=1"));
+
+    EXPECT(!same("-DA=1 -DB=2", "-DA=2 -DB=1"));
+    EXPECT(!same("-DA=1", "-DA=1 -DB"));
+    // The last definition wins, so here the order matters.
+    EXPECT(!same("-DA=1 -DA=2", "-DA=2 -DA=1"));
+    EXPECT(!same("-DA=\"x y\" -DB", "-DB -DA=\"x y\""));
+}
+
+#if MIOPEN_BACKEND_MOCK
+/// Kernels with equivalent options share the program, which is built with the options as
+/// they were given first.
+void CheckProgramReuse()
+{
+    Handle handle;
+    const auto add = [&](const std::string& algorithm, const std::string& params) {
+        handle.AddKernel(
+            algorithm, "dedup", "MIOpenTensorKernels.cl", "Op1dTensorGeneric", {64}, {64}, params);
+        return handle.GetKernelsImpl(algorithm, "dedup").front().program.params;
+    };
+
+    const auto first = add("first", "-DUSE_1D_TENSOR_GENERIC=1 -DMIOPEN_TYPE=float");
+    EXPECT(StartsWith(first, " -DUSE_1D_TENSOR_GENERIC=1 -DMIOPEN_TYPE=float"));
+    EXPECT(add("reordered", "-DMIOPEN_TYPE=float -DUSE_1D_TENSOR_GENERIC=1") == first);
+    EXPECT(add("respelled", "-D MIOPEN_TYPE=float  -DUSE_1D_TENSOR_GENERIC=1") == first);
+    EXPECT(add("other", "-DMIOPEN_TYPE=half -DUSE_1D_TENSOR_GENERIC=1") != first);
+}
+#else
+void CheckProgramReuse() {}
+#endif
+
+void ReportSolutions()
+{
+    const std::vector<std::string> problems = {
+        "conv -n 16 -c 64 -H 56 -W 56 -k 64 -y 1 -x 1 -p 0 -q 0 -u 1 -v 1",
+        "conv -n 16 -c 64 -H 56 -W 56 -k 64 -y 3 -x 3 -p 1 -q 1 -u 1 -v 1",
+        "conv -n 16 -c 256 -H 56 -W 56 -k 128 -y 1 -x 1 -p 0 -q 0 -u 2 -v 2",
+        "conv -n 16 -c 128 -H 28 -W 28 -k 128 -y 3 -x 3 -p 1 -q 1 -u 1 -v 1",
+        "conv -n 16 -c 256 -H 14 -W 14 -k 256 -y 3 -x 3 -p 1 -q 1 -u 1 -v 1",
+        "conv -n 16 -c 512 -H 7 -W 7 -k 512 -y 3 -x 3 -p 1 -q 1 -u 1 -v 1",
+        "conv -n 16 -c 3 -H 224 -W 224 -k 64 -y 7 -x 7 -p 3 -q 3 -u 2 -v 2"};
+
+    Handle handle;
+    std::size_t n_kernels = 0;
+    std::set<std::string> raw;
+    std::set<std::string> canonical;
+
+    for(const auto& command : problems)
+    {
+        ConvProblemConfig config;
+        CHECK(config.Parse(command));
+        for(const auto direction : {ConvProblemConfig::Forward,
+                                    ConvProblemConfig::BackwardData,
+                                    ConvProblemConfig::BackwardWrW})
+        {
+            const auto ctx = config.MakeContext(handle, direction);
+            for(const auto& solution : tools::GetAllSolutions(ctx, direction))
+            {
+                for(const auto& k : solution.construction_params)
+                {
+                    const auto options = CanonicalBuildOptions(k.comp_options);
+                    CHECK(CanonicalBuildOptions(options) == options);
+                    const auto reversed = ReverseDefines(k.comp_options);
+                    if(!reversed.empty())
+                        CHECK(CanonicalBuildOptions(reversed) == options);
+                    ++n_kernels;
+                    raw.insert(k.kernel_file + '\n' + k.comp_options);
+                    canonical.insert(k.kernel_file + '\n' + options);
+                }
+            }
+        }
+    }
+
+    CHECK(canonical.size() <= raw.size());
+    std::cout << "Kernels: " << n_kernels << ", programs: " << raw.size()
+              << ", programs after canonicalization of options: " << canonical.size();
+    if(!raw.empty())
+        std::cout << " (" << 100.0 * (raw.size() - canonical.size()) / raw.size()
+                  << "% deduplicated)";
+    std::cout << std::endl;
+}
+
+} // namespace tests
+} // namespace miopen
+
+int main()
+{
+    miopen::tests::CheckEquivalences();
+    miopen::tests::CheckProgramReuse();
+    miopen::tests::ReportSolutions();
+}
@@ -51,6 +51,18 @@ struct KBPTestDriver : test_driver
             "-Wa,-defsym,DefineWithValue=0 -TrivialOption -OptionWithValue 0 -Wa,-defsym,Shifted "
             "-Wa,-defsym,DefineDefine "
             "-Wa,-defsym,DefineDefineWithValue=1");
+
+        EXPECT_EQUAL(CanonicalBuildOptions(" -DB=1  -cl-std=CL2.0 -D A=2 "),
+                     "-cl-std=CL2.0 -DA=2 -DB=1");
+        EXPECT_EQUAL(CanonicalBuildOptions("-Wa,-defsym,B=1 -mcpu=gfx900 -Wa,-defsym,A=0"),
+                     "-mcpu=gfx900 -Wa,-defsym,A=0 -Wa,-defsym,B=1");
+        // The order matters when a name is defined twice or with quoted values.
+        EXPECT_EQUAL(CanonicalBuildOptions("-DB=1 -DA -DB=2"), "-DB=1 -DA -DB=2");
+        EXPECT_EQUAL(CanonicalBuildOptions("-DB=\"x  y\" -DA"), "-DB=\"x  y\" -DA");
+        // -U undefines depending on where it stands.
+        EXPECT_EQUAL(CanonicalBuildOptions("-DFOO -UFOO"), "-DFOO -UFOO");
+        EXPECT_EQUAL(CanonicalBuildOptions("-UFOO  -DFOO"), "-UFOO  -DFOO");
+        EXPECT_EQUAL(CanonicalBuildOptions("-DB -U A"), "-DB -U A");
     }
 };
 } // namespace tests
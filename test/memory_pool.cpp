@@ -0,0 +1,218 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/memory_pool.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "test.hpp"
+
+// Stands in for a device allocator set with SetAllocator, counting what it is asked to do.
+struct HostAllocator
+{
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> deallocations{0};
+    bool fail = false;
+
+    static void* Allocate(void* context, std::size_t n)
+    {
+        auto& self = *static_cast<HostAllocator*>(context);
+        if(self.fail)
+            return nullptr;
+        ++self.allocations;
+        return std::malloc(n);
+    }
+
+    static void Deallocate(void* context, void* memory)
+    {
+        ++static_cast<HostAllocator*>(context)->deallocations;
+        std::free(memory);
+    }
+
+    miopen::Allocator Get() { return {&Allocate, &Deallocate, this}; }
+};
+
+void check_size_classes()
+{
+    using miopen::MemoryPool;
+    EXPECT(MemoryPool::SizeClass(1) == 512);
+    EXPECT(MemoryPool::SizeClass(512) == 512);
+    EXPECT(MemoryPool::SizeClass(513) == 640);
+    EXPECT(MemoryPool::SizeClass(1000) == 1024);
+    EXPECT(MemoryPool::SizeClass(1025) == 1280);
+    EXPECT(MemoryPool::SizeClass(3 << 20) == 3 << 20);
+    for(std::size_t n = 1; n < (1 << 20); n = n * 3 / 2 + 1)
+    {
+        EXPECT(MemoryPool::SizeClass(n) >= n);
+        EXPECT(MemoryPool::SizeClass(n) <= n + n / 4 + 512);
+    }
+}
+
+void check_reuse()
+{
+    HostAllocator upstream;
+    const auto pool   = std::make_shared<miopen::MemoryPool>(1 << 20);
+    const int stream0 = 0;
+    const int stream1 = 0;
+
+    void* first;
+    {
+        auto buffer = pool->Allocate(upstream.Get(), 1000, &stream0);
+        first       = buffer.get();
+    }
+    EXPECT(pool->GetCachedBytes() == 1024);
+
+    {
+        // Same size class and stream: the cached buffer comes back.
+        auto buffer = pool->Allocate(upstream.Get(), 900, &stream0);
+        EXPECT(buffer.get() == first);
+        EXPECT(pool->GetCachedBytes() == 0);
+    }
+    EXPECT(upstream.allocations == 1);
+
+    {
+        // Another stream may still have work queued against the cached buffer.
+        auto buffer = pool->Allocate(upstream.Get(), 1000, &stream1);
+        EXPECT(buffer.get() != first);
+        // Another size class.
+        auto other = pool->Allocate(upstream.Get(), 4000, &stream0);
+        EXPECT(upstream.allocations == 3);
+    }
+    EXPECT(upstream.deallocations == 0);
+    EXPECT(pool->GetCachedBytes() == 1024 + 1024 + 4096);
+
+    pool->Trim();
+    EXPECT(pool->GetCachedBytes() == 0);
+    EXPECT(upstream.deallocations == 3);
+}
+
+void check_limit()
+{
+    HostAllocator upstream;
+    const auto pool  = std::make_shared<miopen::MemoryPool>(4096);
+    const int stream = 0;
+
+    {
+        auto a = pool->Allocate(upstream.Get(), 4096, &stream);
+        auto b = pool->Allocate(upstream.Get(), 4096, &stream);
+    }
+    // Only one buffer fits under the high-water mark.
+    EXPECT(pool->GetCachedBytes() == 4096);
+    EXPECT(upstream.deallocations == 1);
+
+    pool->SetLimit(1024);
+    EXPECT(pool->GetCachedBytes() == 0);
+    EXPECT(upstream.deallocations == 2);
+
+    {
+        // Zero sized requests are not pooled.
+        auto empty = pool->Allocate(upstream.Get(), 0, &stream);
+    }
+    EXPECT(pool->GetCachedBytes() == 0);
+}
+
+void check_custom_allocator_change()
+{
+    HostAllocator first;
+    HostAllocator second;
+    const auto pool  = std::make_shared<miopen::MemoryPool>(1 << 20);
+    const int stream = 0;
+
+    auto outstanding = pool->Allocate(first.Get(), 100, &stream);
+    {
+        auto cached = pool->Allocate(first.Get(), 100, &stream);
+    }
+
+    // Buffers of the previous allocator are neither reused nor freed by the new one.
+    {
+        auto buffer = pool->Allocate(second.Get(), 100, &stream);
+        EXPECT(second.allocations == 1);
+    }
+    outstanding = nullptr;
+    pool->Trim();
+    EXPECT(first.allocations == 2 && first.deallocations == 2);
+    EXPECT(second.allocations == 1 && second.deallocations == 1);
+}
+
+void check_allocation_failure()
+{
+    HostAllocator upstream;
+    const auto pool  = std::make_shared<miopen::MemoryPool>(1 << 20);
+    const int stream = 0;
+
+    {
+        auto buffer = pool->Allocate(upstream.Get(), 100, &stream);
+    }
+    upstream.fail = true;
+    EXPECT(throws([&] { pool->Allocate(upstream.Get(), 10000, &stream); }));
+    // The pool gave its cache back before giving up.
+    EXPECT(pool->GetCachedBytes() == 0);
+    EXPECT(upstream.deallocations == 1);
+}
+
+void check_lifetime_and_threads()
+{
+    HostAllocator upstream;
+
+    {
+        miopen::Allocator::ManageDataPtr survivor;
+
+        {
+            auto pool = std::make_shared<miopen::MemoryPool>(1 << 20);
+            std::vector<std::thread> threads;
+            for(auto i = 0; i < 4; ++i)
+            {
+                threads.emplace_back([&] {
+                    for(auto j = 0; j < 1000; ++j)
+                    {
+                        // Buffers are not touched, they are device memory on OpenCL.
+                        auto buffer = pool->Allocate(upstream.Get(), 64 * (j % 8 + 1), &threads);
+                        EXPECT(buffer != nullptr);
+                    }
+                });
+            }
+            for(auto& thread : threads)
+                thread.join();
+            survivor = pool->Allocate(upstream.Get(), 100, nullptr);
+        }
+
+        EXPECT(upstream.allocations > upstream.deallocations);
+    }
+
+    // The buffer kept the pool alive, the last reference frees everything.
+    EXPECT(upstream.allocations == upstream.deallocations);
+}
+
+int main()
+{
+    check_size_classes();
+    check_reuse();
+    check_limit();
+    check_custom_allocator_change();
+    check_allocation_failure();
+    check_lifetime_and_threads();
+}
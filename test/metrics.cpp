@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/metrics.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/miopen.h>
+#include <miopen/temp_file.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+std::string snapshot()
+{
+    std::size_t size = 0;
+    EXPECT(miopenGetMetricsSnapshot(nullptr, &size) == miopenStatusSuccess);
+    std::vector<char> buffer(size);
+    EXPECT(miopenGetMetricsSnapshot(buffer.data(), &size) == miopenStatusSuccess);
+    EXPECT(size == buffer.size());
+    return buffer.data();
+}
+
+bool contains(const std::string& str, const std::string& what)
+{
+    return str.find(what) != std::string::npos;
+}
+
+void check_counters()
+{
+    EXPECT(miopenResetMetrics() == miopenStatusSuccess);
+    miopen::metrics::Add(miopen::metrics::Counter::FindDbHits);
+    miopen::metrics::Add(miopen::metrics::Counter::FindDbHits, 2);
+    miopen::metrics::Add(miopen::metrics::Counter::BinaryCacheMisses);
+
+    const auto json = snapshot();
+    EXPECT(contains(json, "\"find_db_hits\":3"));
+    EXPECT(contains(json, "\"find_db_misses\":0"));
+    EXPECT(contains(json, "\"binary_cache_misses\":1"));
+
+    EXPECT(miopenResetMetrics() == miopenStatusSuccess);
+    EXPECT(contains(snapshot(), "\"find_db_hits\":0"));
+}
+
+void check_histograms()
+{
+    miopen::metrics::Reset();
+    miopen::metrics::Observe(miopen::metrics::Histogram::CompileSeconds, 0.5);
+    miopen::metrics::Observe(miopen::metrics::Histogram::CompileSeconds, 1.0);
+    miopen::metrics::Observe(miopen::metrics::Histogram::CompileSeconds, 1000.0);
+    miopen::metrics::Observe(miopen::metrics::Histogram::CompileSeconds, 0.0);
+
+    // Upper bounds are inclusive, the last bucket takes everything above 100s.
+    const auto json = snapshot();
+    EXPECT(contains(json,
+                    "\"compile_seconds\":{\"count\":4,\"sum\":1001.5,\"buckets\":["
+                    "{\"le\":1e-06,\"count\":1},{\"le\":1e-05,\"count\":0},"
+                    "{\"le\":0.0001,\"count\":0},{\"le\":0.001,\"count\":0},"
+                    "{\"le\":0.01,\"count\":0},{\"le\":0.1,\"count\":0},"
+                    "{\"le\":1,\"count\":2},{\"le\":10,\"count\":0},"
+                    "{\"le\":100,\"count\":0},{\"le\":\"+Inf\",\"count\":1}]}"));
+    EXPECT(contains(json, "\"lock_wait_seconds\":{\"count\":0,"));
+}
+
+void check_solvers()
+{
+    miopen::metrics::Reset();
+    auto& counter = miopen::metrics::GetSolverCounter("MetricsTestSolver");
+    EXPECT(&counter == &miopen::metrics::GetSolverCounter("MetricsTestSolver"));
+    counter.fetch_add(2);
+    EXPECT(contains(snapshot(), "\"MetricsTestSolver\":2"));
+    miopen::metrics::Reset();
+    EXPECT(contains(snapshot(), "\"MetricsTestSolver\":0"));
+}
+
+void check_snapshot_size()
+{
+    std::size_t size = 0;
+    EXPECT(miopenGetMetricsSnapshot(nullptr, &size) == miopenStatusSuccess);
+    std::vector<char> buffer(size);
+    auto small = size - 1;
+    EXPECT(miopenGetMetricsSnapshot(buffer.data(), &small) == miopenStatusBadParm);
+    EXPECT(small == size);
+    EXPECT(miopenGetMetricsSnapshot(buffer.data(), nullptr) == miopenStatusBadParm);
+}
+
+void check_sources()
+{
+    miopen::metrics::Reset();
+    miopen::Handle h;
+    EXPECT(h.GetKernels("NoAlgo", "metrics").empty());
+
+    miopen::TempFile file{"metrics"};
+    auto& lock_file = miopen::LockFile::Get(miopen::LockFilePath(file.Path()).c_str());
+    {
+        const std::unique_lock<miopen::LockFile> lock(lock_file);
+    }
+    {
+        const std::unique_lock<miopen::LockFile> lock(lock_file, std::chrono::seconds{1});
+    }
+
+    const auto json = snapshot();
+    EXPECT(contains(json, "\"kernel_cache_hits\":0"));
+    EXPECT(contains(json, "\"kernel_cache_misses\":1"));
+    EXPECT(contains(json, "\"lock_wait_seconds\":{\"count\":2,"));
+}
+
+int main()
+{
+    check_counters();
+    check_histograms();
+    check_solvers();
+    check_snapshot_size();
+    check_sources();
+}
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/handle.hpp>
+#include <cstring>
+#include <vector>
+#include "test.hpp"
+
+#if MIOPEN_BACKEND_MOCK
+
+const std::string write_kernel = "__kernel void write(__global int* data, int value) {}\n";
+
+void check_memory()
+{
+    miopen::Handle h;
+    h.SetMemoryPoolLimit(0);
+    const auto before = miopen::MockAllocatedBytes();
+    {
+        const std::vector<int> data(16, 3);
+        auto buffer = h.Write(data);
+        EXPECT(miopen::MockAllocatedBytes() == before + data.size() * sizeof(int));
+        EXPECT(miopen::MockPeakAllocatedBytes() >= miopen::MockAllocatedBytes());
+        EXPECT(h.Read<int>(buffer, data.size()) == data);
+    }
+    EXPECT(miopen::MockAllocatedBytes() == before);
+}
+
+void check_launches()
+{
+    miopen::Handle h;
+    auto buffer = h.Create<int>(16);
+    auto& log   = h.GetMockLaunches();
+    log.keep    = true;
+
+    h.AddKernel(
+        "NoAlgo", "mock", "write.cl", "write", {16, 1, 1}, {64, 1, 1}, "", 0, false, write_kernel)(
+        buffer.get(), 7);
+    EXPECT(log.count == 1);
+    EXPECT(log.launches.front().name == "write");
+    EXPECT(log.launches.front().gdims[0] == 64);
+
+    // The launch keeps the arguments packed as the device would see them.
+    const auto& args = log.launches.front().args;
+    void* pointer    = nullptr;
+    int value        = 0;
+    std::memcpy(&pointer, args.data(), sizeof(pointer));
+    std::memcpy(&value, args.data() + sizeof(pointer), sizeof(value));
+    EXPECT(pointer == buffer.get());
+    EXPECT(value == 7);
+
+    EXPECT(h.HasKernel("NoAlgo", "mock"));
+    h.GetKernel("NoAlgo", "mock")(buffer.get(), 8);
+    EXPECT(log.count == 2);
+
+    log.keep = false;
+    log.Clear();
+    h.GetKernel("NoAlgo", "mock")(buffer.get(), 9);
+    EXPECT(log.count == 1);
+    EXPECT(log.launches.empty());
+
+    EXPECT(throws([&] {
+        h.AddKernel("NoAlgo", "", "does_not_exist.cl", "write", {1, 1, 1}, {1, 1, 1}, "");
+    }));
+}
+
+int main()
+{
+    check_memory();
+    check_launches();
+}
+
+#else
+
+int main() {}
+
+#endif
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel_cache.hpp>
+#include <miopen/network_config.hpp>
+#include "test.hpp"
+
+using miopen::NetworkConfig;
+
+void check_equality()
+{
+    const auto a = NetworkConfig{"fwd"} << 1 << 2u << std::size_t{3} << miopenHalf << true;
+    const auto b = NetworkConfig{"fwd"} << 1 << 2u << std::size_t{3} << miopenHalf << true;
+    EXPECT(a == b);
+    EXPECT(a.GetHash() == b.GetHash());
+
+    EXPECT(a != (NetworkConfig{"bwd"} << 1 << 2u << std::size_t{3} << miopenHalf << true));
+    EXPECT(a != (NetworkConfig{"fwd"} << 1 << 2u << std::size_t{3} << miopenHalf));
+    EXPECT(a != (NetworkConfig{"fwd"} << 2 << 1u << std::size_t{3} << miopenHalf << true));
+
+    // The string configs this replaces could not tell "12" "3" from "1" "23".
+    EXPECT((NetworkConfig{} << 12 << 3) != (NetworkConfig{} << 1 << 23));
+    EXPECT((NetworkConfig{} << 12 << 3).GetHash() != (NetworkConfig{} << 1 << 23).GetHash());
+
+    EXPECT((NetworkConfig{} << 1) != (NetworkConfig{} << 1.0f));
+    EXPECT((NetworkConfig{} << 0.5f) == (NetworkConfig{} << 0.5f));
+    EXPECT((NetworkConfig{} << 0.5f) != (NetworkConfig{} << 0.25f));
+}
+
+void check_empty()
+{
+    EXPECT(NetworkConfig{}.Empty());
+    EXPECT(!NetworkConfig{"name"}.Empty());
+    EXPECT(!(NetworkConfig{} << 0).Empty());
+}
+
+void check_to_string()
+{
+    EXPECT((NetworkConfig{"initprngs"} << 256 << -1 << 0.5f).ToString() ==
+           "initprngs-256x-1x0.500000");
+    EXPECT((NetworkConfig{} << 1 << 2).ToString() == "1x2");
+    EXPECT(NetworkConfig{"set"}.ToString() == "set");
+}
+
+void check_too_many_fields()
+{
+    NetworkConfig config{"long"};
+    for(std::size_t i = 0; i < NetworkConfig::max_fields; ++i)
+        config << i;
+    EXPECT(throws([&] { config << 0; }));
+}
+
+void check_kernel_cache_key()
+{
+    using Key        = miopen::KernelCache::Key;
+    const auto fwd   = NetworkConfig{"fwd"} << 1 << 2;
+    const Key binary = {"algo", fwd};
+    EXPECT(binary == Key("algo", fwd));
+    EXPECT(binary.hash == Key("algo", fwd).hash);
+    EXPECT(!(binary == Key("other", fwd)));
+    EXPECT(!(binary == Key("algo", NetworkConfig{"fwd"} << 1 << 3)));
+    EXPECT(!(binary == Key("algo", fwd.ToString())));
+    EXPECT(binary.HasNetworkConfig());
+    EXPECT(!Key("algo", NetworkConfig{}).HasNetworkConfig());
+    EXPECT(binary.GetNetworkConfig() == "fwd-1x2");
+    EXPECT(Key("algo", "config").GetNetworkConfig() == "config");
+}
+
+int main()
+{
+    check_equality();
+    check_empty();
+    check_to_string();
+    check_too_many_fields();
+    check_kernel_cache_key();
+}
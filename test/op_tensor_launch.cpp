@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_ops.hpp>
+#include <vector>
+#include "test.hpp"
+
+#if MIOPEN_BACKEND_MOCK
+
+struct Shape
+{
+    std::vector<std::size_t> a;
+    std::vector<std::size_t> b;
+};
+
+struct Scalars
+{
+    float alpha0;
+    float alpha1;
+    float beta;
+};
+
+static miopen::TensorDescriptor Packed(const std::vector<std::size_t>& lens)
+{
+    std::vector<std::size_t> strides(lens.size(), 1);
+    for(auto i = lens.size(); i > 1; --i)
+        strides[i - 2] = strides[i - 1] * lens[i - 1];
+    return {miopenFloat, lens, strides};
+}
+
+/// Runs OpTensor and returns the launches it has made.
+static std::vector<miopen::MockLaunch>
+Run(miopen::Handle& h, const Shape& shape, const Scalars& s, Data_t buffer)
+{
+    const auto a = Packed(shape.a);
+    const auto b = Packed(shape.b);
+    auto& log    = h.GetMockLaunches();
+    log.Clear();
+    log.keep = true;
+    miopen::OpTensor(h,
+                     miopenTensorOpAdd,
+                     &s.alpha0,
+                     a,
+                     buffer,
+                     &s.alpha1,
+                     b,
+                     buffer,
+                     &s.beta,
+                     a,
+                     buffer,
+                     1,
+                     2,
+                     3);
+    return log.launches;
+}
+
+static bool SameLaunches(const std::vector<miopen::MockLaunch>& lhs,
+                         const std::vector<miopen::MockLaunch>& rhs)
+{
+    if(lhs.size() != rhs.size())
+        return false;
+    for(std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if(lhs[i].name != rhs[i].name || lhs[i].ldims != rhs[i].ldims ||
+           lhs[i].gdims != rhs[i].gdims || lhs[i].args != rhs[i].args)
+            return false;
+    }
+    return true;
+}
+
+/// A memoized launch has to pick the same kernel and pass the same arguments as the full
+/// resolution does on a fresh handle, also when only the scalars have changed.
+void check_memoized_launches()
+{
+    const std::vector<Shape> shapes = {{{64}, {64}},
+                                       {{64}, {1}},
+                                       {{8, 64}, {8, 64}},
+                                       {{8, 64}, {1, 64}},
+                                       {{1, 16, 64}, {1, 16, 64}},
+                                       {{1, 16, 64}, {1, 1, 64}},
+                                       {{4, 16, 64}, {1, 16, 1}},
+                                       {{2, 16, 8, 8}, {2, 16, 8, 8}},
+                                       {{2, 16, 8, 8}, {1, 16, 1, 1}},
+                                       {{2, 16, 8, 8}, {1, 1, 8, 8}},
+                                       {{2, 4, 4, 8, 8}, {2, 4, 4, 8, 8}},
+                                       {{2, 4, 4, 8, 8}, {1, 4, 1, 1, 1}}};
+    const std::vector<Scalars> scalars = {{1, 1, 0}, {2, 3, 0}, {2, 3, 1}, {0, 1, 0}};
+
+    miopen::Handle memoized;
+    auto buffer = memoized.Create<float>(2 * 4 * 4 * 8 * 8 + 8);
+    for(const auto& shape : shapes)
+    {
+        for(const auto& s : scalars)
+        {
+            miopen::Handle fresh;
+            const auto expected = Run(fresh, shape, s, buffer.get());
+            EXPECT(expected.size() == 1);
+            EXPECT(SameLaunches(Run(memoized, shape, s, buffer.get()), expected));
+            EXPECT(SameLaunches(Run(memoized, shape, s, buffer.get()), expected));
+        }
+    }
+}
+
+/// Shapes no kernel handles, like tensors without dimensions, launch nothing and are not
+/// remembered.
+void check_unhandled_shapes()
+{
+    miopen::Handle h;
+    auto buffer = h.Create<float>(1);
+    const Shape empty{{}, {}};
+    EXPECT(Run(h, empty, {1, 1, 0}, buffer.get()).empty());
+    EXPECT(Run(h, empty, {1, 1, 0}, buffer.get()).empty());
+    EXPECT(h.op_tensor_launches.Size() == 0);
+
+    EXPECT(Run(h, {{64}, {64}}, {1, 1, 0}, buffer.get()).size() == 1);
+    EXPECT(h.op_tensor_launches.Size() == 1);
+}
+
+int main()
+{
+    check_memoized_launches();
+    check_unhandled_shapes();
+}
+
+#else
+
+int main() {}
+
+#endif
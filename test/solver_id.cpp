@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/any_solver.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <cstdint>
+#include <set>
+#include <string>
+
+#include "test.hpp"
+
+int main()
+{
+    using miopen::solver::Id;
+
+    EXPECT(!Id{}.IsValid());
+    EXPECT(!Id{Id::invalid_value}.IsValid());
+    EXPECT(!Id{"NotARegisteredSolver"}.IsValid());
+    EXPECT(!Id{""}.IsValid());
+    EXPECT(Id::gemm().IsValid());
+    EXPECT(Id::fft().IsValid());
+    EXPECT(Id::gemm().GetSolver().IsEmpty());
+    EXPECT(Id::fft().GetSolver().IsEmpty());
+
+    std::set<std::string> names;
+    std::size_t valid = 0;
+
+    for(uint64_t value = 1; value < 1024; ++value)
+    {
+        const auto id = Id{value};
+        if(!id.IsValid())
+        {
+            EXPECT(id.GetSolver().IsEmpty());
+            continue;
+        }
+
+        ++valid;
+        const auto name = id.ToString();
+        EXPECT(names.insert(name).second);
+        EXPECT(Id{name} == id);
+        EXPECT_EQUAL(Id{name}.Value(), value);
+
+        const auto solver = id.GetSolver();
+        if(!solver.IsEmpty())
+            EXPECT_EQUAL(solver.GetSolverDbId(), name);
+    }
+
+    EXPECT(valid > 2);
+}
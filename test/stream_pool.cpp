@@ -0,0 +1,216 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/handle.hpp>
+#include <map>
+#include <set>
+#include <vector>
+#include "test.hpp"
+
+#if MIOPEN_BACKEND_MOCK
+
+const std::string write_kernel = "__kernel void write(__global int* data, int value) {}\n";
+
+struct Launcher
+{
+    miopen::Handle& h;
+    miopen::Allocator::ManageDataPtr buffer;
+
+    Launcher(miopen::Handle& x) : h(x), buffer(h.Create<int>(16)) {}
+
+    void operator()(int value)
+    {
+        h.AddKernel("NoAlgo",
+                    "stream_pool",
+                    "write.cl",
+                    "write",
+                    {16, 1, 1},
+                    {64, 1, 1},
+                    "",
+                    0,
+                    false,
+                    write_kernel)(buffer.get(), value);
+    }
+};
+
+// Launches each launch has to wait for, either on its own stream or through waits on others.
+std::vector<std::set<std::size_t>> dependencies(const miopen::MockLaunchLog& log)
+{
+    std::map<void*, std::set<std::size_t>> seen;
+    std::vector<std::set<std::size_t>> result;
+    auto wait = log.waits.begin();
+    for(std::size_t i = 0; i < log.launches.size(); ++i)
+    {
+        for(; wait != log.waits.end() && wait->launch == i; ++wait)
+        {
+            const auto signaled = seen[wait->signaling];
+            seen[wait->waiting].insert(signaled.begin(), signaled.end());
+        }
+        auto& stream = seen[log.launches[i].stream];
+        result.push_back(stream);
+        stream.insert(i);
+    }
+    return result;
+}
+
+void check_without_pool()
+{
+    miopen::Handle h;
+    Launcher launch{h};
+    auto& log = h.GetMockLaunches();
+    log.keep  = true;
+
+    EXPECT(h.GetStreamPoolSize() == 0);
+    {
+        miopen::StreamFork fork{h, 2};
+        fork.Branch(0);
+        launch(0);
+        fork.Branch(1);
+        launch(1);
+    }
+    EXPECT(log.waits.empty());
+    EXPECT(log.launches.size() == 2);
+    EXPECT(log.launches[0].stream == h.GetStream());
+    EXPECT(log.launches[1].stream == h.GetStream());
+}
+
+void check_fork_join()
+{
+    miopen::Handle h;
+    Launcher launch{h};
+    auto& log = h.GetMockLaunches();
+    log.keep  = true;
+    h.SetStreamPoolSize(2);
+    EXPECT(h.GetStreamPoolSize() == 2);
+    const auto main = h.GetStream();
+
+    launch(0);
+    {
+        miopen::StreamFork fork{h, 3};
+        for(int i = 0; i < 3; ++i)
+        {
+            fork.Branch(i);
+            launch(1 + i);
+        }
+        fork.Join();
+        EXPECT(h.GetStream() == main);
+        launch(4);
+    }
+
+    EXPECT(log.launches.size() == 5);
+    EXPECT(log.launches[1].stream == main);
+    EXPECT(log.launches[2].stream != main);
+    EXPECT(log.launches[3].stream != main);
+    EXPECT(log.launches[2].stream != log.launches[3].stream);
+    EXPECT(log.launches[4].stream == main);
+
+    const auto deps = dependencies(log);
+    // The branches start after the work queued before the fork and not after each other.
+    EXPECT(deps[1] == std::set<std::size_t>{0});
+    EXPECT(deps[2] == std::set<std::size_t>{0});
+    EXPECT(deps[3] == std::set<std::size_t>{0});
+    // After the join the main stream waits for all of them.
+    EXPECT(deps[4] == (std::set<std::size_t>{0, 1, 2, 3}));
+    EXPECT(log.waits.size() == 4);
+}
+
+void check_shared_streams()
+{
+    miopen::Handle h;
+    Launcher launch{h};
+    auto& log = h.GetMockLaunches();
+    log.keep  = true;
+    h.SetStreamPoolSize(1);
+
+    {
+        miopen::StreamFork fork{h, 4};
+        for(int i = 0; i < 4; ++i)
+        {
+            fork.Branch(i);
+            launch(i);
+        }
+    }
+    launch(4);
+
+    // Two streams for four branches, the branches sharing a stream run in order.
+    const auto deps = dependencies(log);
+    EXPECT(log.launches[0].stream == log.launches[2].stream);
+    EXPECT(log.launches[1].stream == log.launches[3].stream);
+    EXPECT(deps[2] == std::set<std::size_t>{0});
+    EXPECT(deps[3] == std::set<std::size_t>{1});
+    EXPECT(deps[4] == (std::set<std::size_t>{0, 1, 2, 3}));
+}
+
+void check_capture()
+{
+    miopen::Handle h;
+    Launcher launch{h};
+    auto& log = h.GetMockLaunches();
+    log.keep  = true;
+    h.SetStreamPoolSize(2);
+
+    // Replays do not wait between streams, so captured branches stay on the main stream.
+    h.BeginCapture();
+    {
+        miopen::StreamFork fork{h, 2};
+        fork.Branch(1);
+        launch(0);
+    }
+    EXPECT(h.EndCapture().GetLaunchCount() == 1);
+    EXPECT(log.launches.back().stream == h.GetStream());
+    EXPECT(log.waits.empty());
+
+    miopen::StreamFork fork{h, 2};
+    EXPECT(throws([&] { h.BeginCapture(); }));
+}
+
+void check_errors()
+{
+    miopen::Handle h;
+    h.SetStreamPoolSize(1);
+    miopen::StreamFork fork{h, 2};
+    EXPECT(throws([&] { h.Fork(2); }));
+    EXPECT(throws([&] { h.SetStreamPoolSize(2); }));
+    EXPECT(throws([&] { h.SetStream(nullptr); }));
+    fork.Join();
+    h.SetStreamPoolSize(0);
+    EXPECT(h.GetStreamPoolSize() == 0);
+}
+
+int main()
+{
+    check_without_pool();
+    check_fork_join();
+    check_shared_streams();
+    check_capture();
+    check_errors();
+}
+
+#else
+
+int main() {}
+
+#endif
@@ -124,6 +124,17 @@ struct tensor
         assert(dims.size() == strides.size());
     }
 
+    tensor(const miopen::TensorDims& dims)
+        : desc(miopen_type<T>{}, dims), data(desc.GetElementSize())
+    {
+    }
+
+    tensor(const miopen::TensorDims& dims, const miopen::TensorDims& strides)
+        : desc(miopen_type<T>{}, dims, strides), data(desc.GetElementSize())
+    {
+        assert(dims.size() == strides.size());
+    }
+
     tensor(std::size_t n, std::size_t c, std::size_t h, std::size_t w)
         : desc(miopen_type<T>{}, {n, c, h, w}), data(n * c * h * w)
     {
@@ -826,6 +826,43 @@ void check_null_tensor()
     EXPECT(miopenSet4dTensorDescriptor(nullptr, miopenFloat, 100, 32, 8, 8) != miopenStatusSuccess);
 }
 
+void check_tensor_hash()
+{
+    const auto a = miopen::TensorDescriptor{miopenFloat, {100, 32, 8, 8}};
+    const auto b = miopen::TensorDescriptor{miopenFloat, {100, 32, 8, 8}, {2048, 64, 8, 1}};
+    const auto c = miopen::TensorDescriptor{miopenHalf, {100, 32, 8, 8}};
+    const auto d = miopen::TensorDescriptor{miopenFloat, {100, 32, 8, 8}, {4096, 64, 8, 1}};
+    EXPECT(a == b);
+    EXPECT(a.GetHash() == b.GetHash());
+    EXPECT(a != c);
+    EXPECT(a.GetHash() != c.GetHash());
+    EXPECT(a != d);
+    EXPECT(a.GetHash() != d.GetHash());
+    EXPECT(!d.IsPacked());
+
+    auto e = d;
+    EXPECT(e == d);
+    EXPECT(e.GetHash() == d.GetHash());
+    e = a;
+    EXPECT(e == a);
+    EXPECT(e.GetElementSize() == 100 * 32 * 8 * 8);
+}
+
+void check_tensor_many_dims()
+{
+    // More dimensions than are stored inline.
+    const std::vector<std::size_t> lens = {2, 1, 3, 1, 2, 1, 2, 1, 3, 2};
+    const auto desc                     = miopen::TensorDescriptor{miopenFloat, lens};
+    EXPECT(desc.GetSize() == 10);
+    EXPECT(desc.GetElementSize() == 144);
+    EXPECT(desc.IsPacked());
+    const std::vector<std::size_t> copied = desc.GetLengths();
+    EXPECT(copied == lens);
+    EXPECT(desc.GetStrides().front() == 72);
+    EXPECT(desc.GetStrides().back() == 1);
+    EXPECT(desc.GetIndex(1, 0, 2, 0, 1, 0, 1, 0, 2, 1) == 72 + 2 * 24 + 12 + 6 + 2 * 2 + 1);
+}
+
 int main()
 {
     // printf("Running 1-D.\n");
@@ -860,4 +897,6 @@ int main()
 
     run_test<check_tensor_support>();
     check_null_tensor();
+    check_tensor_hash();
+    check_tensor_many_dims();
 }
@@ -0,0 +1,179 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/trace.hpp>
+#include <miopen/handle.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "test.hpp"
+
+std::string export_trace()
+{
+    std::ostringstream ss;
+    miopen::trace::Export(ss);
+    return ss.str();
+}
+
+std::size_t count(const std::string& str, const std::string& what)
+{
+    std::size_t n = 0;
+    for(auto pos = str.find(what); pos != std::string::npos; pos = str.find(what, pos + 1))
+        ++n;
+    return n;
+}
+
+void traced_function(int value)
+{
+    MIOPEN_TRACE_SCOPE(Api, "traced_function");
+    MIOPEN_TRACE_INSTANT(KernelCache, "traced_instant", value);
+}
+
+void check_disabled()
+{
+    miopen::trace::Enable(false);
+    miopen::trace::Clear();
+    traced_function(1);
+    EXPECT(count(export_trace(), "traced_") == 0);
+}
+
+void check_events()
+{
+    miopen::trace::Enable();
+    miopen::trace::Clear();
+    traced_function(42);
+    miopen::trace::Enable(false);
+
+    const auto trace = export_trace();
+    EXPECT(trace.find("{\"traceEvents\":[") == 0);
+    EXPECT(count(trace, "\"name\":\"traced_function\",\"cat\":\"api\",\"ph\":\"B\"") == 1);
+    EXPECT(count(trace, "\"name\":\"traced_function\",\"cat\":\"api\",\"ph\":\"E\"") == 1);
+    EXPECT(count(trace, "\"name\":\"traced_instant\",\"cat\":\"kernel_cache\",\"ph\":\"i\"") ==
+           1);
+    EXPECT(count(trace, "\"s\":\"t\",\"args\":{\"arg\":42}") == 1);
+    EXPECT(trace.find("traced_function") < trace.find("traced_instant"));
+    EXPECT(trace.rfind("traced_function") > trace.find("traced_instant"));
+
+    miopen::trace::Clear();
+    EXPECT(count(export_trace(), "traced_") == 0);
+}
+
+void check_intern()
+{
+    const auto name = miopen::trace::Intern(std::string{"quote\"name"});
+    EXPECT(name == miopen::trace::Intern("quote\"name"));
+    EXPECT(name == std::string{"quote\"name"});
+
+    std::thread([&] { EXPECT(name == miopen::trace::Intern("quote\"name")); }).join();
+
+    miopen::trace::Enable();
+    miopen::trace::Clear();
+    MIOPEN_TRACE_INSTANT(Launch, name, 0);
+    miopen::trace::Enable(false);
+    EXPECT(count(export_trace(), "\"name\":\"quote\\\"name\"") == 1);
+}
+
+void check_wrap()
+{
+    miopen::trace::Enable();
+    miopen::trace::Clear();
+    {
+        MIOPEN_TRACE_SCOPE(Api, "outer_scope");
+        for(auto i = 0; i < 4; ++i)
+            traced_function(i);
+    }
+    miopen::trace::Enable(false);
+
+    // 14 events were recorded and the last 8 are kept. The ends whose begins were overwritten
+    // are dropped, which leaves the last two calls.
+    const auto trace = export_trace();
+    EXPECT(count(trace, "\"name\":") == 6);
+    EXPECT(count(trace, "outer_scope") == 0);
+    EXPECT(count(trace, "\"ph\":\"B\"") == 2);
+    EXPECT(count(trace, "\"ph\":\"E\"") == 2);
+    EXPECT(count(trace, "{\"arg\":1}") == 0);
+    EXPECT(count(trace, "{\"arg\":2}") == 1);
+    EXPECT(count(trace, "{\"arg\":3}") == 1);
+}
+
+/// Exports while another thread keeps overwriting its events. Every exported event has to be
+/// one that was recorded, not a mix of two.
+void check_concurrent_export()
+{
+    miopen::trace::Enable();
+    miopen::trace::Clear();
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for(std::uint64_t i = 0; !done.load(); ++i)
+        {
+            MIOPEN_TRACE_INSTANT(Launch, i % 2 == 0 ? "racing_even" : "racing_odd", i);
+            std::this_thread::yield();
+        }
+    });
+
+    std::size_t exported = 0;
+    for(auto i = 0; i < 100000 && exported < 1000; ++i)
+    {
+        const auto trace = export_trace();
+        for(auto pos = trace.find("racing_"); pos != std::string::npos;
+            pos      = trace.find("racing_", pos + 1))
+        {
+            const auto even = trace.compare(pos, 11, "racing_even") == 0;
+            const auto arg  = trace.find("{\"arg\":", pos);
+            EXPECT(arg != std::string::npos);
+            EXPECT((std::stoull(trace.substr(arg + 7)) % 2 == 0) == even);
+            ++exported;
+        }
+    }
+    done = true;
+    writer.join();
+    miopen::trace::Enable(false);
+    EXPECT(exported > 0);
+}
+
+void check_kernel_cache()
+{
+    miopen::Handle h;
+    miopen::trace::Enable();
+    miopen::trace::Clear();
+    EXPECT(h.GetKernels("NoAlgo", "trace").empty());
+    miopen::trace::Enable(false);
+    EXPECT(count(export_trace(), "\"name\":\"GetKernels\",\"cat\":\"kernel_cache\"") == 1);
+}
+
+int main()
+{
+    // Read once, before the first event is recorded.
+    setenv("MIOPEN_TRACE_BUFFER_EVENTS", "8", 1);
+    check_disabled();
+    check_events();
+    check_intern();
+    check_wrap();
+    check_concurrent_export();
+    check_kernel_cache();
+}
@@ -0,0 +1,291 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_TOOLS_CONV_PROBLEM_PARSER_HPP
+#define GUARD_MIOPEN_TOOLS_CONV_PROBLEM_PARSER_HPP
+
+#include <miopen/conv_solution.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tools {
+
+/// 2D convolution problem as described by a MIOpenDriver command line, for example
+/// one printed by MIOPEN_ENABLE_LOGGING_CMD:
+///
+///   MIOpen(HIP): Command [LogCmdConvolution] ./bin/MIOpenDriver conv -n 128 -c 64 ... -F 1
+///
+/// Everything before the "conv*" token is ignored, so both raw driver arguments and
+/// log lines are accepted. Options which do not affect the problem config are skipped.
+struct ConvProblemConfig
+{
+    enum Direction
+    {
+        Forward      = 1,
+        BackwardData = 2,
+        BackwardWrW  = 4,
+    };
+
+    std::string command;
+    miopenDataType_t data_type = miopenFloat;
+    int batchsize              = 100;
+    int in_channels            = 3;
+    int in_h                   = 32;
+    int in_w                   = 32;
+    int out_channels           = 32;
+    int fil_h                  = 3;
+    int fil_w                  = 3;
+    int pad_h                  = 0;
+    int pad_w                  = 0;
+    int conv_stride_h          = 1;
+    int conv_stride_w          = 1;
+    int dilation_h             = 1;
+    int dilation_w             = 1;
+    int group_count            = 1;
+    int spatial_dim            = 2;
+    bool transposed            = false;
+    int directions             = Forward | BackwardData | BackwardWrW;
+
+    /// Returns false if the line does not contain a convolution command.
+    bool Parse(const std::string& line)
+    {
+        std::istringstream ss(line);
+        std::vector<std::string> args;
+        std::string arg;
+        bool found = false;
+        while(ss >> arg)
+        {
+            if(!found)
+            {
+                if(arg == "conv")
+                    data_type = miopenFloat;
+                else if(arg == "convfp16")
+                    data_type = miopenHalf;
+                else if(arg == "convbfp16")
+                    data_type = miopenBFloat16;
+                else if(arg == "convint8")
+                    data_type = miopenInt8;
+                else
+                    continue;
+                found = true;
+                // Take the command from this token, its name may also be part of a path before.
+                const auto end = ss.eof() ? line.size() : static_cast<std::size_t>(ss.tellg());
+                command        = line.substr(end - arg.size());
+                continue;
+            }
+            args.push_back(arg);
+        }
+        if(!found)
+            return false;
+
+        for(std::size_t i = 0; i + 1 < args.size();)
+            i += Set(args[i], args[i + 1]) ? 2 : 1; // Skip stray values.
+        return true;
+    }
+
+    /// Parses the key of a find-db record, for example:
+    ///
+    ///   576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F_g2
+    ///
+    /// Only 2D keys are recognized. Returns false if the key can not be parsed.
+    bool ParseDbKey(const std::string& key)
+    {
+        const auto optional = key.find('_');
+        std::istringstream ss(key.substr(0, optional));
+        std::vector<std::string> tokens;
+        std::string token;
+        while(std::getline(ss, token, '-'))
+            tokens.push_back(token);
+        if(tokens.size() != 15)
+            return false;
+
+        const auto to_int = [](const std::string& t) { return std::atoi(t.c_str()); };
+        const auto to_pair = [](const std::string& t, int& first, int& second) {
+            return std::sscanf(t.c_str(), "%dx%d", &first, &second) == 2;
+        };
+
+        // In backward directions, the key describes the problem in terms of y (dy) as input.
+        const auto& dir = tokens[14];
+        const bool fwd  = dir == "F";
+        if(!fwd && dir != "B" && dir != "W")
+            return false;
+        directions   = fwd ? Forward : dir == "B" ? BackwardData : BackwardWrW;
+        in_channels  = to_int(tokens[fwd ? 0 : 4]);
+        in_h         = to_int(tokens[fwd ? 1 : 5]);
+        in_w         = to_int(tokens[fwd ? 2 : 6]);
+        out_channels = to_int(tokens[fwd ? 4 : 0]);
+        batchsize    = to_int(tokens[7]);
+        if(!to_pair(tokens[3], fil_h, fil_w) || !to_pair(tokens[8], pad_h, pad_w) ||
+           !to_pair(tokens[9], conv_stride_h, conv_stride_w) ||
+           !to_pair(tokens[10], dilation_h, dilation_w))
+            return false;
+
+        const auto& type = tokens[13];
+        if(type == "FP32")
+            data_type = miopenFloat;
+        else if(type == "FP16")
+            data_type = miopenHalf;
+        else if(type == "BF16")
+            data_type = miopenBFloat16;
+        else if(type.compare(0, 4, "INT8") == 0)
+            data_type = miopenInt8;
+        else
+            return false;
+
+        group_count = 1;
+        if(optional != std::string::npos && key.compare(optional, 2, "_g") == 0)
+            group_count = to_int(key.substr(optional + 2));
+        spatial_dim = 2;
+        transposed  = false;
+        command     = key;
+        return true;
+    }
+
+    bool IsSupported() const { return spatial_dim == 2 && !transposed; }
+
+    TensorDescriptor GetInput() const
+    {
+        return {data_type,
+                {static_cast<std::size_t>(batchsize),
+                 static_cast<std::size_t>(in_channels),
+                 static_cast<std::size_t>(in_h),
+                 static_cast<std::size_t>(in_w)}};
+    }
+
+    TensorDescriptor GetWeights() const
+    {
+        return {data_type,
+                {static_cast<std::size_t>(out_channels),
+                 static_cast<std::size_t>(in_channels / group_count),
+                 static_cast<std::size_t>(fil_h),
+                 static_cast<std::size_t>(fil_w)}};
+    }
+
+    ConvolutionDescriptor GetConvolution() const
+    {
+        return ConvolutionDescriptor{{pad_h, pad_w},
+                                     {conv_stride_h, conv_stride_w},
+                                     {dilation_h, dilation_w},
+                                     {0, 0},
+                                     group_count};
+    }
+
+    /// Builds fully initialized context, the same way Find does.
+    ConvolutionContext MakeContext(Handle& handle, Direction direction) const
+    {
+        const auto x    = GetInput();
+        const auto w    = GetWeights();
+        const auto conv = GetConvolution();
+        const auto y    = conv.GetForwardOutputTensor(x, w, data_type);
+
+        auto ctx = ConvolutionContext{x, w, y, conv, direction == Forward ? 1 : 0};
+        if(direction == BackwardWrW)
+            ctx.direction.SetBackwardWrW();
+        ctx.SetStream(&handle);
+        ctx.DetectRocm();
+        ctx.SetupFloats();
+        return ctx;
+    }
+
+    static const char* ToString(Direction direction)
+    {
+        switch(direction)
+        {
+        case Forward: return "F";
+        case BackwardData: return "B";
+        case BackwardWrW: return "W";
+        }
+        return "?";
+    }
+
+    private:
+    bool Set(const std::string& name, const std::string& value)
+    {
+        const auto v = std::atoi(value.c_str());
+        // clang-format off
+        if(name == "-n" || name == "--batchsize") batchsize = v;
+        else if(name == "-c" || name == "--in_channels") in_channels = v;
+        else if(name == "-H" || name == "--in_h") in_h = v;
+        else if(name == "-W" || name == "--in_w") in_w = v;
+        else if(name == "-k" || name == "--out_channels") out_channels = v;
+        else if(name == "-y" || name == "--fil_h") fil_h = v;
+        else if(name == "-x" || name == "--fil_w") fil_w = v;
+        else if(name == "-p" || name == "--pad_h") pad_h = v;
+        else if(name == "-q" || name == "--pad_w") pad_w = v;
+        else if(name == "-u" || name == "--conv_stride_h") conv_stride_h = v;
+        else if(name == "-v" || name == "--conv_stride_w") conv_stride_w = v;
+        else if(name == "-l" || name == "--dilation_h") dilation_h = v;
+        else if(name == "-j" || name == "--dilation_w") dilation_w = v;
+        else if(name == "-g" || name == "--group_count") group_count = v;
+        else if(name == "-_" || name == "--spatial_dim") spatial_dim = v;
+        else if(name == "-m" || name == "--mode") transposed = (value == "trans");
+        else if(name == "-F" || name == "--forw") directions = (v == 0) ? (Forward | BackwardData | BackwardWrW) : v;
+        else if(name.size() > 1 && name[0] == '-') return true; // Known to have a value.
+        else return false;
+        // clang-format on
+        return true;
+    }
+};
+
+/// All solutions applicable to the problem in the direction, without auto-tuning.
+inline std::vector<solver::ConvSolution> GetAllSolutions(const ConvolutionContext& ctx,
+                                                         ConvProblemConfig::Direction direction)
+{
+    std::vector<solver::ConvSolution> all;
+    const auto append = [&](const std::vector<solver::ConvSolution>& ss) {
+        all.insert(all.end(), ss.begin(), ss.end());
+    };
+
+    if(direction == ConvProblemConfig::BackwardWrW)
+    {
+        append(FindAllBwdWrW2DSolutions(ctx));
+        append(FindWinogradWrWAllSolutions(ctx));
+        append(FindImplicitGemmWrWAllSolutions(ctx));
+    }
+    else
+    {
+        append(FindAllDirectSolutions(ctx));
+        append(FindAllImplicitGemmSolutions(ctx));
+        append(FindAllWinogradSolutions(ctx));
+        if(direction == ConvProblemConfig::Forward)
+            append(FindAllFwdSCGemmSolutions(ctx));
+    }
+    return all;
+}
+
+} // namespace tools
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TOOLS_CONV_PROBLEM_PARSER_HPP
@@ -0,0 +1,225 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Measures the host time spent dispatching convolution layers with and without an
+/// ExecutionPlan. Without a plan every layer builds its problem description and network
+/// config, looks its kernels up in the kernel cache and packs the kernel arguments, as
+/// immediate mode does. With a plan the launches recorded on the first step are re-bound to
+/// new buffers and replayed. Launches go to a mock that only consumes the packed arguments,
+/// so no GPU is needed and only host overhead is measured.
+
+#include <miopen/config.h>
+#include <miopen/convolution.hpp>
+#include <miopen/execution_plan.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tools {
+
+struct Options
+{
+    std::size_t layers = 50;
+    std::size_t steps  = 2000;
+};
+
+struct Layer
+{
+    TensorDescriptor x;
+    TensorDescriptor w;
+    TensorDescriptor y;
+    ConvolutionDescriptor conv;
+    std::vector<char> in;
+    std::vector<char> weights;
+    std::vector<char> out;
+};
+
+struct MockDevice
+{
+    std::size_t launches = 0;
+    std::uint64_t sum    = 0;
+
+    void Launch(const void* args, std::size_t size)
+    {
+        std::uint64_t first = 0;
+        std::memcpy(&first, args, std::min(size, sizeof(first)));
+        sum += first;
+        ++launches;
+    }
+};
+
+#if !MIOPEN_BACKEND_OPENCL
+
+const char* const algorithm = "miopenConvolutionFwdAlgoDirect";
+
+std::vector<Layer> MakeLayers(std::size_t count)
+{
+    const auto buffer = [](const TensorDescriptor& desc) {
+        return std::vector<char>(desc.GetNumBytes());
+    };
+
+    std::vector<Layer> layers;
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const std::size_t c  = 64 << (i % 4);
+        const std::size_t hw = 56 >> (i % 4);
+        const std::size_t k  = i % 3 == 0 ? 1 : 3;
+        const int pad        = k / 2;
+        auto conv            = ConvolutionDescriptor{{pad, pad}, {1, 1}, {1, 1}};
+        const auto x         = TensorDescriptor{miopenFloat, {8, c, hw, hw}};
+        const auto w         = TensorDescriptor{miopenFloat, {c, c, k, k}};
+        const auto y         = conv.GetForwardOutputTensor(x, w);
+        layers.push_back(Layer{x, w, y, conv, buffer(x), buffer(w), buffer(y)});
+    }
+    return layers;
+}
+
+std::string NetworkConfig(const Layer& layer)
+{
+    const auto problem = ProblemDescription{layer.x, layer.w, layer.y, layer.conv, 1};
+    std::string network_config;
+    problem.mloBuildConf_Key(network_config);
+    return network_config;
+}
+
+template <class... Ts>
+void Launch(MockDevice& device, ExecutionPlan* capture, Ts... xs)
+{
+    KernelArgs<Ts...> args{xs...};
+    if(capture != nullptr)
+    {
+        capture->Record([&device](void* a, std::size_t size) { device.Launch(a, size); },
+                        &args,
+                        sizeof(args),
+                        KernelArgsPointerOffsets<Ts...>());
+    }
+    device.Launch(&args, sizeof(args));
+}
+
+void Dispatch(Layer& layer, KernelCache& cache, MockDevice& device, ExecutionPlan* capture)
+{
+    const auto network_config = NetworkConfig(layer);
+    const auto& kernels       = cache.GetKernels(algorithm, network_config);
+    if(kernels.empty())
+        MIOPEN_THROW("Kernel not found: " + network_config);
+    Launch(device,
+           capture,
+           static_cast<ConstData_t>(layer.in.data()),
+           static_cast<ConstData_t>(layer.weights.data()),
+           static_cast<Data_t>(layer.out.data()),
+           0.0f);
+}
+
+void Run(const Options& options)
+{
+    auto layers = MakeLayers(options.layers);
+    KernelCache cache;
+    for(const auto& layer : layers)
+        cache.AddKernel({algorithm, NetworkConfig(layer)}, Kernel{}, 0);
+
+    MockDevice device;
+    ExecutionPlan plan;
+    for(auto& layer : layers)
+        Dispatch(layer, cache, device, &plan);
+
+    // Replays run on buffers the plan has not seen, as with a new batch.
+    auto other_layers = MakeLayers(options.layers);
+    std::vector<ExecutionPlan::Binding> bindings;
+    for(std::size_t i = 0; i < layers.size(); ++i)
+    {
+        bindings.emplace_back(layers[i].in.data(), other_layers[i].in.data());
+        bindings.emplace_back(layers[i].weights.data(), other_layers[i].weights.data());
+        bindings.emplace_back(layers[i].out.data(), other_layers[i].out.data());
+    }
+
+    using clock   = std::chrono::steady_clock;
+    const auto us = [](clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+
+    const auto dispatch_start = clock::now();
+    for(std::size_t step = 0; step < options.steps; ++step)
+        for(auto& layer : other_layers)
+            Dispatch(layer, cache, device, nullptr);
+    const auto dispatch = us(clock::now() - dispatch_start);
+
+    plan.Bind(bindings);
+    const auto replay_start = clock::now();
+    for(std::size_t step = 0; step < options.steps; ++step)
+        plan.Replay();
+    const auto replay = us(clock::now() - replay_start);
+
+    const auto rebind_start = clock::now();
+    for(std::size_t step = 0; step < options.steps; ++step)
+        plan.Replay(bindings);
+    const auto rebind = us(clock::now() - rebind_start);
+
+    const auto per_layer = [&](double total) { return total / options.steps / layers.size(); };
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "layers: " << layers.size() << ", steps: " << options.steps
+              << ", launches: " << device.launches << std::endl;
+    std::cout << "immediate dispatch, us/layer:\t" << per_layer(dispatch) << std::endl;
+    std::cout << "plan replay, us/layer:\t\t" << per_layer(replay) << std::endl;
+    std::cout << "plan rebind+replay, us/layer:\t" << per_layer(rebind) << std::endl;
+}
+
+#else
+
+void Run(const Options&) { std::cerr << "The OpenCL backend is not supported" << std::endl; }
+
+#endif
+
+} // namespace tools
+} // namespace miopen
+
+int main(int argc, char* argv[])
+{
+    miopen::tools::Options options;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "--layers" && i + 1 < argc)
+            options.layers = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else if(arg == "--steps" && i + 1 < argc)
+            options.steps = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--layers <n>] [--steps <n>]\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+    miopen::tools::Run(options);
+}
@@ -0,0 +1,367 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Measures the host time of one MIOpen API call for convolution, batch normalization, pooling
+/// and tensor operations. Meant for the Mock backend (-DMIOPEN_BACKEND=Mock), where buffers
+/// live in host memory and kernels are recorded instead of launched, so the timings contain
+/// only host overhead and can be tracked in CI without a GPU. On a real backend the timings
+/// also contain the launch and any synchronization the calls do.
+
+#include <miopen/config.h>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/miopen.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tools {
+
+struct Options
+{
+    std::size_t iterations = 1000;
+    std::size_t warmup     = 10;
+    std::string filter;
+};
+
+void Check(miopenStatus_t status, const std::string& what)
+{
+    if(status != miopenStatusSuccess)
+        MIOPEN_THROW(status, what + " failed");
+}
+
+struct Tensor
+{
+    Tensor(Handle& handle, int n, int c, int h, int w)
+    {
+        Check(miopenCreateTensorDescriptor(&desc), "miopenCreateTensorDescriptor");
+        Check(miopenSet4dTensorDescriptor(desc, miopenFloat, n, c, h, w),
+              "miopenSet4dTensorDescriptor");
+        buffer = handle.Create(static_cast<std::size_t>(n) * c * h * w * sizeof(float));
+    }
+    Tensor(const Tensor&) = delete;
+    Tensor& operator=(const Tensor&) = delete;
+    ~Tensor() { miopenDestroyTensorDescriptor(desc); }
+
+    void* data() const { return buffer.get(); }
+
+    miopenTensorDescriptor_t desc = nullptr;
+    Allocator::ManageDataPtr buffer;
+};
+
+struct Case
+{
+    std::string name;
+    std::function<void()> call;
+};
+
+class Benchmark
+{
+    public:
+    Benchmark(const Options& options_) : options(options_)
+    {
+        Check(miopenCreate(&handle), "miopenCreate");
+    }
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+    ~Benchmark()
+    {
+        tensors.clear();
+        for(const auto conv : convs)
+            miopenDestroyConvolutionDescriptor(conv);
+        for(const auto pooling : poolings)
+            miopenDestroyPoolingDescriptor(pooling);
+        miopenDestroy(handle);
+    }
+
+    Tensor& MakeTensor(int n, int c, int h, int w)
+    {
+        tensors.emplace_back(new Tensor(deref(handle), n, c, h, w));
+        return *tensors.back();
+    }
+
+    void AddConvolution();
+    void AddBatchNorm();
+    void AddPooling();
+    void AddTensorOps();
+    void Run();
+
+    private:
+    std::size_t LaunchCount()
+    {
+#if MIOPEN_BACKEND_MOCK
+        return deref(handle).GetMockLaunches().count;
+#else
+        return 0;
+#endif
+    }
+
+    Options options;
+    miopenHandle_t handle = nullptr;
+    std::vector<std::unique_ptr<Tensor>> tensors;
+    std::vector<miopenConvolutionDescriptor_t> convs;
+    std::vector<miopenPoolingDescriptor_t> poolings;
+    std::vector<Case> cases;
+    float alpha = 1.0f;
+    float beta  = 0.0f;
+};
+
+void Benchmark::AddConvolution()
+{
+    miopenConvolutionDescriptor_t conv = nullptr;
+    Check(miopenCreateConvolutionDescriptor(&conv), "miopenCreateConvolutionDescriptor");
+    convs.push_back(conv);
+    Check(miopenInitConvolutionDescriptor(conv, miopenConvolution, 1, 1, 1, 1, 1, 1),
+          "miopenInitConvolutionDescriptor");
+
+    auto& x = MakeTensor(16, 64, 56, 56);
+    auto& w = MakeTensor(64, 64, 3, 3);
+    int n, c, h, wo;
+    Check(miopenGetConvolutionForwardOutputDim(conv, x.desc, w.desc, &n, &c, &h, &wo),
+          "miopenGetConvolutionForwardOutputDim");
+    auto& y = MakeTensor(n, c, h, wo);
+
+    std::size_t workspace_size = 0;
+    Check(miopenConvolutionForwardGetWorkSpaceSize(
+              handle, w.desc, x.desc, conv, y.desc, &workspace_size),
+          "miopenConvolutionForwardGetWorkSpaceSize");
+    auto workspace = std::make_shared<Allocator::ManageDataPtr>(
+        deref(handle).Create(std::max<std::size_t>(workspace_size, 1)));
+
+    miopenConvAlgoPerf_t perf;
+    int returned = 0;
+    Check(miopenFindConvolutionForwardAlgorithm(handle,
+                                                x.desc,
+                                                x.data(),
+                                                w.desc,
+                                                w.data(),
+                                                conv,
+                                                y.desc,
+                                                y.data(),
+                                                1,
+                                                &returned,
+                                                &perf,
+                                                workspace->get(),
+                                                workspace_size,
+                                                false),
+          "miopenFindConvolutionForwardAlgorithm");
+    const auto algo = perf.fwd_algo;
+
+    cases.push_back({"convolution forward", [=, &x, &w, &y] {
+                         Check(miopenConvolutionForward(handle,
+                                                        &alpha,
+                                                        x.desc,
+                                                        x.data(),
+                                                        w.desc,
+                                                        w.data(),
+                                                        conv,
+                                                        algo,
+                                                        &beta,
+                                                        y.desc,
+                                                        y.data(),
+                                                        workspace->get(),
+                                                        workspace_size),
+                               "miopenConvolutionForward");
+                     }});
+}
+
+void Benchmark::AddBatchNorm()
+{
+    auto& x          = MakeTensor(16, 64, 56, 56);
+    auto& y          = MakeTensor(16, 64, 56, 56);
+    auto& scale      = MakeTensor(1, 64, 1, 1);
+    auto& bias       = MakeTensor(1, 64, 1, 1);
+    auto& mean       = MakeTensor(1, 64, 1, 1);
+    auto& var        = MakeTensor(1, 64, 1, 1);
+    auto& saved_mean = MakeTensor(1, 64, 1, 1);
+    auto& saved_var  = MakeTensor(1, 64, 1, 1);
+    Check(miopenDeriveBNTensorDescriptor(scale.desc, x.desc, miopenBNSpatial),
+          "miopenDeriveBNTensorDescriptor");
+
+    cases.push_back({"batchnorm forward training", [&] {
+                         Check(miopenBatchNormalizationForwardTraining(handle,
+                                                                       miopenBNSpatial,
+                                                                       &alpha,
+                                                                       &beta,
+                                                                       x.desc,
+                                                                       x.data(),
+                                                                       y.desc,
+                                                                       y.data(),
+                                                                       scale.desc,
+                                                                       scale.data(),
+                                                                       bias.data(),
+                                                                       1.0,
+                                                                       mean.data(),
+                                                                       var.data(),
+                                                                       1e-5,
+                                                                       saved_mean.data(),
+                                                                       saved_var.data()),
+                               "miopenBatchNormalizationForwardTraining");
+                     }});
+    cases.push_back({"batchnorm forward inference", [&] {
+                         Check(miopenBatchNormalizationForwardInference(handle,
+                                                                        miopenBNSpatial,
+                                                                        &alpha,
+                                                                        &beta,
+                                                                        x.desc,
+                                                                        x.data(),
+                                                                        y.desc,
+                                                                        y.data(),
+                                                                        scale.desc,
+                                                                        scale.data(),
+                                                                        bias.data(),
+                                                                        mean.data(),
+                                                                        var.data(),
+                                                                        1e-5),
+                               "miopenBatchNormalizationForwardInference");
+                     }});
+}
+
+void Benchmark::AddPooling()
+{
+    miopenPoolingDescriptor_t pooling = nullptr;
+    Check(miopenCreatePoolingDescriptor(&pooling), "miopenCreatePoolingDescriptor");
+    poolings.push_back(pooling);
+    Check(miopenSet2dPoolingDescriptor(pooling, miopenPoolingMax, 2, 2, 0, 0, 2, 2),
+          "miopenSet2dPoolingDescriptor");
+
+    auto& x = MakeTensor(16, 64, 56, 56);
+    auto& y = MakeTensor(16, 64, 28, 28);
+
+    cases.push_back({"pooling forward", [=, &x, &y] {
+                         Check(miopenPoolingForward(handle,
+                                                    pooling,
+                                                    &alpha,
+                                                    x.desc,
+                                                    x.data(),
+                                                    &beta,
+                                                    y.desc,
+                                                    y.data(),
+                                                    false,
+                                                    nullptr,
+                                                    0),
+                               "miopenPoolingForward");
+                     }});
+}
+
+void Benchmark::AddTensorOps()
+{
+    auto& a = MakeTensor(16, 64, 56, 56);
+    auto& b = MakeTensor(1, 64, 1, 1);
+    auto& c = MakeTensor(16, 64, 56, 56);
+
+    cases.push_back({"op tensor add (bias)", [&] {
+                         Check(miopenOpTensor(handle,
+                                              miopenTensorOpAdd,
+                                              &alpha,
+                                              a.desc,
+                                              a.data(),
+                                              &alpha,
+                                              b.desc,
+                                              b.data(),
+                                              &beta,
+                                              c.desc,
+                                              c.data()),
+                               "miopenOpTensor");
+                     }});
+    cases.push_back({"set tensor", [&] {
+                         Check(miopenSetTensor(handle, c.desc, c.data(), &alpha),
+                               "miopenSetTensor");
+                     }});
+    cases.push_back({"scale tensor", [&] {
+                         Check(miopenScaleTensor(handle, c.desc, c.data(), &alpha),
+                               "miopenScaleTensor");
+                     }});
+}
+
+void Benchmark::Run()
+{
+    using clock = std::chrono::steady_clock;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "iterations: " << options.iterations << std::endl;
+    for(const auto& c : cases)
+    {
+        if(c.name.find(options.filter) == std::string::npos)
+            continue;
+        // The first calls build and cache kernels, they are not part of the steady state.
+        for(std::size_t i = 0; i < options.warmup; ++i)
+            c.call();
+
+        const auto launches = LaunchCount();
+        const auto start    = clock::now();
+        for(std::size_t i = 0; i < options.iterations; ++i)
+            c.call();
+        const auto total = std::chrono::duration<double, std::micro>(clock::now() - start);
+
+        std::cout << std::left << std::setw(32) << c.name
+                  << "us/call: " << total.count() / options.iterations;
+#if MIOPEN_BACKEND_MOCK
+        std::cout << "\tlaunches/call: "
+                  << static_cast<double>(LaunchCount() - launches) / options.iterations;
+#else
+        (void)launches;
+#endif
+        std::cout << std::endl;
+    }
+}
+
+} // namespace tools
+} // namespace miopen
+
+int main(int argc, char* argv[])
+{
+    miopen::tools::Options options;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "--iterations" && i + 1 < argc)
+            options.iterations = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else if(arg == "--warmup" && i + 1 < argc)
+            options.warmup = std::max(0L, std::strtol(argv[++i], nullptr, 10));
+        else if(arg == "--filter" && i + 1 < argc)
+            options.filter = argv[++i];
+        else
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--iterations <n>] [--warmup <n>] [--filter <case name part>]\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+    miopen::tools::Benchmark benchmark{options};
+    benchmark.AddConvolution();
+    benchmark.AddBatchNorm();
+    benchmark.AddPooling();
+    benchmark.AddTensorOps();
+    benchmark.Run();
+}
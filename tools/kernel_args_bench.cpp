@@ -0,0 +1,211 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Measures packing the arguments of a kernel launch, for the 12 argument launch of
+/// miopenGcnAsmConv1x1U in EvaluateDataDirectSolution. The arguments are packed either with
+/// their compile time KernelSignature, as the variadic KernelInvoke call does, or as a vector
+/// of OpKernelArg, as fusion plans do. On the Mock backend (-DMIOPEN_BACKEND=Mock) the launch
+/// through a KernelInvoke is measured as well.
+
+#include <miopen/config.h>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_args.hpp>
+#include <miopen/op_kernel_args.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tools {
+
+struct Options
+{
+    std::size_t iterations = 10000000;
+};
+
+// Keeps the compiler from dropping the measured work.
+std::size_t sink = 0;
+
+template <class F>
+void Measure(const std::string& name, std::size_t iterations, F f)
+{
+    for(std::size_t i = 0; i < std::min<std::size_t>(iterations, 100); ++i)
+        f(i);
+
+    using clock      = std::chrono::steady_clock;
+    const auto start = clock::now();
+    for(std::size_t i = 0; i < iterations; ++i)
+        f(i);
+    const auto ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+    std::cout << std::left << std::setw(32) << name << "ns/op: " << ns / iterations << std::endl;
+}
+
+struct Conv1x1UArgs
+{
+    int N            = 16;
+    int C            = 64;
+    int H            = 56;
+    int W            = 56;
+    int K            = 64;
+    int n_groups     = 4;
+    int unused       = 0;
+    int* return_addr = nullptr;
+    const void* in   = nullptr;
+    const void* w    = nullptr;
+    void* out        = nullptr;
+
+    std::vector<OpKernelArg> Vector(int n) const
+    {
+        return {n, C, H, W, K, n_groups, unused, unused, in, w, out, return_addr};
+    }
+};
+
+using Conv1x1USignature = KernelSignature<int,
+                                          int,
+                                          int,
+                                          int,
+                                          int,
+                                          int,
+                                          int,
+                                          int,
+                                          const void*,
+                                          const void*,
+                                          void*,
+                                          int*>;
+
+void Run(const Options& options)
+{
+    int in  = 0;
+    int w   = 0;
+    int out = 0;
+    Conv1x1UArgs a;
+    a.in  = &in;
+    a.w   = &w;
+    a.out = &out;
+
+    std::cout << "arguments: " << Conv1x1USignature::count
+              << ", packed size: " << Conv1x1USignature::Size()
+              << ", alignment: " << Conv1x1USignature::Alignment() << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    Measure("pack KernelSignature", options.iterations, [&](std::size_t i) {
+        const KernelArgs<int,
+                         int,
+                         int,
+                         int,
+                         int,
+                         int,
+                         int,
+                         int,
+                         const void*,
+                         const void*,
+                         void*,
+                         int*>
+            args{static_cast<int>(i),
+                 a.C,
+                 a.H,
+                 a.W,
+                 a.K,
+                 a.n_groups,
+                 a.unused,
+                 a.unused,
+                 a.in,
+                 a.w,
+                 a.out,
+                 a.return_addr};
+        sink += static_cast<unsigned char>(args.buffer[0]);
+    });
+
+    Measure("pack OpKernelArg vector", options.iterations, [&](std::size_t i) {
+        const auto any_args                   = a.Vector(static_cast<int>(i));
+        alignas(std::uint64_t) char args[256] = {0};
+        std::size_t size                      = 0;
+        for(const auto& any_arg : any_args)
+        {
+            const auto alignment = any_arg.size();
+            const auto offset    = size + (alignment - size % alignment) % alignment;
+            std::memcpy(args + offset, &(any_arg.buffer[0]), any_arg.size());
+            size = offset + alignment;
+        }
+        sink += static_cast<unsigned char>(args[0]) + size;
+    });
+
+#if MIOPEN_BACKEND_MOCK
+    Handle handle;
+    const auto kernel = handle.AddKernel(
+        "", "", "conv1x1u.s", "miopenGcnAsmConv1x1U", {64, 1, 1}, {64 * 196, 1, 1}, "");
+
+    Measure("launch KernelSignature", options.iterations, [&](std::size_t i) {
+        kernel(static_cast<int>(i),
+               a.C,
+               a.H,
+               a.W,
+               a.K,
+               a.n_groups,
+               a.unused,
+               a.unused,
+               a.in,
+               a.w,
+               a.out,
+               a.return_addr);
+    });
+    Measure("launch OpKernelArg vector", options.iterations, [&](std::size_t i) {
+        auto any_args = a.Vector(static_cast<int>(i));
+        kernel(any_args);
+    });
+    handle.Finish();
+#endif
+
+    if(sink == 0)
+        std::cout << std::endl;
+}
+
+} // namespace tools
+} // namespace miopen
+
+int main(int argc, char* argv[])
+{
+    miopen::tools::Options options;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "--iterations" && i + 1 < argc)
+            options.iterations = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--iterations <n>]\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+    miopen::tools::Run(options);
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Measures the throughput of kernel cache lookups from several threads.
+/// The cache is filled with the given number of keys which look like the
+/// ones of convolutions, then every thread looks them up in a loop. Both
+/// string based lookups and lookups with keys built in advance are measured.
+/// No GPU work is done: the cached kernels are empty.
+
+#include <miopen/kernel_cache.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tools {
+
+struct Options
+{
+    std::size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+    std::size_t keys        = 1000;
+    std::size_t lookups     = 1000000; // per thread
+};
+
+struct StringKey
+{
+    std::string algorithm;
+    std::string network_config;
+};
+
+template <class Lookup>
+double MeasureLookupsPerSecond(const Options& options, std::size_t n_threads, Lookup lookup)
+{
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for(std::size_t t = 0; t < n_threads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            auto found = std::size_t{0};
+            for(std::size_t i = 0; i < options.lookups; ++i)
+                found += lookup((i * 7919 + t * 104729) % options.keys) ? 1 : 0;
+            if(found != options.lookups)
+                std::cerr << "Unexpected cache miss" << std::endl;
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return n_threads * options.lookups / elapsed.count();
+}
+
+void Run(const Options& options)
+{
+    KernelCache cache;
+    std::vector<StringKey> string_keys;
+    std::vector<KernelCache::Key> keys;
+    for(std::size_t i = 0; i < options.keys; ++i)
+    {
+        string_keys.push_back({"miopenConvolutionFwdAlgoDirect",
+                               std::to_string(i % 7 + 1) + "x" + std::to_string(64 << (i % 4)) +
+                                   "x56x56x3x3x" + std::to_string(i) + "x1x1x1x1x1x1xNCHWxFP32xF"});
+    }
+    // Keys refer to the strings, which stay in place from now on.
+    for(const auto& key : string_keys)
+    {
+        keys.emplace_back(key.algorithm, key.network_config);
+        cache.AddKernel(keys.back(), Kernel{}, 0);
+    }
+
+    std::vector<std::size_t> thread_counts;
+    for(std::size_t n = 1; n < options.max_threads; n *= 2)
+        thread_counts.push_back(n);
+    thread_counts.push_back(options.max_threads);
+
+    std::cout << "threads\tstring_keys_Mops\tprebuilt_keys_Mops" << std::endl;
+    for(const auto n : thread_counts)
+    {
+        const auto by_strings = MeasureLookupsPerSecond(options, n, [&](std::size_t i) {
+            return !cache.GetKernels(string_keys[i].algorithm, string_keys[i].network_config)
+                        .empty();
+        });
+        const auto by_keys = MeasureLookupsPerSecond(
+            options, n, [&](std::size_t i) { return !cache.GetKernels(keys[i]).empty(); });
+        std::cout << n << '\t' << std::fixed << std::setprecision(2) << by_strings / 1e6 << '\t'
+                  << by_keys / 1e6 << std::endl;
+    }
+}
+
+} // namespace tools
+} // namespace miopen
+
+int main(int argc, char* argv[])
+{
+    miopen::tools::Options options;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "--threads" && i + 1 < argc)
+            options.max_threads = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else if(arg == "--keys" && i + 1 < argc)
+            options.keys = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else if(arg == "--lookups" && i + 1 < argc)
+            options.lookups = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--threads <max threads>] [--keys <n>] [--lookups <n per thread>]\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+    miopen::tools::Run(options);
+}
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Measures how many API calls per second can be made while every call is logged
+/// (MIOPEN_ENABLE_LOGGING), once with records written on the calling thread and once with
+/// the asynchronous sink. The log goes to the given file, /dev/null by default, so that the
+/// terminal does not limit the rate. Records dropped by the asynchronous sink because its
+/// queue was full are reported as well, MIOPEN_LOG_ASYNC_RECORDS sets the queue size.
+
+#include <miopen/logger.hpp>
+#include <miopen/miopen.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tools {
+
+struct Options
+{
+    std::size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+    std::size_t calls       = 100000; // per thread
+    std::string output      = "/dev/null";
+};
+
+double MeasureCallsPerSecond(const Options& options, std::size_t n_threads)
+{
+    std::vector<std::thread> threads;
+    const auto start = std::chrono::steady_clock::now();
+    for(std::size_t t = 0; t < n_threads; ++t)
+    {
+        threads.emplace_back([&] {
+            miopenTensorDescriptor_t desc = nullptr;
+            miopenCreateTensorDescriptor(&desc);
+            for(std::size_t i = 0; i < options.calls; ++i)
+                miopenSet4dTensorDescriptor(desc, miopenFloat, 32, 64, 56, 56);
+            miopenDestroyTensorDescriptor(desc);
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return n_threads * options.calls / elapsed.count();
+}
+
+void Run(const Options& options)
+{
+    std::vector<std::size_t> thread_counts;
+    for(std::size_t n = 1; n < options.max_threads; n *= 2)
+        thread_counts.push_back(n);
+    thread_counts.push_back(options.max_threads);
+
+    std::cout << "threads\tsync_kcalls_per_s\tasync_kcalls_per_s\tasync_dropped" << std::endl;
+    for(const auto n : thread_counts)
+    {
+        SetLoggingAsync(false);
+        const auto sync = MeasureCallsPerSecond(options, n);
+
+        SetLoggingAsync(true);
+        const auto dropped = LoggingDroppedRecords();
+        const auto async   = MeasureCallsPerSecond(options, n);
+        LoggingFlush();
+
+        std::cout << n << '\t' << std::fixed << std::setprecision(1) << sync / 1e3 << '\t'
+                  << async / 1e3 << '\t' << LoggingDroppedRecords() - dropped << std::endl;
+    }
+    SetLoggingAsync(false);
+}
+
+} // namespace tools
+} // namespace miopen
+
+int main(int argc, char* argv[])
+{
+    miopen::tools::Options options;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "--threads" && i + 1 < argc)
+            options.max_threads = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else if(arg == "--calls" && i + 1 < argc)
+            options.calls = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else if(arg == "--output" && i + 1 < argc)
+            options.output = argv[++i];
+        else
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--threads <max threads>] [--calls <n per thread>] [--output <log>]\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+
+    // Read once, by the first logged call.
+    setenv("MIOPEN_ENABLE_LOGGING", "1", 1); // NOLINT
+    if(std::freopen(options.output.c_str(), "w", stderr) == nullptr)
+    {
+        std::cout << "Cannot write the log to " << options.output << std::endl;
+        return 1;
+    }
+    miopen::tools::Run(options);
+}
@@ -0,0 +1,269 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Compiles the kernels required by a workload into the binary kernel cache ahead of time,
+/// so the first run of the workload on a new machine does not stall on compilation.
+///
+/// The workload is described by the files given on the command line (or stdin), which
+/// may contain both:
+/// - MIOpenDriver command lines, e.g. the output of an application run with
+///   MIOPEN_ENABLE_LOGGING_CMD=1. All applicable solutions are compiled, i.e. the set of
+///   kernels which Find would build;
+/// - find-db records. Only the solutions recorded in the find-db are compiled.
+///
+/// Solutions are resolved the same way Find does it without auto-tuning, so tuned
+/// configs are taken from the perf-db. Nothing is run on the GPU. GEMM and FFT based
+/// algorithms are not covered, as these do not provide their kernels via ConvSolution.
+
+#include "conv_problem_parser.hpp"
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/mlo_internal.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tools {
+
+class Precompiler
+{
+    public:
+    /// Collects the kernels of the solutions for the problem. If solver_ids is
+    /// not empty, then only solutions produced by these solvers are taken.
+    void Add(const ConvProblemConfig& config, const std::set<std::string>& solver_ids)
+    {
+        for(const auto direction : {ConvProblemConfig::Forward,
+                                    ConvProblemConfig::BackwardData,
+                                    ConvProblemConfig::BackwardWrW})
+        {
+            if((config.directions & direction) == 0)
+                continue;
+            try
+            {
+                const auto ctx = config.MakeContext(handle, direction);
+                for(const auto& solution : GetAllSolutions(ctx, direction))
+                {
+                    if(!solver_ids.empty() && solver_ids.count(solution.solver_id) == 0)
+                        continue;
+                    for(const auto& k : solution.construction_params)
+                        if(programs.insert(k.kernel_file + '\n' + k.comp_options).second)
+                            kernels.push_back(k);
+                }
+            }
+            catch(const Exception& ex)
+            {
+                std::cerr << ConvProblemConfig::ToString(direction) << ' ' << config.command
+                          << ": " << ex.what() << std::endl;
+            }
+        }
+    }
+
+    void List() const
+    {
+        for(const auto& k : kernels)
+            std::cout << k.kernel_file << '\t' << k.comp_options << std::endl;
+    }
+
+    /// Builds the collected programs on a pool of jobs threads and returns the number
+    /// of failures. Each thread uses its own Handle, as handles are not thread safe.
+    std::size_t Compile(unsigned jobs)
+    {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> n_failed{0};
+        std::mutex output_mutex;
+        const auto start = std::chrono::steady_clock::now();
+
+        const auto worker = [&]() {
+            Handle worker_handle;
+            for(auto i = next++; i < kernels.size(); i = next++)
+            {
+                const auto& k = kernels[i];
+                bool failed   = false;
+                try
+                {
+                    worker_handle.AddKernel(
+                        "", "", k.kernel_file, k.kernel_name, k.l_wk, k.g_wk, k.comp_options);
+                }
+                catch(const Exception& ex)
+                {
+                    failed = true;
+                    ++n_failed;
+                    const std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cerr << k.kernel_file << ' ' << k.comp_options << ": " << ex.what()
+                              << std::endl;
+                }
+                const std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << '[' << (i + 1) << '/' << kernels.size() << "] "
+                          << (failed ? "FAILED " : "") << k.kernel_file << std::endl;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for(unsigned i = 1; i < jobs; ++i)
+            threads.emplace_back(worker);
+        worker();
+        for(auto& thread : threads)
+            thread.join();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        const auto stats                            = GetBinaryCacheStats();
+        std::cout << "Programs: " << kernels.size() << ", failed: " << n_failed
+                  << ", already cached: " << stats.hits << ", elapsed: " << elapsed.count()
+                  << " s, compilation: " << stats.compile_seconds << " s" << std::endl;
+        return n_failed;
+    }
+
+    private:
+    Handle handle;
+    std::set<std::string> programs;
+    std::vector<solver::KernelInfo> kernels;
+};
+
+/// Parses a line of a find-db file: "<problem key>=<algorithm>:<solver id>,<...>;..."
+static bool ParseFindDbLine(const std::string& line,
+                            ConvProblemConfig& config,
+                            std::set<std::string>& solver_ids)
+{
+    const auto eq = line.find('=');
+    if(eq == std::string::npos || !config.ParseDbKey(line.substr(0, eq)))
+        return false;
+
+    std::istringstream ss(line.substr(eq + 1));
+    std::string item;
+    while(std::getline(ss, item, ';'))
+    {
+        const auto colon = item.find(':');
+        if(colon == std::string::npos)
+            continue;
+        solver_ids.insert(item.substr(colon + 1, item.find(',', colon) - colon - 1));
+    }
+    return !solver_ids.empty();
+}
+
+} // namespace tools
+} // namespace miopen
+
+static void Usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options] [file...]\n"
+              << "Compiles kernels required by MIOpenDriver convolution command lines\n"
+              << "and/or find-db records read from files or stdin into the kernel cache.\n"
+              << "  -j, --jobs <n>  number of parallel compilations (default: number of CPUs)\n"
+              << "  --dry-run       list programs to compile without compiling\n";
+}
+
+static void Process(std::istream& input, miopen::tools::Precompiler& precompiler)
+{
+    std::string line;
+    while(std::getline(input, line))
+    {
+        miopen::tools::ConvProblemConfig config;
+        std::set<std::string> solver_ids;
+        if(!miopen::tools::ParseFindDbLine(line, config, solver_ids) && !config.Parse(line))
+            continue;
+        if(!config.IsSupported())
+        {
+            std::cerr << "Skipped (only 2D non-transposed convolutions are supported): "
+                      << config.command << std::endl;
+            continue;
+        }
+        precompiler.Add(config, solver_ids);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    bool dry_run  = false;
+    std::vector<std::string> files;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if((arg == "-j" || arg == "--jobs") && i + 1 < argc)
+            jobs = std::max(1, std::atoi(argv[++i]));
+        else if(arg == "--dry-run")
+            dry_run = true;
+        else if(arg == "-h" || arg == "--help")
+        {
+            Usage(argv[0]);
+            return 0;
+        }
+        else if(!arg.empty() && arg[0] == '-' && arg != "-")
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+        else
+            files.push_back(arg);
+    }
+
+    if(miopen::IsCacheDisabled())
+        std::cerr << "Warning: the kernel cache is disabled, nothing will be stored."
+                  << std::endl;
+
+    miopen::tools::Precompiler precompiler;
+
+    if(files.empty())
+        files.push_back("-");
+
+    for(const auto& file : files)
+    {
+        if(file == "-")
+        {
+            Process(std::cin, precompiler);
+            continue;
+        }
+        std::ifstream input(file);
+        if(!input)
+        {
+            std::cerr << "Unable to open " << file << std::endl;
+            return 1;
+        }
+        Process(input, precompiler);
+    }
+
+    if(dry_run)
+    {
+        precompiler.List();
+        return 0;
+    }
+    return precompiler.Compile(jobs) == 0 ? 0 : 1;
+}
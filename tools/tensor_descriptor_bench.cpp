@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Measures the host cost of the TensorDescriptor operations which sit on every dispatch path:
+/// creation, copy, comparison, hashing and GetIndex, as well as the host side of OpTensor.
+/// OpTensor is best measured on the Mock backend (-DMIOPEN_BACKEND=Mock), where kernels are
+/// recorded instead of launched.
+
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tools {
+
+struct Options
+{
+    std::size_t iterations = 1000000;
+    std::size_t dispatches = 10000;
+};
+
+// Keeps the compiler from dropping the measured work.
+std::size_t sink = 0;
+
+template <class F>
+void Measure(const std::string& name, std::size_t iterations, F f)
+{
+    for(std::size_t i = 0; i < std::min<std::size_t>(iterations, 100); ++i)
+        f(i);
+
+    using clock      = std::chrono::steady_clock;
+    const auto start = clock::now();
+    for(std::size_t i = 0; i < iterations; ++i)
+        f(i);
+    const auto ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+    std::cout << std::left << std::setw(32) << name << "ns/op: " << ns / iterations << std::endl;
+}
+
+void Run(const Options& options)
+{
+    const int lens[]    = {16, 64, 56, 56};
+    const int strides[] = {64 * 56 * 56, 56 * 56, 56, 1};
+    const auto a        = TensorDescriptor{miopenFloat, {16, 64, 56, 56}};
+    const auto b        = TensorDescriptor{miopenFloat, {1, 64, 1, 1}};
+    auto c              = a;
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    Measure("create from lengths", options.iterations, [&](std::size_t) {
+        const auto desc = TensorDescriptor{miopenFloat, lens, 4};
+        sink += desc.GetElementSize();
+    });
+    Measure("create from lengths and strides", options.iterations, [&](std::size_t) {
+        const auto desc = TensorDescriptor{miopenFloat, lens, strides, 4};
+        sink += desc.GetElementSize();
+    });
+    Measure("copy", options.iterations, [&](std::size_t i) {
+        c = (i % 2 == 0) ? a : b;
+        sink += c.GetSize();
+    });
+    Measure("compare equal", options.iterations, [&](std::size_t) {
+        c = a;
+        sink += static_cast<std::size_t>(a == c);
+    });
+    Measure("compare different", options.iterations, [&](std::size_t) {
+        sink += static_cast<std::size_t>(a == b);
+    });
+    Measure("hash", options.iterations, [&](std::size_t) { sink += a.GetHash(); });
+    Measure("GetIndex", options.iterations, [&](std::size_t i) {
+        sink += a.GetIndex(i % 16, i % 64, i % 56, i % 56);
+    });
+
+    Handle handle;
+    const auto a_data  = handle.Create(a.GetNumBytes());
+    const auto b_data  = handle.Create(b.GetNumBytes());
+    const auto c_data  = handle.Create(a.GetNumBytes());
+    const float alpha0 = 1.0f;
+    const float alpha1 = 1.0f;
+    const float beta   = 0.0f;
+
+    Measure("OpTensor add (bias)", options.dispatches, [&](std::size_t) {
+        OpTensor(handle,
+                 miopenTensorOpAdd,
+                 &alpha0,
+                 a,
+                 a_data.get(),
+                 &alpha1,
+                 b,
+                 b_data.get(),
+                 &beta,
+                 a,
+                 c_data.get());
+    });
+    handle.Finish();
+
+    if(sink == 0)
+        std::cout << std::endl;
+}
+
+} // namespace tools
+} // namespace miopen
+
+int main(int argc, char* argv[])
+{
+    miopen::tools::Options options;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "--iterations" && i + 1 < argc)
+            options.iterations = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else if(arg == "--dispatches" && i + 1 < argc)
+            options.dispatches = std::max(1L, std::strtol(argv[++i], nullptr, 10));
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--iterations <n>] [--dispatches <n>]\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+    miopen::tools::Run(options);
+}
@@ -0,0 +1,297 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+/// Reports the size of the tuning space of every searchable solver for a list of
+/// convolution problem configs and the time it takes to enumerate it.
+/// No kernels are compiled or run, so this can be used to plan tuning budgets
+/// and to catch regressions in the cost of IsValid()/SetNextValue().
+///
+/// Input is a list of MIOpenDriver command lines (e.g. the output of an application
+/// run with MIOPEN_ENABLE_LOGGING_CMD=1), one per line, read from the files given on
+/// the command line or from stdin. Lines without a convolution command are ignored.
+
+#include "conv_problem_parser.hpp"
+
+#include <miopen/each_args.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/rank.hpp>
+#include <miopen/solver.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace tools {
+
+struct SpaceReport
+{
+    std::size_t main_size  = 0;
+    std::size_t spare_size = 0;
+    float enumeration_ms   = 0.0f;
+
+    /// GenericSearch falls back to the spare set only if the main one is empty.
+    std::size_t SearchedSize() const { return main_size != 0 ? main_size : spare_size; }
+};
+
+template <class Solver, class Context>
+auto Enumerate(rank<1>, Solver s, const Context& ctx, SpaceReport& report)
+    -> decltype(s.GetSolution(ctx, s.Search(ctx)),
+                std::declval<decltype(s.GetPerformanceConfig(ctx))&>().SetNextValue(),
+                true)
+{
+    using PerformanceConfig = decltype(s.GetPerformanceConfig(ctx));
+
+    solver::Timer timer;
+    timer.start();
+    const solver::ComputedContainer<PerformanceConfig, Context> main(ctx);
+    report.main_size = std::distance(main.begin(), main.end());
+    const solver::ComputedContainer<PerformanceConfig, Context> spare(ctx, true);
+    report.spare_size     = std::distance(spare.begin(), spare.end());
+    report.enumeration_ms = timer.elapsed_ms();
+    return true;
+}
+
+template <class Solver, class Context>
+bool Enumerate(rank<0>, Solver, const Context&, SpaceReport&)
+{
+    return false; // Not searchable or not enumerable via ComputedContainer.
+}
+
+struct Options
+{
+    float compile_ms         = 1000.0f;
+    float run_ms             = 10.0f;
+    bool show_not_searchable = false;
+};
+
+class TuningSpaceReporter
+{
+    public:
+    TuningSpaceReporter(const Options& options_) : options(options_) {}
+
+    void Run(const ConvProblemConfig& config)
+    {
+        for(const auto direction : {ConvProblemConfig::Forward,
+                                    ConvProblemConfig::BackwardData,
+                                    ConvProblemConfig::BackwardWrW})
+        {
+            if((config.directions & direction) == 0)
+                continue;
+
+            const auto ctx = config.MakeContext(handle, direction);
+            each_args([&](auto solver) { this->Run(config, direction, ctx, solver); },
+                      // clang-format off
+                      solver::ConvAsm3x3U{},
+                      solver::ConvAsm1x1U{},
+                      solver::ConvAsm1x1UV2{},
+                      solver::ConvAsm5x10u2v2f1{},
+                      solver::ConvAsm5x10u2v2b1{},
+                      solver::ConvAsm7x7c3h224w224k64u2v2p3q3f1{},
+                      solver::ConvOclDirectFwd11x11{},
+                      solver::ConvOclDirectFwdGen{},
+                      solver::ConvOclDirectFwd3x3{},
+                      solver::ConvOclDirectFwd1x1{},
+                      solver::ConvOclDirectFwd{},
+                      solver::ConvHipImplicitGemmV4R4Xdlops_1x1{},
+                      solver::ConvHipImplicitGemmV4R4FwdXdlops{},
+                      solver::ConvHipImplicitGemmV4_1x1{},
+                      solver::ConvHipImplicitGemmV4Fwd{},
+                      solver::ConvHipImplicitGemmV4R1Fwd{},
+                      solver::ConvHipImplicitGemmV4R4WrWXdlops{},
+                      solver::ConvHipImplicitGemmV4WrW{},
+                      solver::ConvHipImplicitGemmV4R1WrW{},
+                      solver::ConvBinWinograd3x3U{},
+                      solver::ConvBinWinogradRxSf3x2{},
+                      solver::ConvBinWinogradRxS{},
+                      solver::ConvAsmBwdWrW1x1{},
+                      solver::ConvAsmBwdWrW3x3{},
+                      solver::ConvOclBwdWrW2<1>{},
+                      solver::ConvOclBwdWrW2<2>{},
+                      solver::ConvOclBwdWrW2<4>{},
+                      solver::ConvOclBwdWrW2<8>{},
+                      solver::ConvOclBwdWrW2<16>{},
+                      solver::ConvOclBwdWrW2NonTunable{},
+                      solver::ConvOclBwdWrW53{},
+                      solver::ConvOclBwdWrW1x1{}
+#if MIOPEN_USE_SCGEMM
+                      , solver::ConvSCGemmFGemm{}
+#endif
+                      // clang-format on
+                      );
+        }
+    }
+
+    void PrintHeader() const
+    {
+        std::cout << "direction\tsolver\tmain\tspare\tenumeration_ms\testimated_tuning_s\tproblem"
+                  << std::endl;
+    }
+
+    void PrintTotal() const
+    {
+        std::cout << "Total: " << n_rows << " solver/direction row(s), " << n_searched
+                  << " config(s) to search, enumerated in " << total_enumeration_ms
+                  << " ms, estimated tuning time " << EstimateSeconds(n_searched) << " s"
+                  << std::endl;
+    }
+
+    private:
+    template <class Solver>
+    void Run(const ConvProblemConfig& config,
+             ConvProblemConfig::Direction direction,
+             const ConvolutionContext& ctx,
+             Solver s)
+    {
+        SpaceReport report;
+        bool searchable = false;
+        try
+        {
+            if(!s.IsApplicable(ctx))
+                return;
+            searchable = Enumerate(rank<1>{}, s, ctx, report);
+        }
+        catch(const Exception& ex)
+        {
+            std::cerr << solver::SolverDbId(s) << ": " << ex.what() << std::endl;
+            return;
+        }
+        if(!searchable && !options.show_not_searchable)
+            return;
+
+        ++n_rows;
+        n_searched += report.SearchedSize();
+        total_enumeration_ms += report.enumeration_ms;
+
+        std::cout << ConvProblemConfig::ToString(direction) << '\t' << solver::SolverDbId(s)
+                  << '\t';
+        if(searchable)
+            std::cout << report.main_size << '\t' << report.spare_size << '\t'
+                      << report.enumeration_ms << '\t' << EstimateSeconds(report.SearchedSize());
+        else
+            std::cout << "-\t-\t-\t-";
+        std::cout << '\t' << config.command << std::endl;
+    }
+
+    float EstimateSeconds(std::size_t n_configs) const
+    {
+        return n_configs * (options.compile_ms + options.run_ms) / 1000.0f;
+    }
+
+    Options options;
+    Handle handle;
+    std::size_t n_rows         = 0;
+    std::size_t n_searched     = 0;
+    float total_enumeration_ms = 0.0f;
+};
+
+} // namespace tools
+} // namespace miopen
+
+static void Usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options] [file...]\n"
+              << "Reads MIOpenDriver convolution command lines from files or stdin.\n"
+              << "  --compile-ms <ms>  estimated compilation time of one config (default 1000)\n"
+              << "  --run-ms <ms>      estimated measurement time of one config (default 10)\n"
+              << "  --all              also list applicable solvers which are not searchable\n";
+}
+
+static void Process(std::istream& input, miopen::tools::TuningSpaceReporter& reporter)
+{
+    std::string line;
+    while(std::getline(input, line))
+    {
+        miopen::tools::ConvProblemConfig config;
+        if(!config.Parse(line))
+            continue;
+        if(!config.IsSupported())
+        {
+            std::cerr << "Skipped (only 2D non-transposed convolutions are supported): "
+                      << config.command << std::endl;
+            continue;
+        }
+        reporter.Run(config);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    miopen::tools::Options options;
+    std::vector<std::string> files;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "--compile-ms" && i + 1 < argc)
+            options.compile_ms = std::strtof(argv[++i], nullptr);
+        else if(arg == "--run-ms" && i + 1 < argc)
+            options.run_ms = std::strtof(argv[++i], nullptr);
+        else if(arg == "--all")
+            options.show_not_searchable = true;
+        else if(arg == "-h" || arg == "--help")
+        {
+            Usage(argv[0]);
+            return 0;
+        }
+        else if(!arg.empty() && arg[0] == '-' && arg != "-")
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+        else
+            files.push_back(arg);
+    }
+
+    miopen::tools::TuningSpaceReporter reporter(options);
+    reporter.PrintHeader();
+
+    if(files.empty())
+        files.push_back("-");
+
+    for(const auto& file : files)
+    {
+        if(file == "-")
+        {
+            Process(std::cin, reporter);
+            continue;
+        }
+        std::ifstream input(file);
+        if(!input)
+        {
+            std::cerr << "Unable to open " << file << std::endl;
+            return 1;
+        }
+        Process(input, reporter);
+    }
+
+    reporter.PrintTotal();
+    return 0;
+}